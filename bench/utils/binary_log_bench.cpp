@@ -0,0 +1,79 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+
+// project
+#include "ltb/utils/binary_log.hpp"
+
+// external
+#include <benchmark/benchmark.h>
+
+// standard
+#include <string>
+
+namespace
+{
+
+constexpr auto format = "Loaded '{}' ({} bytes) in {}ms: {}";
+
+// Longer than a whole payload, so the arguments after it are dropped.
+auto const long_path = std::string( ltb::utils::binary_log_max_payload_bytes * 2UZ, 'x' );
+
+auto bm_binary_log_payload( benchmark::State& state ) -> void
+{
+    for ( auto _ : state )
+    {
+        auto payload = ltb::utils::BinaryLogPayload{ };
+        payload.append( "assets/mesh.bin" );
+        payload.append( 4096U );
+        payload.append( 1.5 );
+        payload.append( true );
+        benchmark::DoNotOptimize( payload.bytes( ) );
+    }
+}
+BENCHMARK( bm_binary_log_payload );
+
+// Arguments that don't fit must never expose bytes past the last one that did.
+auto bm_binary_log_payload_overflow( benchmark::State& state ) -> void
+{
+    for ( auto _ : state )
+    {
+        auto payload = ltb::utils::BinaryLogPayload{ };
+        payload.append( long_path );
+        payload.append( 4096U );
+        payload.append( 1.5 );
+        payload.append( true );
+
+        auto const bytes = payload.bytes( );
+        if ( !payload.truncated( ) || ( bytes.size( ) > ltb::utils::binary_log_max_payload_bytes )
+             || ( ltb::utils::BinaryLogArgument::Truncated
+                  != static_cast< ltb::utils::BinaryLogArgument >( bytes.back( ) ) ) )
+        {
+            state.SkipWithError( "Overflowing payload was not marked as truncated" );
+            break;
+        }
+        benchmark::DoNotOptimize( bytes );
+    }
+}
+BENCHMARK( bm_binary_log_payload_overflow );
+
+auto bm_binary_log_format_overflow( benchmark::State& state ) -> void
+{
+    auto payload = ltb::utils::BinaryLogPayload{ };
+    payload.append( long_path );
+    payload.append( 4096U );
+
+    for ( auto _ : state )
+    {
+        auto text = ltb::utils::format_binary_log_payload( format, payload.bytes( ) );
+        if ( !text.ends_with( "arguments truncated>" ) )
+        {
+            state.SkipWithError( "Formatted payload was not marked as truncated" );
+            break;
+        }
+        benchmark::DoNotOptimize( text );
+    }
+}
+BENCHMARK( bm_binary_log_format_overflow );
+
+} // namespace
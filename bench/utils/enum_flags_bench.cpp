@@ -0,0 +1,62 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+
+// project
+#include "ltb/utils/enum_flags.hpp"
+
+// external
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+enum class BenchFlag : uint32_t
+{
+    A,
+    B,
+    C,
+    D,
+};
+
+auto bm_flags_combine( benchmark::State& state ) -> void
+{
+    using namespace ltb::utils::flag_operators;
+
+    auto flags = ltb::utils::Flags< BenchFlag >{ };
+    for ( auto _ : state )
+    {
+        flags = BenchFlag::A | BenchFlag::C;
+        flags |= BenchFlag::D;
+        flags &= ~BenchFlag::A;
+        flags ^= BenchFlag::B;
+        benchmark::DoNotOptimize( flags );
+    }
+}
+BENCHMARK( bm_flags_combine );
+
+auto bm_flags_has_flag( benchmark::State& state ) -> void
+{
+    auto flags = ltb::utils::make_flags( BenchFlag::A, BenchFlag::C );
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( flags );
+        benchmark::DoNotOptimize( ltb::utils::has_flag( flags, BenchFlag::C ) );
+    }
+}
+BENCHMARK( bm_flags_has_flag );
+
+auto bm_flags_add_remove_toggle( benchmark::State& state ) -> void
+{
+    auto flags = ltb::utils::Flags< BenchFlag >{ };
+    for ( auto _ : state )
+    {
+        flags = ltb::utils::add_flag( flags, BenchFlag::B );
+        flags = ltb::utils::toggle_flag( flags, BenchFlag::D );
+        flags = ltb::utils::remove_flag( flags, BenchFlag::B );
+        benchmark::DoNotOptimize( flags );
+    }
+}
+BENCHMARK( bm_flags_add_remove_toggle );
+
+} // namespace
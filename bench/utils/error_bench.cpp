@@ -0,0 +1,75 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+
+// project
+#include "ltb/utils/result.hpp"
+
+// external
+#include <benchmark/benchmark.h>
+
+// standard
+#include <string>
+
+namespace
+{
+
+[[gnu::noinline]] auto make_short_error( int const value ) -> ltb::utils::Error
+{
+    return LTB_MAKE_ERROR( "Cache miss for key {}", value );
+}
+
+[[gnu::noinline]] auto make_long_error( int const value ) -> ltb::utils::Error
+{
+    return LTB_MAKE_ERROR(
+        "Optional feature {} is unavailable on this adapter, falling back to the portable path",
+        value
+    );
+}
+
+auto bm_error_create_short( benchmark::State& state ) -> void
+{
+    auto value = 42;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( value );
+        benchmark::DoNotOptimize( make_short_error( value ) );
+    }
+}
+BENCHMARK( bm_error_create_short );
+
+// Messages past `Error::inline_message_capacity` are formatted twice and allocate.
+auto bm_error_create_long( benchmark::State& state ) -> void
+{
+    auto value = 42;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( value );
+        benchmark::DoNotOptimize( make_long_error( value ) );
+    }
+}
+BENCHMARK( bm_error_create_long );
+
+auto bm_error_copy( benchmark::State& state ) -> void
+{
+    auto const error = make_short_error( 42 );
+    for ( auto _ : state )
+    {
+        auto copy = error;
+        benchmark::DoNotOptimize( copy );
+    }
+}
+BENCHMARK( bm_error_copy );
+
+// The cost paid only when an error is actually logged or thrown.
+auto bm_error_debug_message( benchmark::State& state ) -> void
+{
+    auto const error = make_short_error( 42 );
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( error.debug_error_message( ) );
+    }
+}
+BENCHMARK( bm_error_debug_message );
+
+} // namespace
@@ -0,0 +1,79 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+
+// project
+#include "ltb/utils/error_collector.hpp"
+#include "ltb/utils/result.hpp"
+
+// external
+#include <benchmark/benchmark.h>
+
+// standard
+#include <algorithm>
+#include <execution>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+constexpr auto task_count = 10'000;
+
+// Every other task fails, like validating a batch of mostly broken assets.
+[[gnu::noinline]] auto validate( int const task ) -> ltb::utils::Result< void >
+{
+    if ( 0 == ( task % 2 ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Asset {} is invalid", task );
+    }
+    return ltb::utils::success( );
+}
+
+auto make_tasks( ) -> std::vector< int >
+{
+    auto tasks = std::vector< int >( task_count );
+    std::iota( tasks.begin( ), tasks.end( ), 0 );
+    return tasks;
+}
+
+auto bm_errors_mutex_vector( benchmark::State& state ) -> void
+{
+    auto const tasks = make_tasks( );
+    for ( auto _ : state )
+    {
+        auto mutex  = std::mutex{ };
+        auto errors = std::vector< ltb::utils::Error >{ };
+
+        auto const on_error = ltb::utils::ErrorCallback( [ & ]( ltb::utils::Error error ) {
+            auto const lock = std::scoped_lock( mutex );
+            errors.emplace_back( std::move( error ) );
+        } );
+        std::for_each( std::execution::par, tasks.begin( ), tasks.end( ), [ & ]( int const task ) {
+            LTB_CHECK_OR( validate( task ), on_error );
+        } );
+        benchmark::DoNotOptimize( errors );
+    }
+    state.SetItemsProcessed( state.iterations( ) * task_count );
+}
+BENCHMARK( bm_errors_mutex_vector )->UseRealTime( );
+
+auto bm_errors_collector( benchmark::State& state ) -> void
+{
+    auto const tasks = make_tasks( );
+    for ( auto _ : state )
+    {
+        auto collector = ltb::utils::ErrorCollector{ { .max_errors_per_thread = task_count } };
+
+        auto const on_error = collector.callback( );
+        std::for_each( std::execution::par, tasks.begin( ), tasks.end( ), [ & ]( int const task ) {
+            LTB_CHECK_OR( validate( task ), on_error );
+        } );
+        benchmark::DoNotOptimize( collector.errors( ) );
+    }
+    state.SetItemsProcessed( state.iterations( ) * task_count );
+}
+BENCHMARK( bm_errors_collector )->UseRealTime( );
+
+} // namespace
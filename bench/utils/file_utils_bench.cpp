@@ -0,0 +1,286 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+
+// project
+#include "ltb/utils/batch_file_loader.hpp"
+#include "ltb/utils/chunked_file_reader.hpp"
+#include "ltb/utils/file_utils.hpp"
+#include "ltb/utils/json_settings.hpp"
+#include "ltb/utils/mapped_file.hpp"
+
+// external
+#include <benchmark/benchmark.h>
+
+// standard
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct BenchSettings
+{
+    std::string           name    = "bench";
+    int                   count   = 42;
+    float                 scale   = 1.5F;
+    std::vector< double > weights = std::vector< double >( 64UZ, 0.5 );
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE( BenchSettings, name, count, scale, weights )
+
+auto bench_file( std::string const& name ) -> std::filesystem::path
+{
+    return std::filesystem::temp_directory_path( ) / ( "ltb_bench_" + name );
+}
+
+auto bm_get_binary_file_contents( benchmark::State& state ) -> void
+{
+    auto const size = static_cast< std::size_t >( state.range( 0 ) );
+    auto const path = bench_file( "binary_" + std::to_string( size ) );
+    {
+        auto file = std::ofstream( path, std::ios::binary | std::ios::trunc );
+        file << std::string( size, 'x' );
+    }
+
+    for ( auto _ : state )
+    {
+        auto contents = ltb::utils::get_binary_file_contents< char >( path );
+        if ( !contents )
+        {
+            state.SkipWithError( std::string( contents.error( ).error_message( ) ) );
+            break;
+        }
+        benchmark::DoNotOptimize( contents );
+    }
+    state.SetBytesProcessed( state.iterations( ) * state.range( 0 ) );
+
+    std::filesystem::remove( path );
+}
+BENCHMARK( bm_get_binary_file_contents )->Arg( 1 << 10 )->Arg( 1 << 16 )->Arg( 1 << 22 );
+
+// Maps the file and reads one byte per page, so every page is faulted in like a consumer would.
+auto bm_map_file( benchmark::State& state ) -> void
+{
+    constexpr auto page_size = 4096UZ;
+
+    auto const size = static_cast< std::size_t >( state.range( 0 ) );
+    auto const path = bench_file( "mapped_" + std::to_string( size ) );
+    {
+        auto file = std::ofstream( path, std::ios::binary | std::ios::trunc );
+        file << std::string( size, 'x' );
+    }
+
+    for ( auto _ : state )
+    {
+        auto mapping = ltb::utils::map_file( path );
+        if ( !mapping )
+        {
+            state.SkipWithError( std::string( mapping.error( ).error_message( ) ) );
+            break;
+        }
+
+        auto const bytes = mapping->bytes( );
+        auto       sum   = std::byte{ 0 };
+        for ( auto i = 0UZ; i < bytes.size( ); i += page_size )
+        {
+            sum ^= bytes[ i ];
+        }
+        benchmark::DoNotOptimize( sum );
+    }
+    state.SetBytesProcessed( state.iterations( ) * state.range( 0 ) );
+
+    std::filesystem::remove( path );
+}
+BENCHMARK( bm_map_file )->Arg( 1 << 10 )->Arg( 1 << 16 )->Arg( 1 << 22 )->Arg( 1 << 28 );
+
+// Many small files, like the shaders and textures of a scene.
+constexpr auto batch_file_count = 256UZ;
+constexpr auto batch_file_size  = 64UZ << 10U;
+
+auto make_batch_files( ) -> std::vector< std::filesystem::path >
+{
+    auto paths = std::vector< std::filesystem::path >{ };
+    for ( auto i = 0UZ; i < batch_file_count; ++i )
+    {
+        paths.emplace_back( bench_file( "batch_" + std::to_string( i ) ) );
+        auto file = std::ofstream( paths.back( ), std::ios::binary | std::ios::trunc );
+        file << std::string( batch_file_size, 'x' );
+    }
+    return paths;
+}
+
+// The one-at-a-time loop `get_binary_files_contents` used before `BatchFileLoader`.
+auto bm_load_files_sequentially( benchmark::State& state ) -> void
+{
+    auto const paths = make_batch_files( );
+
+    for ( auto _ : state )
+    {
+        for ( auto const& path : paths )
+        {
+            auto contents = ltb::utils::get_binary_file_contents< char >( path );
+            benchmark::DoNotOptimize( contents );
+        }
+    }
+    state.SetBytesProcessed(
+        static_cast< int64_t >( state.iterations( ) * batch_file_count * batch_file_size )
+    );
+
+    for ( auto const& path : paths )
+    {
+        std::filesystem::remove( path );
+    }
+}
+BENCHMARK( bm_load_files_sequentially );
+
+// Arg 0 uses io_uring where available, arg 1 forces the thread pool.
+auto bm_batch_file_loader( benchmark::State& state ) -> void
+{
+    auto const paths             = make_batch_files( );
+    auto const force_thread_pool = ( 1 == state.range( 0 ) );
+    auto       loader  = ltb::utils::BatchFileLoader( { .force_thread_pool = force_thread_pool } );
+    auto       buffers = std::vector< std::vector< std::byte > >( batch_file_count );
+
+    state.SetLabel(
+        ( ltb::utils::FileLoaderBackend::IoUring == loader.backend( ) ) ? "io_uring" : "thread pool"
+    );
+
+    for ( auto _ : state )
+    {
+        loader.load(
+            paths,
+            {
+                .allocate =
+                    [ &buffers ]( std::size_t const index, ltb::uint64 const size ) {
+                        buffers[ index ].resize( size );
+                        return std::span( buffers[ index ] );
+                    },
+                .loaded =
+                    [ &state ]( std::size_t, ltb::utils::Result< void > const& result ) {
+                        if ( !result )
+                        {
+                            state.SkipWithError( std::string( result.error( ).error_message( ) ) );
+                        }
+                    },
+            }
+        );
+        benchmark::DoNotOptimize( buffers );
+    }
+    state.SetBytesProcessed(
+        static_cast< int64_t >( state.iterations( ) * batch_file_count * batch_file_size )
+    );
+
+    for ( auto const& path : paths )
+    {
+        std::filesystem::remove( path );
+    }
+}
+BENCHMARK( bm_batch_file_loader )->Arg( 0 )->Arg( 1 );
+
+// Sums a 64 MiB file chunk by chunk, so reading ahead overlaps the summing. Compare with
+// bm_get_binary_file_contents, which holds the whole file before any of it is used.
+auto bm_chunked_file_reader( benchmark::State& state ) -> void
+{
+    constexpr auto file_size = 64UZ << 20U;
+
+    auto const chunk_size = static_cast< std::size_t >( state.range( 0 ) );
+    auto const path       = bench_file( "chunked" );
+    {
+        auto file = std::ofstream( path, std::ios::binary | std::ios::trunc );
+        file << std::string( file_size, 'x' );
+    }
+
+    auto reader = ltb::utils::ChunkedFileReader( {
+        .chunk_size         = chunk_size,
+        .max_buffered_bytes = 4UZ * chunk_size,
+    } );
+
+    for ( auto _ : state )
+    {
+        if ( auto opened = reader.open( path ); !opened )
+        {
+            state.SkipWithError( std::string( opened.error( ).error_message( ) ) );
+            break;
+        }
+
+        auto sum = ltb::uint64{ 0U };
+        while ( true )
+        {
+            auto chunk = reader.next( );
+            if ( !chunk )
+            {
+                state.SkipWithError( std::string( chunk.error( ).error_message( ) ) );
+                break;
+            }
+            if ( !chunk.value( ) )
+            {
+                break;
+            }
+            auto const bytes = chunk.value( )->bytes( );
+            sum              = std::accumulate(
+                bytes.begin( ),
+                bytes.end( ),
+                sum,
+                []( ltb::uint64 const total, std::byte const byte ) {
+                    return total + std::to_integer< ltb::uint64 >( byte );
+                }
+            );
+        }
+        benchmark::DoNotOptimize( sum );
+    }
+    state.SetBytesProcessed( static_cast< int64_t >( state.iterations( ) * file_size ) );
+
+    reader.close( );
+    std::filesystem::remove( path );
+}
+BENCHMARK( bm_chunked_file_reader )->Arg( 1 << 16 )->Arg( 1 << 20 )->Arg( 1 << 22 );
+
+auto bm_json_settings_save( benchmark::State& state ) -> void
+{
+    auto const path     = bench_file( "settings_save.json" );
+    auto       settings = ltb::utils::JsonSettings< BenchSettings >(
+        path,
+        "bench",
+        ltb::utils::make_flags(
+            ltb::utils::JsonSettingsFlag::NoImplicitLoad,
+            ltb::utils::JsonSettingsFlag::NoImplicitSave
+        )
+    );
+
+    for ( auto _ : state )
+    {
+        settings.save_settings( );
+    }
+
+    std::filesystem::remove( path );
+}
+BENCHMARK( bm_json_settings_save );
+
+auto bm_json_settings_load( benchmark::State& state ) -> void
+{
+    auto const path     = bench_file( "settings_load.json" );
+    auto       settings = ltb::utils::JsonSettings< BenchSettings >(
+        path,
+        "bench",
+        ltb::utils::make_flags(
+            ltb::utils::JsonSettingsFlag::NoImplicitLoad,
+            ltb::utils::JsonSettingsFlag::NoImplicitSave
+        )
+    );
+    settings.save_settings( );
+
+    for ( auto _ : state )
+    {
+        settings.load_settings( );
+        benchmark::DoNotOptimize( settings.value );
+    }
+
+    std::filesystem::remove( path );
+}
+BENCHMARK( bm_json_settings_load );
+
+} // namespace
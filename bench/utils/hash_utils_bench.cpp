@@ -0,0 +1,53 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+
+// project
+#include "ltb/utils/hash_utils.hpp"
+
+// external
+#include <benchmark/benchmark.h>
+
+// standard
+#include <string>
+
+namespace
+{
+
+auto bm_hash_combine_int( benchmark::State& state ) -> void
+{
+    auto seed  = std::size_t{ 0UZ };
+    auto value = 0;
+    for ( auto _ : state )
+    {
+        seed = ltb::utils::hash_combine( seed, ++value );
+        benchmark::DoNotOptimize( seed );
+    }
+}
+BENCHMARK( bm_hash_combine_int );
+
+auto bm_hash_combine_string( benchmark::State& state ) -> void
+{
+    auto const value = std::string( static_cast< std::size_t >( state.range( 0 ) ), 'x' );
+    auto       seed  = std::size_t{ 0UZ };
+    for ( auto _ : state )
+    {
+        seed = ltb::utils::hash_combine( seed, value );
+        benchmark::DoNotOptimize( seed );
+    }
+    state.SetBytesProcessed( state.iterations( ) * state.range( 0 ) );
+}
+BENCHMARK( bm_hash_combine_string )->Arg( 8 )->Arg( 64 )->Arg( 1024 );
+
+auto bm_string_seed_to_uint( benchmark::State& state ) -> void
+{
+    auto const value = std::string( static_cast< std::size_t >( state.range( 0 ) ), 'x' );
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( ltb::utils::string_seed_to_uint( value ) );
+    }
+    state.SetBytesProcessed( state.iterations( ) * state.range( 0 ) );
+}
+BENCHMARK( bm_string_seed_to_uint )->Arg( 8 )->Arg( 64 )->Arg( 1024 );
+
+} // namespace
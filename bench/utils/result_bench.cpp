@@ -0,0 +1,139 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+
+// project
+#include "ltb/utils/result.hpp"
+
+// external
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+// Kept out of line so each level of propagation is a real call and return.
+[[gnu::noinline]] auto leaf( int const value ) -> ltb::utils::Result< int >
+{
+    if ( value < 0 )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Value {} is negative", value );
+    }
+    return value;
+}
+
+[[gnu::noinline]] auto middle( int const value ) -> ltb::utils::Result< int >
+{
+    LTB_CHECK( auto const result, leaf( value ) );
+    return result + 1;
+}
+
+[[gnu::noinline]] auto top( int const value ) -> ltb::utils::Result< int >
+{
+    LTB_CHECK( auto const result, middle( value ) );
+    return result + 1;
+}
+
+[[gnu::noinline]] auto top_void( int const value ) -> ltb::utils::Result< void >
+{
+    LTB_CHECK( top( value ) );
+    return ltb::utils::success( );
+}
+
+// A chain of `Depth` out-of-line calls, each propagating the one below with `LTB_CHECK`.
+template < int Depth >
+[[gnu::noinline]] auto chain( int const value ) -> ltb::utils::Result< int >
+{
+    if constexpr ( 0 == Depth )
+    {
+        return leaf( value );
+    }
+    else
+    {
+        LTB_CHECK( auto const result, chain< Depth - 1 >( value ) );
+        return result + 1;
+    }
+}
+
+template < int Depth >
+[[gnu::noinline]] auto chain_void( int const value ) -> ltb::utils::Result< void >
+{
+    if constexpr ( 0 == Depth )
+    {
+        LTB_CHECK( leaf( value ) );
+    }
+    else
+    {
+        LTB_CHECK( chain_void< Depth - 1 >( value ) );
+    }
+    return ltb::utils::success( );
+}
+
+constexpr auto chain_depth = 16;
+
+auto bm_result_success( benchmark::State& state ) -> void
+{
+    auto value = 1;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( value );
+        benchmark::DoNotOptimize( top( value ) );
+    }
+}
+BENCHMARK( bm_result_success );
+
+auto bm_result_error( benchmark::State& state ) -> void
+{
+    auto value = -1;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( value );
+        benchmark::DoNotOptimize( top( value ) );
+    }
+}
+BENCHMARK( bm_result_error );
+
+auto bm_result_to_void_success( benchmark::State& state ) -> void
+{
+    auto value = 1;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( value );
+        benchmark::DoNotOptimize( top_void( value ) );
+    }
+}
+BENCHMARK( bm_result_to_void_success );
+
+auto bm_result_to_void_error( benchmark::State& state ) -> void
+{
+    auto value = -1;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( value );
+        benchmark::DoNotOptimize( top_void( value ) );
+    }
+}
+BENCHMARK( bm_result_to_void_error );
+
+auto bm_result_chain( benchmark::State& state ) -> void
+{
+    auto value = static_cast< int >( state.range( 0 ) );
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( value );
+        benchmark::DoNotOptimize( chain< chain_depth >( value ) );
+    }
+}
+BENCHMARK( bm_result_chain )->Arg( 1 )->Arg( -1 );
+
+auto bm_result_void_chain( benchmark::State& state ) -> void
+{
+    auto value = static_cast< int >( state.range( 0 ) );
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( value );
+        benchmark::DoNotOptimize( chain_void< chain_depth >( value ) );
+    }
+}
+BENCHMARK( bm_result_void_chain )->Arg( 1 )->Arg( -1 );
+
+} // namespace
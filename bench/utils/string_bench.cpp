@@ -0,0 +1,51 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+
+// project
+#include "ltb/utils/string.hpp"
+#include "ltb/utils/type_string.hpp"
+
+// external
+#include <benchmark/benchmark.h>
+
+// standard
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+auto bm_to_lower_ascii( benchmark::State& state ) -> void
+{
+    auto const value = std::string( static_cast< std::size_t >( state.range( 0 ) ), 'X' );
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( ltb::utils::to_lower_ascii( value ) );
+    }
+    state.SetBytesProcessed( state.iterations( ) * state.range( 0 ) );
+}
+BENCHMARK( bm_to_lower_ascii )->Arg( 8 )->Arg( 64 )->Arg( 4096 );
+
+auto bm_type_string_simple( benchmark::State& state ) -> void
+{
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( ltb::utils::type_string< int >( ) );
+    }
+}
+BENCHMARK( bm_type_string_simple );
+
+auto bm_type_string_nested( benchmark::State& state ) -> void
+{
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(
+            ltb::utils::type_string< std::map< std::string, std::vector< std::string > > >( )
+        );
+    }
+}
+BENCHMARK( bm_type_string_nested );
+
+} // namespace
@@ -76,7 +76,22 @@ cpmaddpackage(
   TRUE
 )
 cpmaddpackage("gh:Neargye/magic_enum@0.7.3")
-cpmaddpackage("gh:gabime/spdlog@1.12.0")
+cpmaddpackage("gh:nlohmann/json@3.11.3")
+cpmaddpackage("gh:gabime/spdlog@1.13.0")
+if (LTB_BUILD_BENCHMARKS)
+  cpmaddpackage(
+    NAME
+    benchmark
+    GITHUB_REPOSITORY
+    google/benchmark
+    VERSION
+    1.8.3
+    OPTIONS
+    "BENCHMARK_ENABLE_TESTING OFF"
+    "BENCHMARK_ENABLE_GTEST_TESTS OFF"
+    "BENCHMARK_ENABLE_INSTALL OFF"
+  )
+endif ()
 cpmaddpackage(
   NAME
   range-v3
@@ -0,0 +1,146 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+
+// project
+#include "ltb/utils/timers.hpp"
+#include "ltb/wgpu/app.hpp"
+#include "ltb/wgpu/gpu_benchmarks.hpp"
+#include "ltb/wgpu/string_view.hpp"
+
+// external
+#include <cxxopts.hpp>
+#include <magic_enum.hpp>
+
+// standard
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+
+auto adapter_json( WGPUAdapter const adapter ) -> nlohmann::json
+{
+    auto info = WGPUAdapterInfo{ };
+    if ( WGPUStatus_Success != ::wgpuAdapterGetInfo( adapter, &info ) )
+    {
+        return { };
+    }
+
+    auto json = nlohmann::json{
+        { "vendor", ltb::wgpu::to_string_view( info.vendor ) },
+        { "architecture", ltb::wgpu::to_string_view( info.architecture ) },
+        { "device", ltb::wgpu::to_string_view( info.device ) },
+        { "description", ltb::wgpu::to_string_view( info.description ) },
+        { "backend", magic_enum::enum_name( info.backendType ) },
+        { "adapter_type", magic_enum::enum_name( info.adapterType ) },
+    };
+    ::wgpuAdapterInfoFreeMembers( info );
+    return json;
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+    auto options = cxxopts::Options( "gpubench-app", "Measures WebGPU transfer and overhead" );
+    // clang-format off
+    options.add_options( )
+        ( "fallback", "Benchmark the software adapter" )
+        ( "profile", "Profile name", cxxopts::value< std::string >( )->default_value( "Default" ) )
+        ( "iterations", "Runs per benchmark", cxxopts::value< uint32_t >( )->default_value( "20" ) )
+        ( "commands", "Draws per run", cxxopts::value< uint32_t >( )->default_value( "1000" ) )
+        ( "output", "JSON output file (stdout if unset)", cxxopts::value< std::string >( ) )
+        ( "trace", "Record WebGPU calls to this file", cxxopts::value< std::string >( ) )
+        ( "h,help", "Print usage" );
+    // clang-format on
+
+    auto const parsed = options.parse( argc, argv );
+    if ( parsed.count( "help" ) > 0U )
+    {
+        spdlog::info( "{}", options.help( ) );
+        return EXIT_SUCCESS;
+    }
+
+    auto const profile_name = parsed[ "profile" ].as< std::string >( );
+    auto const profile      = ltb::wgpu::to_performance_profile( profile_name );
+    if ( !profile )
+    {
+        spdlog::error( "{}", profile.error( ).error_message( ) );
+        return EXIT_FAILURE;
+    }
+
+    auto api_trace_file = std::filesystem::path{ };
+    if ( parsed.count( "trace" ) > 0U )
+    {
+        api_trace_file = parsed[ "trace" ].as< std::string >( );
+    }
+
+    auto app = ltb::wgpu::App{ {
+        .performance_profile    = *profile,
+        .force_fallback_adapter = ( parsed.count( "fallback" ) > 0U ),
+        .api_trace_file         = std::move( api_trace_file ),
+    } };
+    app.run( );
+
+    constexpr auto device_timeout = ltb::utils::duration_seconds( 10 );
+
+    auto timer = ltb::utils::Timer{ };
+    while ( app.instance( ) && !app.queue( ) && ( timer.duration_since_start( ) < device_timeout ) )
+    {
+        app.process( );
+    }
+    if ( !app.queue( ) )
+    {
+        spdlog::error( "Could not create a WebGPU device" );
+        return EXIT_FAILURE;
+    }
+
+    auto const settings = ltb::wgpu::GpuBenchmarkSettings{
+        .iterations             = parsed[ "iterations" ].as< uint32_t >( ),
+        .commands_per_iteration = parsed[ "commands" ].as< uint32_t >( ),
+    };
+    auto const results = ltb::wgpu::run_gpu_benchmarks(
+        {
+            .instance       = app.instance( ),
+            .device         = app.device( ),
+            .queue          = app.queue( ),
+            .api_trace      = &app.api_trace( ),
+            .memory_tracker = &app.memory_tracker( ),
+            .error_reporter = &app.error_reporter( ),
+        },
+        settings
+    );
+    app.error_reporter( ).summarize( );
+
+    if ( !results )
+    {
+        spdlog::error( "Benchmarks failed: {}", results.error( ).error_message( ) );
+        return EXIT_FAILURE;
+    }
+
+    auto const json = nlohmann::json{
+        { "adapter", adapter_json( app.adapter( ) ) },
+        { "performance_profile", magic_enum::enum_name( *profile ) },
+        { "results", *results },
+    };
+
+    if ( parsed.count( "output" ) == 0U )
+    {
+        std::cout << json.dump( 2 ) << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    auto const output_file = parsed[ "output" ].as< std::string >( );
+    auto       file        = std::ofstream( output_file );
+    if ( !( file << json.dump( 2 ) << '\n' ) )
+    {
+        spdlog::error( "Could not write '{}'", output_file );
+        return EXIT_FAILURE;
+    }
+    spdlog::info( "Wrote {} results to '{}'", results->size( ), output_file );
+
+    return EXIT_SUCCESS;
+}
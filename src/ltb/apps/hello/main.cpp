@@ -3,6 +3,12 @@
 // ///////////////////////////////////////////////////////////////////////////////////////
 
 // project
+#include "ltb/utils/allocation_tracker.hpp"
+#include "ltb/utils/binary_log.hpp"
+#include "ltb/utils/frame_statistics.hpp"
+#include "ltb/utils/logging.hpp"
+#include "ltb/utils/profiler.hpp"
+#include "ltb/utils/timers.hpp"
 #include "ltb/utils/types.hpp"
 #include "ltb/wgpu/app.hpp"
 
@@ -15,6 +21,20 @@ int main( )
 {
     spdlog::set_level( spdlog::level::debug );
 
+    // Keep slow console writes off the render thread.
+    if ( auto result = ltb::utils::start_async_logging( { } ); !result )
+    {
+        spdlog::error( "{}", result.error( ).error_message( ) );
+    }
+    LTB_PROFILE_THREAD_NAME( "main" );
+
+    // Per-frame diagnostics are formatted on the writer thread, not the render thread.
+    auto binary_log = ltb::utils::BinaryLogWriter{ { } };
+    if ( auto result = binary_log.start( ); !result )
+    {
+        spdlog::error( "{}", result.error( ).error_message( ) );
+    }
+
     auto window = ltb::window::GlfwOsWindow{ {
         .title        = "Hello",
         .resizable    = false,
@@ -25,13 +45,51 @@ int main( )
 
     app.run( );
 
+    auto frame_statistics = ltb::utils::FrameStatistics{ { } };
+    auto frame_timer      = ltb::utils::Timer{ };
+    auto frame_allocation = ltb::utils::FrameAllocationMonitor{ };
+
     spdlog::debug( "Waiting..." );
     while ( !window.should_close( ) )
     {
         window.poll_events( );
         app.process( );
+        LTB_PROFILE_FRAME( "frame" );
+
+        auto const frame_time = frame_timer.duration_since_start( );
+        frame_timer.start( );
+        frame_statistics.record( frame_time );
+        LTB_BINARY_LOG_TRACE(
+            "Frame took {:.3f}ms",
+            ltb::utils::to_millis< ltb::float64 >( frame_time )
+        );
+        frame_allocation.end_frame( );
+
+        if ( auto result = frame_statistics.report_if_due( ); !result )
+        {
+            spdlog::error( "{}", result.error( ).error_message( ) );
+        }
     }
     spdlog::debug( "Exiting." );
 
+    if constexpr ( ltb::utils::allocation_tracking_enabled( ) )
+    {
+        spdlog::info(
+            "{} of {} steady-state frames allocated",
+            frame_allocation.allocating_frames( ),
+            frame_allocation.steady_state_frames( )
+        );
+    }
+
+#ifdef LTB_ENABLE_PROFILER
+    if ( auto result = ltb::utils::write_chrome_trace( "hello_trace.json" ); !result )
+    {
+        spdlog::error( "{}", result.error( ).error_message( ) );
+    }
+#endif
+
+    binary_log.stop( );
+    ltb::utils::stop_async_logging( );
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,96 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+
+// project
+#include "ltb/utils/binary_log.hpp"
+
+// external
+#include <cxxopts.hpp>
+
+// standard
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+auto print( ltb::utils::BinaryLogMessage const& message ) -> void
+{
+    std::cout << fmt::format(
+        "[{:.6f}] [t{}] [{}] [{}:{}] {}\n",
+        static_cast< double >( message.timestamp_ns ) * 1e-9,
+        message.thread_id,
+        spdlog::level::to_string_view( message.level ),
+        message.file,
+        message.line,
+        message.text
+    );
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+    auto options = cxxopts::Options( "logdecode-app", "Formats a binary log written by LTB" );
+    // clang-format off
+    options.add_options( )
+        ( "log", "File written by BinaryLogWriter", cxxopts::value< std::string >( ) )
+        ( "sort", "Merge threads by timestamp instead of printing in file order" )
+        ( "h,help", "Print usage" );
+    // clang-format on
+    options.parse_positional( { "log" } );
+    options.positional_help( "<binary log file>" );
+
+    auto const parsed = options.parse( argc, argv );
+    if ( ( parsed.count( "help" ) > 0U ) || ( parsed.count( "log" ) == 0U ) )
+    {
+        spdlog::info( "{}", options.help( ) );
+        return ( parsed.count( "help" ) > 0U ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    auto const log_file = std::filesystem::path( parsed[ "log" ].as< std::string >( ) );
+    auto const sort     = ( parsed.count( "sort" ) > 0U );
+
+    // Sorting needs every message in memory, so the site strings are copied out.
+    struct SortedMessage
+    {
+        std::string                  file;
+        ltb::utils::BinaryLogMessage message;
+    };
+    auto messages = std::vector< SortedMessage >{ };
+
+    auto const result = ltb::utils::decode_binary_log_file(
+        log_file,
+        [ & ]( ltb::utils::BinaryLogMessage const& message )
+        {
+            if ( sort )
+            {
+                messages.emplace_back( std::string( message.file ), message );
+            }
+            else
+            {
+                print( message );
+            }
+        }
+    );
+    if ( !result )
+    {
+        spdlog::error( "{}", result.error( ).error_message( ) );
+        return EXIT_FAILURE;
+    }
+
+    std::ranges::stable_sort(
+        messages,
+        std::less{ },
+        []( SortedMessage const& sorted ) { return sorted.message.timestamp_ns; }
+    );
+    for ( auto& [ file, message ] : messages )
+    {
+        message.file = file;
+        print( message );
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+
+// project
+#include "ltb/utils/timers.hpp"
+#include "ltb/wgpu/api_trace_replay.hpp"
+#include "ltb/wgpu/app.hpp"
+
+// external
+#include <cxxopts.hpp>
+
+int main( int argc, char** argv )
+{
+    auto options = cxxopts::Options( "replay-app", "Replays a recorded WebGPU trace" );
+    // clang-format off
+    options.add_options( )
+        ( "trace", "Trace file written by ApiTraceRecorder", cxxopts::value< std::string >( ) )
+        ( "original-timing", "Wait for each call's recorded time between calls" )
+        ( "iterations", "Replay count", cxxopts::value< int >( )->default_value( "1" ) )
+        ( "h,help", "Print usage" );
+    // clang-format on
+    options.parse_positional( { "trace" } );
+    options.positional_help( "<trace file>" );
+
+    auto const parsed = options.parse( argc, argv );
+    if ( ( parsed.count( "help" ) > 0U ) || ( parsed.count( "trace" ) == 0U ) )
+    {
+        spdlog::info( "{}", options.help( ) );
+        return ( parsed.count( "help" ) > 0U ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    auto const trace_file = std::filesystem::path( parsed[ "trace" ].as< std::string >( ) );
+    auto const iterations = parsed[ "iterations" ].as< int >( );
+    auto const settings   = ltb::wgpu::ApiTraceReplaySettings{
+          .timing = ( parsed.count( "original-timing" ) > 0U )
+                      ? ltb::wgpu::ApiTraceReplayTiming::Original
+                      : ltb::wgpu::ApiTraceReplayTiming::AsFastAsPossible,
+    };
+
+    // Replays run on the software adapter so results don't depend on the GPU or driver.
+    auto app = ltb::wgpu::App{ { .force_fallback_adapter = true } };
+    app.run( );
+
+    constexpr auto device_timeout = ltb::utils::duration_seconds( 10 );
+
+    auto timer = ltb::utils::Timer{ };
+    while ( app.instance( ) && !app.queue( ) && ( timer.duration_since_start( ) < device_timeout ) )
+    {
+        app.process( );
+    }
+    if ( !app.queue( ) )
+    {
+        spdlog::error( "Could not create a WebGPU device on the fallback adapter" );
+        return EXIT_FAILURE;
+    }
+
+    for ( auto iteration = 0; iteration < iterations; ++iteration )
+    {
+        auto const stats = ltb::wgpu::replay_api_trace(
+            trace_file,
+            app.instance( ),
+            app.device( ),
+            app.queue( ),
+            app.memory_tracker( ),
+            settings
+        );
+        if ( !stats )
+        {
+            spdlog::error( "Replay failed: {}", stats.error( ).error_message( ) );
+            return EXIT_FAILURE;
+        }
+
+        spdlog::info(
+            "Replay {}: {} commands, {} submits, {} bytes written. "
+            "CPU {}us, total {}us (recorded {}us)",
+            iteration,
+            stats->command_count,
+            stats->submit_count,
+            stats->bytes_written,
+            ltb::utils::to_micros( stats->cpu_duration ),
+            ltb::utils::to_micros( stats->total_duration ),
+            ltb::utils::to_micros( stats->recorded_duration )
+        );
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,336 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "allocation_tracker.hpp"
+
+#include "ignore.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <new>
+
+namespace ltb::utils
+{
+namespace
+{
+
+/// \brief Plain integers so counting never allocates or takes a lock. Trivially
+///        destructible, so it's safe to touch during thread startup and teardown.
+thread_local auto thread_counts = AllocationCounts{ };
+
+std::atomic< uint64 > process_allocations       = 0U;
+std::atomic< uint64 > process_deallocations     = 0U;
+std::atomic< uint64 > process_allocated_bytes   = 0U;
+std::atomic< uint64 > total_no_alloc_violations = 0U;
+
+#ifdef LTB_TRACK_ALLOCATIONS
+
+auto count_allocation( std::size_t const bytes ) -> void
+{
+    ++thread_counts.allocations;
+    thread_counts.allocated_bytes += bytes;
+    process_allocations.fetch_add( 1U, std::memory_order_relaxed );
+    process_allocated_bytes.fetch_add( bytes, std::memory_order_relaxed );
+}
+
+auto count_deallocation( void* const pointer ) -> void
+{
+    if ( nullptr != pointer )
+    {
+        ++thread_counts.deallocations;
+        process_deallocations.fetch_add( 1U, std::memory_order_relaxed );
+    }
+}
+
+auto tracked_allocate( std::size_t const bytes ) noexcept -> void*
+{
+    count_allocation( bytes );
+    return std::malloc( ( bytes > 0U ) ? bytes : 1U );
+}
+
+auto tracked_allocate( std::size_t const bytes, std::align_val_t const alignment ) noexcept
+    -> void*
+{
+    count_allocation( bytes );
+
+    auto const align = static_cast< std::size_t >( alignment );
+#ifdef _WIN32
+    return ::_aligned_malloc( ( bytes > 0U ) ? bytes : 1U, align );
+#else
+    // aligned_alloc requires the size to be a multiple of the alignment.
+    auto const padded = ( ( std::max( bytes, std::size_t{ 1U } ) + align - 1U ) / align ) * align;
+    return std::aligned_alloc( align, padded );
+#endif
+}
+
+auto tracked_free( void* const pointer ) noexcept -> void
+{
+    count_deallocation( pointer );
+    std::free( pointer );
+}
+
+auto tracked_aligned_free( void* const pointer ) noexcept -> void
+{
+    count_deallocation( pointer );
+#ifdef _WIN32
+    ::_aligned_free( pointer );
+#else
+    std::free( pointer );
+#endif
+}
+
+auto throwing_allocate( std::size_t const bytes ) -> void*
+{
+    if ( auto* const pointer = tracked_allocate( bytes ) )
+    {
+        return pointer;
+    }
+    throw std::bad_alloc( );
+}
+
+auto throwing_allocate( std::size_t const bytes, std::align_val_t const alignment ) -> void*
+{
+    if ( auto* const pointer = tracked_allocate( bytes, alignment ) )
+    {
+        return pointer;
+    }
+    throw std::bad_alloc( );
+}
+
+#endif
+
+} // namespace
+
+auto operator-( AllocationCounts const& lhs, AllocationCounts const& rhs ) -> AllocationCounts
+{
+    return {
+        .allocations     = lhs.allocations - rhs.allocations,
+        .deallocations   = lhs.deallocations - rhs.deallocations,
+        .allocated_bytes = lhs.allocated_bytes - rhs.allocated_bytes,
+    };
+}
+
+auto thread_allocation_counts( ) -> AllocationCounts
+{
+    return thread_counts;
+}
+
+auto process_allocation_counts( ) -> AllocationCounts
+{
+    return {
+        .allocations     = process_allocations.load( std::memory_order_relaxed ),
+        .deallocations   = process_deallocations.load( std::memory_order_relaxed ),
+        .allocated_bytes = process_allocated_bytes.load( std::memory_order_relaxed ),
+    };
+}
+
+FrameAllocationMonitor::FrameAllocationMonitor( uint32 const warmup_frames )
+    : warmup_frames_( warmup_frames )
+    , frame_start_( thread_allocation_counts( ) )
+{
+}
+
+auto FrameAllocationMonitor::end_frame( ) -> AllocationCounts
+{
+    auto const now   = thread_allocation_counts( );
+    auto const frame = now - frame_start_;
+
+    if ( ++frame_count_ > warmup_frames_ )
+    {
+        ++steady_state_frames_;
+
+        if ( frame.allocations > 0U )
+        {
+            // Warn on the 1st, 2nd, 4th, 8th... allocating frame to avoid flooding the log.
+            if ( std::has_single_bit( ++allocating_frames_ ) )
+            {
+                spdlog::warn(
+                    "Frame {} allocated {} times ({} bytes). {} of {} steady-state frames "
+                    "have allocated.",
+                    frame_count_,
+                    frame.allocations,
+                    frame.allocated_bytes,
+                    allocating_frames_,
+                    steady_state_frames_
+                );
+            }
+        }
+    }
+
+    // Start after logging so the warning's own allocations aren't counted.
+    frame_start_ = thread_allocation_counts( );
+    return frame;
+}
+
+auto FrameAllocationMonitor::steady_state_frames( ) const -> uint64
+{
+    return steady_state_frames_;
+}
+
+auto FrameAllocationMonitor::allocating_frames( ) const -> uint64
+{
+    return allocating_frames_;
+}
+
+auto begin_no_alloc_scope( NoAllocSite* const site, AllocationCounts& start ) -> void
+{
+    ignore( site );
+    start = thread_allocation_counts( );
+}
+
+auto end_no_alloc_scope( NoAllocSite* const site, AllocationCounts& start ) -> void
+{
+    auto const scope = thread_allocation_counts( ) - start;
+    if ( 0U == scope.allocations )
+    {
+        return;
+    }
+
+    total_no_alloc_violations.fetch_add( 1U, std::memory_order_relaxed );
+    if ( 0U == site->violations.fetch_add( 1U, std::memory_order_relaxed ) )
+    {
+        spdlog::error(
+            "No-allocation scope '{}' ({}:{}) allocated {} times ({} bytes). "
+            "Further violations here are only counted.",
+            site->name,
+            site->file,
+            site->line,
+            scope.allocations,
+            scope.allocated_bytes
+        );
+    }
+}
+
+auto make_no_alloc_guard( NoAllocSite& site ) -> NoAllocGuard
+{
+    return make_guard( &begin_no_alloc_scope, &end_no_alloc_scope, &site, AllocationCounts{ } );
+}
+
+auto no_alloc_violations( ) -> uint64
+{
+    return total_no_alloc_violations.load( std::memory_order_relaxed );
+}
+
+} // namespace ltb::utils
+
+#ifdef LTB_TRACK_ALLOCATIONS
+
+// Replacements for every global allocation function, so the standard library and
+// third-party code are counted too.
+
+auto operator new( std::size_t const bytes ) -> void*
+{
+    return ltb::utils::throwing_allocate( bytes );
+}
+
+auto operator new[]( std::size_t const bytes ) -> void*
+{
+    return ltb::utils::throwing_allocate( bytes );
+}
+
+auto operator new( std::size_t const bytes, std::nothrow_t const& ) noexcept -> void*
+{
+    return ltb::utils::tracked_allocate( bytes );
+}
+
+auto operator new[]( std::size_t const bytes, std::nothrow_t const& ) noexcept -> void*
+{
+    return ltb::utils::tracked_allocate( bytes );
+}
+
+auto operator new( std::size_t const bytes, std::align_val_t const alignment ) -> void*
+{
+    return ltb::utils::throwing_allocate( bytes, alignment );
+}
+
+auto operator new[]( std::size_t const bytes, std::align_val_t const alignment ) -> void*
+{
+    return ltb::utils::throwing_allocate( bytes, alignment );
+}
+
+auto operator new(
+    std::size_t const      bytes,
+    std::align_val_t const alignment,
+    std::nothrow_t const&
+) noexcept -> void*
+{
+    return ltb::utils::tracked_allocate( bytes, alignment );
+}
+
+auto operator new[](
+    std::size_t const      bytes,
+    std::align_val_t const alignment,
+    std::nothrow_t const&
+) noexcept -> void*
+{
+    return ltb::utils::tracked_allocate( bytes, alignment );
+}
+
+auto operator delete( void* const pointer ) noexcept -> void
+{
+    ltb::utils::tracked_free( pointer );
+}
+
+auto operator delete[]( void* const pointer ) noexcept -> void
+{
+    ltb::utils::tracked_free( pointer );
+}
+
+auto operator delete( void* const pointer, std::size_t ) noexcept -> void
+{
+    ltb::utils::tracked_free( pointer );
+}
+
+auto operator delete[]( void* const pointer, std::size_t ) noexcept -> void
+{
+    ltb::utils::tracked_free( pointer );
+}
+
+auto operator delete( void* const pointer, std::nothrow_t const& ) noexcept -> void
+{
+    ltb::utils::tracked_free( pointer );
+}
+
+auto operator delete[]( void* const pointer, std::nothrow_t const& ) noexcept -> void
+{
+    ltb::utils::tracked_free( pointer );
+}
+
+auto operator delete( void* const pointer, std::align_val_t ) noexcept -> void
+{
+    ltb::utils::tracked_aligned_free( pointer );
+}
+
+auto operator delete[]( void* const pointer, std::align_val_t ) noexcept -> void
+{
+    ltb::utils::tracked_aligned_free( pointer );
+}
+
+auto operator delete( void* const pointer, std::size_t, std::align_val_t ) noexcept -> void
+{
+    ltb::utils::tracked_aligned_free( pointer );
+}
+
+auto operator delete[]( void* const pointer, std::size_t, std::align_val_t ) noexcept -> void
+{
+    ltb::utils::tracked_aligned_free( pointer );
+}
+
+auto operator delete( void* const pointer, std::align_val_t, std::nothrow_t const& ) noexcept
+    -> void
+{
+    ltb::utils::tracked_aligned_free( pointer );
+}
+
+auto operator delete[]( void* const pointer, std::align_val_t, std::nothrow_t const& ) noexcept
+    -> void
+{
+    ltb::utils::tracked_aligned_free( pointer );
+}
+
+#endif
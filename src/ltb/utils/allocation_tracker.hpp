@@ -0,0 +1,117 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "generic_guard.hpp"
+#include "macro.hpp"
+#include "types.hpp"
+
+// standard
+#include <atomic>
+
+namespace ltb::utils
+{
+
+/// \brief Allocation totals. Freed bytes aren't known for unsized deletes, so only
+///        allocated bytes are counted.
+struct AllocationCounts
+{
+    uint64 allocations     = 0U;
+    uint64 deallocations   = 0U;
+    uint64 allocated_bytes = 0U;
+
+    auto operator==( AllocationCounts const& ) const -> bool = default;
+};
+
+auto operator-( AllocationCounts const& lhs, AllocationCounts const& rhs ) -> AllocationCounts;
+
+/// \brief True when the global `operator new`/`delete` replacements are compiled in
+///        (`LTB_TRACK_ALLOCATIONS`). Every count is zero otherwise.
+constexpr auto allocation_tracking_enabled( ) -> bool
+{
+#ifdef LTB_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// \brief Totals for the calling thread since it started.
+auto thread_allocation_counts( ) -> AllocationCounts;
+
+/// \brief Totals for every thread since the process started.
+auto process_allocation_counts( ) -> AllocationCounts;
+
+/// \brief Counts the calling thread's allocations per frame once `warmup_frames` have passed,
+///        and warns when a steady-state frame allocates.
+class FrameAllocationMonitor
+{
+public:
+    explicit FrameAllocationMonitor( uint32 warmup_frames = 60U );
+
+    /// \brief Returns the allocations made since the previous call.
+    auto end_frame( ) -> AllocationCounts;
+
+    [[nodiscard( "Const getter" )]] auto steady_state_frames( ) const -> uint64;
+    [[nodiscard( "Const getter" )]] auto allocating_frames( ) const -> uint64;
+
+private:
+    uint32           warmup_frames_;
+    uint64           frame_count_         = 0U;
+    uint64           steady_state_frames_ = 0U;
+    uint64           allocating_frames_   = 0U;
+    AllocationCounts frame_start_         = { };
+};
+
+/// \brief Describes a scope that must not allocate. One is created statically per
+///        `LTB_ASSERT_NO_ALLOC`.
+struct NoAllocSite
+{
+    char const* name = "";
+    char const* file = "";
+    uint32      line = 0U;
+
+    std::atomic< uint64 > violations = 0U;
+};
+
+/// \brief Used by `LTB_ASSERT_NO_ALLOC` to snapshot and compare the calling thread's counts.
+auto begin_no_alloc_scope( NoAllocSite* site, AllocationCounts& start ) -> void;
+auto end_no_alloc_scope( NoAllocSite* site, AllocationCounts& start ) -> void;
+
+using NoAllocGuard = GenericGuard<
+    decltype( &begin_no_alloc_scope ),
+    decltype( &end_no_alloc_scope ),
+    NoAllocSite*,
+    AllocationCounts >;
+
+/// \brief Reports any allocation made on the calling thread while the guard is alive.
+///        The first violation at each site is logged; later ones are only counted.
+auto make_no_alloc_guard( NoAllocSite& site ) -> NoAllocGuard;
+
+/// \brief The number of `LTB_ASSERT_NO_ALLOC` scopes that allocated.
+auto no_alloc_violations( ) -> uint64;
+
+} // namespace ltb::utils
+
+#ifdef LTB_TRACK_ALLOCATIONS
+
+// Do not use this macro directly; use LTB_ASSERT_NO_ALLOC instead.
+#define DETAIL_LTB_ASSERT_NO_ALLOC( site_name, guard_name, name )                                  \
+    static auto site_name  = ::ltb::utils::NoAllocSite{ name, __FILE__, __LINE__ };                \
+    auto const  guard_name = ::ltb::utils::make_no_alloc_guard( site_name )
+
+/// \brief Reports allocations made on the calling thread before the enclosing scope
+///        ends. `name` is a string literal identifying the scope.
+#define LTB_ASSERT_NO_ALLOC( name )                                                                \
+    DETAIL_LTB_ASSERT_NO_ALLOC(                                                                    \
+        LTB_CONCAT( ltb_no_alloc_site_, __LINE__ ),                                                \
+        LTB_CONCAT( ltb_no_alloc_guard_, __LINE__ ),                                               \
+        name                                                                                       \
+    )
+
+#else
+
+#define LTB_ASSERT_NO_ALLOC( name ) static_cast< void >( 0 )
+
+#endif
@@ -0,0 +1,988 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "batch_file_loader.hpp"
+
+// project
+#include "generic_guard.hpp"
+
+// standard
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define LTB_BATCH_FILE_LOADER_HAS_PREAD
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined( __linux__ ) && __has_include( <linux/io_uring.h> )
+#include <sys/syscall.h>
+#ifdef __NR_io_uring_setup
+#define LTB_BATCH_FILE_LOADER_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#endif
+#endif
+
+namespace ltb::utils
+{
+namespace
+{
+
+/// \brief The kernel caps rings at 32768 entries, but far fewer already saturate a device.
+constexpr auto max_queue_depth = 4096U;
+
+/// \brief Checks the caller gave somewhere big enough to read the whole file to.
+auto allocate_destination(
+    FileLoadCallbacks const&     callbacks,
+    std::size_t const            index,
+    std::filesystem::path const& file_path,
+    uint64 const                 size
+) -> Result< std::span< std::byte > >
+{
+    auto destination = callbacks.allocate( index, size );
+    if ( destination.size( ) < size )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::InvalidArgument,
+            "Destination for file '{}' holds {} bytes but the file has {}",
+            file_path.string( ),
+            destination.size( ),
+            size
+        );
+    }
+    return destination;
+}
+
+#ifdef LTB_BATCH_FILE_LOADER_HAS_PREAD
+
+/// \brief Opens a file and gets its size. A negative descriptor is never returned.
+auto open_file( std::filesystem::path const& file_path, int& file ) -> Result< uint64 >
+{
+    file = ::open( file_path.c_str( ), O_RDONLY | O_CLOEXEC );
+    if ( file < 0 )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::Io,
+            "Failed to open file '{}': {}",
+            file_path.string( ),
+            std::strerror( errno )
+        );
+    }
+
+    struct stat status = { };
+    if ( 0 != ::fstat( file, &status ) )
+    {
+        auto const error_number = errno;
+        ::close( std::exchange( file, -1 ) );
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::Io,
+            "Failed to stat file '{}': {}",
+            file_path.string( ),
+            std::strerror( error_number )
+        );
+    }
+
+    return static_cast< uint64 >( status.st_size );
+}
+
+#endif
+
+} // namespace
+
+#ifdef LTB_BATCH_FILE_LOADER_HAS_IO_URING
+
+/// \brief A minimal `io_uring` built on the raw system calls, so nothing beyond the kernel
+///        headers is needed. Only one thread ever touches the queues.
+struct BatchFileLoader::IoUring
+{
+    int fd = -1;
+
+    void*       submission_ring      = MAP_FAILED;
+    std::size_t submission_ring_size = 0UZ;
+    void*       completion_ring      = MAP_FAILED;
+    std::size_t completion_ring_size = 0UZ;
+
+    io_uring_sqe* entries      = static_cast< io_uring_sqe* >( MAP_FAILED );
+    std::size_t   entries_size = 0UZ;
+
+    uint32* submission_head  = nullptr;
+    uint32* submission_tail  = nullptr;
+    uint32* submission_array = nullptr;
+    uint32  submission_mask  = 0U;
+
+    uint32*       completion_head = nullptr;
+    uint32*       completion_tail = nullptr;
+    io_uring_cqe* completions     = nullptr;
+    uint32        completion_mask = 0U;
+
+    /// \brief Entries added to the submission queue but not yet handed to the kernel.
+    uint32 unsubmitted = 0U;
+
+    IoUring( )  = default;
+    ~IoUring( )
+    {
+        if ( MAP_FAILED != static_cast< void* >( entries ) )
+        {
+            ::munmap( entries, entries_size );
+        }
+        if ( MAP_FAILED != completion_ring )
+        {
+            ::munmap( completion_ring, completion_ring_size );
+        }
+        if ( MAP_FAILED != submission_ring )
+        {
+            ::munmap( submission_ring, submission_ring_size );
+        }
+        if ( fd >= 0 )
+        {
+            ::close( fd );
+        }
+    }
+
+    // No copy or move. The mapped queues belong to this object.
+    IoUring( IoUring const& )                        = delete;
+    IoUring( IoUring&& ) noexcept                    = delete;
+    auto operator=( IoUring const& ) -> IoUring&     = delete;
+    auto operator=( IoUring&& ) noexcept -> IoUring& = delete;
+
+    /// \brief Null if the kernel doesn't provide `io_uring` or forbids it, as many
+    ///        containers do, or if it is too old to support plain reads.
+    static auto create( uint32 const queue_depth ) -> std::unique_ptr< IoUring >
+    {
+        auto ring   = std::make_unique< IoUring >( );
+        auto params = io_uring_params{ };
+
+        ring->fd = static_cast< int >( ::syscall( __NR_io_uring_setup, queue_depth, &params ) );
+        if ( ring->fd < 0 )
+        {
+            return nullptr;
+        }
+
+        if ( !ring->supports_read( ) )
+        {
+            return nullptr;
+        }
+
+        ring->submission_ring_size = params.sq_off.array + ( params.sq_entries * sizeof( uint32 ) );
+        ring->completion_ring_size
+            = params.cq_off.cqes + ( params.cq_entries * sizeof( io_uring_cqe ) );
+        ring->entries_size = params.sq_entries * sizeof( io_uring_sqe );
+
+        auto const map = [ &ring ]( std::size_t const size, off_t const offset ) {
+            return ::mmap(
+                nullptr,
+                size,
+                PROT_READ | PROT_WRITE,
+                MAP_SHARED,
+                ring->fd,
+                offset
+            );
+        };
+        ring->submission_ring = map( ring->submission_ring_size, IORING_OFF_SQ_RING );
+        ring->completion_ring = map( ring->completion_ring_size, IORING_OFF_CQ_RING );
+        ring->entries = static_cast< io_uring_sqe* >( map( ring->entries_size, IORING_OFF_SQES ) );
+
+        if ( ( MAP_FAILED == ring->submission_ring ) || ( MAP_FAILED == ring->completion_ring )
+             || ( MAP_FAILED == static_cast< void* >( ring->entries ) ) )
+        {
+            return nullptr;
+        }
+
+        // The kernel aligns every field it reports an offset for, so the casts are safe.
+        auto* const submission = static_cast< std::byte* >( ring->submission_ring );
+        auto const  sq_field   = [ submission ]( uint32 const offset ) {
+            return static_cast< uint32* >( static_cast< void* >( submission + offset ) );
+        };
+        ring->submission_head  = sq_field( params.sq_off.head );
+        ring->submission_tail  = sq_field( params.sq_off.tail );
+        ring->submission_array = sq_field( params.sq_off.array );
+        ring->submission_mask  = *sq_field( params.sq_off.ring_mask );
+
+        auto* const completion = static_cast< std::byte* >( ring->completion_ring );
+        auto const  cq_field   = [ completion ]( uint32 const offset ) {
+            return static_cast< uint32* >( static_cast< void* >( completion + offset ) );
+        };
+        ring->completion_head = cq_field( params.cq_off.head );
+        ring->completion_tail = cq_field( params.cq_off.tail );
+        ring->completion_mask = *cq_field( params.cq_off.ring_mask );
+        auto* const cqes  = completion + params.cq_off.cqes;
+        ring->completions = static_cast< io_uring_cqe* >( static_cast< void* >( cqes ) );
+
+        return ring;
+    }
+
+    /// \brief `IORING_OP_READ` arrived in Linux 5.6, a little after `io_uring` itself.
+    [[nodiscard]] auto supports_read( ) const -> bool
+    {
+        constexpr auto probed_ops = 256U;
+
+        // Sized in whole ops so the storage is aligned for both the header and the ops.
+        static_assert( 0U == ( sizeof( io_uring_probe ) % sizeof( io_uring_probe_op ) ) );
+        static_assert( alignof( io_uring_probe ) <= alignof( io_uring_probe_op ) );
+        auto probe = std::vector< io_uring_probe_op >(
+            ( sizeof( io_uring_probe ) / sizeof( io_uring_probe_op ) ) + probed_ops
+        );
+        auto* const ops = static_cast< io_uring_probe* >( static_cast< void* >( probe.data( ) ) );
+
+        if ( ::syscall( __NR_io_uring_register, fd, IORING_REGISTER_PROBE, ops, probed_ops ) < 0 )
+        {
+            return false;
+        }
+        return ( ops->last_op >= IORING_OP_READ )
+            && ( 0U != ( ops->ops[ IORING_OP_READ ].flags & IO_URING_OP_SUPPORTED ) );
+    }
+
+    /// \brief The caller keeps at most one entry in flight per slot, and there are never
+    ///        more slots than entries, so the submission queue can't be full.
+    auto queue_read(
+        int const                    file,
+        std::span< std::byte > const destination,
+        uint64 const                 offset,
+        uint64 const                 user_data
+    ) -> void
+    {
+        auto const tail  = *submission_tail;
+        auto const index = tail & submission_mask;
+
+        auto& entry     = entries[ index ];
+        entry           = io_uring_sqe{ };
+        entry.opcode    = IORING_OP_READ;
+        entry.fd        = file;
+        entry.off       = offset;
+        entry.addr      = reinterpret_cast< uint64 >( destination.data( ) );
+        entry.len       = static_cast< uint32 >( destination.size( ) );
+        entry.user_data = user_data;
+
+        submission_array[ index ] = index;
+
+        // Publishes the entry to the kernel.
+        std::atomic_ref( *submission_tail ).store( tail + 1U, std::memory_order_release );
+        ++unsubmitted;
+    }
+
+    /// \brief Hands queued reads to the kernel and, if `wait`, blocks for one to finish.
+    auto submit_and_wait( bool wait ) -> Result< void >
+    {
+        while ( true )
+        {
+            auto const flags    = wait ? IORING_ENTER_GETEVENTS : 0U;
+            auto const complete = wait ? 1U : 0U;
+
+            auto const submitted
+                = ::syscall( __NR_io_uring_enter, fd, unsubmitted, complete, flags, nullptr, 0UZ );
+            if ( submitted < 0 )
+            {
+                if ( EINTR == errno )
+                {
+                    continue;
+                }
+                return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+                    ErrorCode::Io,
+                    "io_uring_enter failed: {}",
+                    std::strerror( errno )
+                );
+            }
+
+            unsubmitted -= static_cast< uint32 >( submitted );
+            if ( 0U == unsubmitted )
+            {
+                return success( );
+            }
+            wait = false;
+        }
+    }
+
+    /// \brief Calls `on_completion( user_data, result )` for every finished read.
+    template < typename OnCompletion >
+    auto reap( OnCompletion&& on_completion ) -> void
+    {
+        auto       head = *completion_head;
+        auto const tail = std::atomic_ref( *completion_tail ).load( std::memory_order_acquire );
+
+        for ( ; head != tail; ++head )
+        {
+            auto const& completion = completions[ head & completion_mask ];
+            on_completion( completion.user_data, completion.res );
+        }
+
+        // Gives the entries back to the kernel.
+        std::atomic_ref( *completion_head ).store( head, std::memory_order_release );
+    }
+
+    /// \brief Blocks until the kernel is done with all `reads` queued reads, so none can
+    ///        write to its destination afterwards. Reads never handed to the kernel are
+    ///        taken back and the rest are cancelled where the kernel supports it. File reads
+    ///        always finish, so older kernels only wait longer.
+    auto cancel_and_drain( uint32 reads ) -> Result< void >
+    {
+        constexpr auto cancel_user_data = std::numeric_limits< uint64 >::max( );
+
+        // The kernel only reads entries up to the tail when entering, so these were never seen.
+        auto const tail = *submission_tail - unsubmitted;
+        std::atomic_ref( *submission_tail ).store( tail, std::memory_order_release );
+        reads       -= unsubmitted;
+        unsubmitted  = 0U;
+
+        if ( 0U == reads )
+        {
+            return success( );
+        }
+
+#ifdef IORING_ASYNC_CANCEL_ANY
+        auto const index   = tail & submission_mask;
+        auto&      entry   = entries[ index ];
+        entry              = io_uring_sqe{ };
+        entry.opcode       = IORING_OP_ASYNC_CANCEL;
+        entry.fd           = -1;
+        entry.cancel_flags = IORING_ASYNC_CANCEL_ANY;
+        entry.user_data    = cancel_user_data;
+
+        submission_array[ index ] = index;
+        std::atomic_ref( *submission_tail ).store( tail + 1U, std::memory_order_release );
+        ++unsubmitted;
+#endif
+
+        while ( reads > 0U )
+        {
+            auto const submitted = ::syscall(
+                __NR_io_uring_enter,
+                fd,
+                unsubmitted,
+                1U,
+                IORING_ENTER_GETEVENTS,
+                nullptr,
+                0UZ
+            );
+            if ( submitted >= 0 )
+            {
+                unsubmitted -= static_cast< uint32 >( submitted );
+            }
+            // A full completion queue reports EBUSY until it is reaped below.
+            else if ( ( EINTR != errno ) && ( EAGAIN != errno ) && ( EBUSY != errno ) )
+            {
+                return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+                    ErrorCode::Io,
+                    "io_uring_enter failed while cancelling reads: {}",
+                    std::strerror( errno )
+                );
+            }
+
+            reap( [ &reads ]( uint64 const user_data, int32 const result ) {
+                ignore( result );
+                if ( cancel_user_data != user_data )
+                {
+                    --reads;
+                }
+            } );
+        }
+        return success( );
+    }
+};
+
+#else
+
+struct BatchFileLoader::IoUring
+{
+};
+
+#endif
+
+/// \brief Workers started once per loader and fed tasks through a queue, so loads don't pay
+///        for starting threads.
+struct BatchFileLoader::ThreadPool
+{
+    std::mutex                             mutex      = { };
+    std::condition_variable_any            work_ready = { };
+    std::deque< std::function< void( ) > > tasks      = { };
+
+    /// \brief Declared last so the workers are joined before the queue is destroyed.
+    std::vector< std::jthread > workers = { };
+
+    explicit ThreadPool( uint32 const thread_count )
+    {
+        workers.reserve( thread_count );
+        for ( auto i = 0U; i < thread_count; ++i )
+        {
+            workers.emplace_back( [ this ]( std::stop_token const& stop_token ) {
+                run( stop_token );
+            } );
+        }
+    }
+
+    // Stops and joins the workers, which finish any task they are running first.
+    ~ThreadPool( ) = default;
+
+    // No copy or move. The workers refer to this object.
+    ThreadPool( ThreadPool const& )                        = delete;
+    ThreadPool( ThreadPool&& ) noexcept                    = delete;
+    auto operator=( ThreadPool const& ) -> ThreadPool&     = delete;
+    auto operator=( ThreadPool&& ) noexcept -> ThreadPool& = delete;
+
+    auto push( std::function< void( ) > task ) -> void
+    {
+        {
+            auto const lock = std::scoped_lock( mutex );
+            tasks.push_back( std::move( task ) );
+        }
+        work_ready.notify_one( );
+    }
+
+    auto run( std::stop_token const& stop_token ) -> void
+    {
+        while ( true )
+        {
+            auto task = std::function< void( ) >{ };
+            {
+                auto lock = std::unique_lock( mutex );
+                if ( !work_ready.wait( lock, stop_token, [ this ] { return !tasks.empty( ); } ) )
+                {
+                    return;
+                }
+                task = std::move( tasks.front( ) );
+                tasks.pop_front( );
+            }
+            task( );
+        }
+    }
+};
+
+BatchFileLoader::BatchFileLoader( BatchFileLoaderSettings settings )
+    : settings_( std::move( settings ) )
+{
+    settings_.queue_depth = std::clamp( settings_.queue_depth, 1U, max_queue_depth );
+    settings_.chunk_size  = std::clamp(
+        settings_.chunk_size,
+        uint64{ 1U },
+        uint64{ std::numeric_limits< uint32 >::max( ) }
+    );
+
+#ifdef LTB_BATCH_FILE_LOADER_HAS_IO_URING
+    if ( !settings_.force_thread_pool )
+    {
+        ring_ = IoUring::create( settings_.queue_depth );
+    }
+#endif
+}
+
+BatchFileLoader::~BatchFileLoader( ) = default;
+
+auto BatchFileLoader::load(
+    std::span< std::filesystem::path const > const file_paths,
+    FileLoadCallbacks const&                       callbacks
+) -> void
+{
+    if ( nullptr != ring_ )
+    {
+        load_with_io_uring( file_paths, callbacks );
+    }
+    else
+    {
+        load_with_thread_pool( file_paths, callbacks );
+    }
+}
+
+auto BatchFileLoader::backend( ) const -> FileLoaderBackend
+{
+    return ( nullptr != ring_ ) ? FileLoaderBackend::IoUring : FileLoaderBackend::ThreadPool;
+}
+
+auto BatchFileLoader::load_with_io_uring(
+    std::span< std::filesystem::path const > const file_paths,
+    FileLoadCallbacks const&                       callbacks
+) -> void
+{
+#ifdef LTB_BATCH_FILE_LOADER_HAS_IO_URING
+    struct OpenFile
+    {
+        int                    fd          = -1;
+        std::span< std::byte > destination = { };
+        uint64                 queued      = 0U;
+        uint64                 read        = 0U;
+        uint32                 in_flight   = 0U;
+        bool                   finished    = false;
+        std::optional< Error > error       = std::nullopt;
+    };
+
+    /// \brief One read in flight. Its index is the `user_data` of the queue entry.
+    struct Slot
+    {
+        std::size_t file   = 0UZ;
+        uint64      offset = 0U;
+        uint64      size   = 0U;
+    };
+
+    auto files = std::vector< OpenFile >( file_paths.size( ) );
+    auto slots = std::vector< Slot >( settings_.queue_depth );
+
+    auto free_slots = std::vector< uint64 >( slots.size( ) );
+    std::iota( free_slots.begin( ), free_slots.end( ), uint64{ 0U } );
+
+    // Short reads are finished by re-queueing the rest of the same slot.
+    auto retries = std::vector< uint64 >{ };
+
+    // Opened files that still have chunks to queue, oldest first.
+    auto queueing   = std::deque< std::size_t >{ };
+    auto next_file  = 0UZ;
+    auto open_files = 0U;
+    auto in_flight  = 0U;
+
+    auto const finish = [ & ]( std::size_t const index ) {
+        auto& file = files[ index ];
+        if ( std::exchange( file.finished, true ) )
+        {
+            return;
+        }
+        if ( file.fd >= 0 )
+        {
+            ::close( std::exchange( file.fd, -1 ) );
+            --open_files;
+        }
+        if ( file.error )
+        {
+            callbacks.loaded( index, tl::make_unexpected( std::move( *file.error ) ) );
+        }
+        else
+        {
+            callbacks.loaded( index, success( ) );
+        }
+    };
+
+    auto const fail = [ & ]( std::size_t const index, Error error ) {
+        auto& file = files[ index ];
+        if ( !file.error )
+        {
+            file.error = std::move( error );
+        }
+        // Stop queueing its chunks and report it once the reads already queued are back.
+        file.queued = file.destination.size( );
+        if ( 0U == file.in_flight )
+        {
+            finish( index );
+        }
+    };
+
+    auto const queue = [ & ]( uint64 const slot_index ) {
+        auto const& slot = slots[ slot_index ];
+        auto&       file = files[ slot.file ];
+        ring_->queue_read(
+            file.fd,
+            file.destination.subspan( slot.offset, slot.size ),
+            slot.offset,
+            slot_index
+        );
+        ++file.in_flight;
+        ++in_flight;
+    };
+
+    // Opens the next file, returning false once there are none left to open.
+    auto const open_next = [ & ]( ) -> bool {
+        while ( next_file < file_paths.size( ) )
+        {
+            auto const  index     = next_file++;
+            auto const& file_path = file_paths[ index ];
+            auto&       file      = files[ index ];
+
+            auto size = open_file( file_path, file.fd );
+            if ( !size )
+            {
+                fail( index, std::move( size ).error( ) );
+                continue;
+            }
+            ++open_files;
+
+            auto destination = allocate_destination( callbacks, index, file_path, *size );
+            if ( !destination )
+            {
+                fail( index, std::move( destination ).error( ) );
+                continue;
+            }
+            file.destination = destination->first( *size );
+
+            if ( file.destination.empty( ) )
+            {
+                finish( index );
+                continue;
+            }
+
+            queueing.push_back( index );
+            return true;
+        }
+        return false;
+    };
+
+    auto const fully_queued = [ & ]( std::size_t const index ) {
+        return files[ index ].queued == files[ index ].destination.size( );
+    };
+
+    while ( true )
+    {
+        // Fill every free slot, re-queueing short reads before starting new chunks.
+        while ( !free_slots.empty( ) || !retries.empty( ) )
+        {
+            if ( !retries.empty( ) )
+            {
+                auto const slot_index = retries.back( );
+                retries.pop_back( );
+
+                // The file failed while this read waited, so the rest of it isn't needed.
+                if ( files[ slots[ slot_index ].file ].error )
+                {
+                    free_slots.push_back( slot_index );
+                }
+                else
+                {
+                    queue( slot_index );
+                }
+                continue;
+            }
+
+            while ( !queueing.empty( ) && fully_queued( queueing.front( ) ) )
+            {
+                queueing.pop_front( );
+            }
+            if ( queueing.empty( ) && ( ( open_files >= settings_.queue_depth ) || !open_next( ) ) )
+            {
+                break;
+            }
+
+            auto const index = queueing.front( );
+            auto&      file  = files[ index ];
+            auto const size
+                = std::min( settings_.chunk_size, file.destination.size( ) - file.queued );
+
+            auto const slot_index = free_slots.back( );
+            free_slots.pop_back( );
+
+            slots[ slot_index ] = { .file = index, .offset = file.queued, .size = size };
+            file.queued += size;
+            queue( slot_index );
+        }
+
+        if ( 0U == in_flight )
+        {
+            break;
+        }
+
+        if ( auto submitted = ring_->submit_and_wait( true ); !submitted )
+        {
+            // The ring itself is broken, so every file still loading fails with it and later
+            // loads use the thread pool. Its reads must be finished before the failures are
+            // reported, or the kernel could still write to memory the caller has reused.
+            auto error = submitted.error( );
+            if ( auto drained = ring_->cancel_and_drain( in_flight ); !drained )
+            {
+                error = Error::append_message( error, drained.error( ).error_message( ) );
+            }
+            ring_.reset( );
+            for ( auto index = 0UZ; index < next_file; ++index )
+            {
+                files[ index ].in_flight = 0U;
+                fail( index, error );
+            }
+            for ( auto index = next_file; index < file_paths.size( ); ++index )
+            {
+                callbacks.loaded( index, tl::make_unexpected( error ) );
+            }
+            return;
+        }
+
+        ring_->reap( [ & ]( uint64 const slot_index, int32 const result ) {
+            auto&       slot  = slots[ slot_index ];
+            auto const  index = slot.file;
+            auto&       file  = files[ index ];
+            auto const& path  = file_paths[ index ];
+
+            --file.in_flight;
+            --in_flight;
+
+            if ( file.error )
+            {
+                free_slots.push_back( slot_index );
+                if ( 0U == file.in_flight )
+                {
+                    finish( index );
+                }
+                return;
+            }
+
+            if ( ( -EAGAIN == result ) || ( -EINTR == result ) )
+            {
+                retries.push_back( slot_index );
+                return;
+            }
+
+            if ( result <= 0 )
+            {
+                free_slots.push_back( slot_index );
+            }
+
+            if ( result < 0 )
+            {
+                fail(
+                    index,
+                    LTB_MAKE_ERROR_WITH_CODE(
+                        ErrorCode::Io,
+                        "Failed to read file '{}': {}",
+                        path.string( ),
+                        std::strerror( -result )
+                    )
+                );
+                return;
+            }
+
+            if ( 0 == result )
+            {
+                fail(
+                    index,
+                    LTB_MAKE_ERROR_WITH_CODE(
+                        ErrorCode::Io,
+                        "File '{}' ended after {} of {} bytes",
+                        path.string( ),
+                        slot.offset,
+                        file.destination.size( )
+                    )
+                );
+                return;
+            }
+
+            auto const bytes = static_cast< uint64 >( result );
+            file.read += bytes;
+
+            if ( bytes < slot.size )
+            {
+                slot.offset += bytes;
+                slot.size   -= bytes;
+                retries.push_back( slot_index );
+                return;
+            }
+            free_slots.push_back( slot_index );
+
+            if ( ( 0U == file.in_flight ) && ( file.read == file.destination.size( ) ) )
+            {
+                finish( index );
+            }
+        } );
+    }
+#else
+    utils::ignore( file_paths, callbacks );
+#endif
+}
+
+auto BatchFileLoader::load_with_thread_pool(
+    std::span< std::filesystem::path const > const file_paths,
+    FileLoadCallbacks const&                       callbacks
+) -> void
+{
+    struct Job
+    {
+        std::size_t            index       = 0UZ;
+        std::span< std::byte > destination = { };
+    };
+
+    struct Completion
+    {
+        std::size_t    index  = 0UZ;
+        Result< void > result = success( );
+    };
+
+    // Sizes are read and destinations allocated up front, on this thread, so callbacks
+    // never run on a worker.
+    auto jobs = std::vector< Job >{ };
+    jobs.reserve( file_paths.size( ) );
+
+    for ( auto index = 0UZ; index < file_paths.size( ); ++index )
+    {
+        auto const& file_path = file_paths[ index ];
+
+        auto error_code = std::error_code{ };
+        auto const size = std::filesystem::file_size( file_path, error_code );
+        if ( error_code )
+        {
+            callbacks.loaded(
+                index,
+                LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+                    ErrorCode::Io,
+                    "Failed to open file '{}': {}",
+                    file_path.string( ),
+                    error_code.message( )
+                )
+            );
+            continue;
+        }
+
+        auto destination = allocate_destination( callbacks, index, file_path, size );
+        if ( !destination )
+        {
+            callbacks.loaded( index, tl::make_unexpected( std::move( destination ).error( ) ) );
+            continue;
+        }
+        jobs.push_back( { .index = index, .destination = destination->first( size ) } );
+    }
+
+    if ( jobs.empty( ) )
+    {
+        return;
+    }
+
+    auto const read_file = [ this, file_paths ]( Job const& job ) -> Result< void > {
+        auto const& file_path = file_paths[ job.index ];
+
+#ifdef LTB_BATCH_FILE_LOADER_HAS_PREAD
+        auto file = -1;
+        LTB_CHECK( auto const size, open_file( file_path, file ) );
+        auto const close_file = make_guard( [] { }, [ file ] { ::close( file ); } );
+
+        if ( size < job.destination.size( ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+                ErrorCode::Io,
+                "File '{}' shrank from {} to {} bytes while loading",
+                file_path.string( ),
+                job.destination.size( ),
+                size
+            );
+        }
+
+        auto offset = uint64{ 0U };
+        while ( offset < job.destination.size( ) )
+        {
+            auto const chunk = std::min( settings_.chunk_size, job.destination.size( ) - offset );
+            auto const bytes = ::pread(
+                file,
+                job.destination.data( ) + offset,
+                chunk,
+                static_cast< off_t >( offset )
+            );
+            if ( bytes < 0 )
+            {
+                if ( EINTR == errno )
+                {
+                    continue;
+                }
+                return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+                    ErrorCode::Io,
+                    "Failed to read file '{}': {}",
+                    file_path.string( ),
+                    std::strerror( errno )
+                );
+            }
+            if ( 0 == bytes )
+            {
+                return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+                    ErrorCode::Io,
+                    "File '{}' ended after {} of {} bytes",
+                    file_path.string( ),
+                    offset,
+                    job.destination.size( )
+                );
+            }
+            offset += static_cast< uint64 >( bytes );
+        }
+#else
+        auto file = std::ifstream( file_path, std::ios::binary );
+        if ( !file.is_open( ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+                ErrorCode::Io,
+                "Failed to open file '{}'",
+                file_path.string( )
+            );
+        }
+        file.read(
+            reinterpret_cast< char* >( job.destination.data( ) ),
+            static_cast< std::streamsize >( job.destination.size( ) )
+        );
+        if ( static_cast< uint64 >( file.gcount( ) ) != job.destination.size( ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+                ErrorCode::Io,
+                "File '{}' ended after {} of {} bytes",
+                file_path.string( ),
+                file.gcount( ),
+                job.destination.size( )
+            );
+        }
+#endif
+
+        return success( );
+    };
+
+    auto next_job    = std::atomic< std::size_t >{ 0UZ };
+    auto mutex       = std::mutex{ };
+    auto finished    = std::condition_variable{ };
+    auto completions = std::vector< Completion >{ };
+
+    if ( nullptr == pool_ )
+    {
+        auto const thread_count = ( 0U != settings_.thread_count )
+                                    ? settings_.thread_count
+                                    : std::thread::hardware_concurrency( );
+        pool_ = std::make_unique< ThreadPool >( std::max( thread_count, 1U ) );
+    }
+
+    // Each task takes jobs until none are left, so no more tasks than jobs are needed.
+    auto const task_count = std::min( pool_->workers.size( ), jobs.size( ) );
+    auto       running    = task_count;
+    for ( auto i = 0UZ; i < task_count; ++i )
+    {
+        pool_->push( [ & ] {
+            auto job = 0UZ;
+            while ( ( job = next_job.fetch_add( 1UZ, std::memory_order_relaxed ) ) < jobs.size( ) )
+            {
+                auto completion = Completion{
+                    .index  = jobs[ job ].index,
+                    .result = read_file( jobs[ job ] ),
+                };
+                {
+                    auto const lock = std::scoped_lock( mutex );
+                    completions.push_back( std::move( completion ) );
+                }
+                finished.notify_one( );
+            }
+
+            // Notified under the lock, since this load may return and destroy `finished`
+            // as soon as the lock is released.
+            auto const lock = std::scoped_lock( mutex );
+            --running;
+            finished.notify_one( );
+        } );
+    }
+
+    // Report completions as they arrive rather than after every file is read. Tasks refer
+    // to this function's locals, so it only returns once they have all finished.
+    auto ready = std::vector< Completion >{ };
+    auto done  = false;
+    while ( !done )
+    {
+        {
+            auto lock = std::unique_lock( mutex );
+            finished.wait( lock, [ & ] { return !completions.empty( ) || ( 0UZ == running ); } );
+            std::swap( ready, completions );
+
+            // Tasks report every read before finishing, so nothing can arrive after this.
+            done = ( 0UZ == running );
+        }
+        for ( auto& completion : ready )
+        {
+            callbacks.loaded( completion.index, std::move( completion.result ) );
+        }
+        ready.clear( );
+    }
+}
+
+} // namespace ltb::utils
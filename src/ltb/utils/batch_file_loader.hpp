@@ -0,0 +1,104 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "result.hpp"
+#include "types.hpp"
+
+// standard
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+
+namespace ltb::utils
+{
+
+enum class FileLoaderBackend : uint8
+{
+    /// \brief Linux `io_uring`: one thread keeps every read in flight in the kernel.
+    IoUring,
+
+    /// \brief Worker threads calling `pread`. Used where `io_uring` is unavailable.
+    ThreadPool,
+};
+
+struct BatchFileLoaderSettings
+{
+    /// \brief Reads kept in flight at once. Also bounds how many files are open at once.
+    uint32 queue_depth = 64U;
+
+    /// \brief Large files are split into reads of at most this many bytes, so a single
+    ///        file can keep the device busy. Capped at the 4 GiB a single read can request.
+    uint64 chunk_size = 1UZ << 20U;
+
+    /// \brief Workers used by the thread pool backend, started once and kept for the life of
+    ///        the loader. Zero uses one per hardware thread.
+    uint32 thread_count = 0U;
+
+    /// \brief Skip `io_uring` even where it is available.
+    bool force_thread_pool = false;
+};
+
+struct FileLoadCallbacks
+{
+    /// \brief Called with each file's size before it is read. Returns where to read the
+    ///        file to, which must hold at least `size` bytes until `loaded` is called.
+    std::function< std::span< std::byte >( std::size_t index, uint64 size ) > allocate;
+
+    /// \brief Called once per file, when it has been read or has failed.
+    std::function< void( std::size_t index, Result< void > result ) > loaded;
+};
+
+/// \brief Loads many files with many reads in flight, straight into caller-provided memory.
+///
+/// Callbacks are only ever called on the thread that called `load`, so they don't need to
+/// be thread-safe. Files complete in whatever order the device finishes them.
+class BatchFileLoader
+{
+public:
+    explicit BatchFileLoader( BatchFileLoaderSettings settings = { } );
+    ~BatchFileLoader( );
+
+    // No copy or move. The io_uring queues are mapped to this object.
+    BatchFileLoader( BatchFileLoader const& )                        = delete;
+    BatchFileLoader( BatchFileLoader&& ) noexcept                    = delete;
+    auto operator=( BatchFileLoader const& ) -> BatchFileLoader&     = delete;
+    auto operator=( BatchFileLoader&& ) noexcept -> BatchFileLoader& = delete;
+
+    /// \brief Blocks until every file has been loaded or has failed. Errors are reported
+    ///        per file through `callbacks.loaded`, so one bad file doesn't stop the rest.
+    auto load(
+        std::span< std::filesystem::path const > file_paths,
+        FileLoadCallbacks const&                 callbacks
+    ) -> void;
+
+    [[nodiscard( "Const getter" )]] auto backend( ) const -> FileLoaderBackend;
+
+private:
+    struct IoUring;
+    struct ThreadPool;
+
+    BatchFileLoaderSettings settings_;
+
+    /// \brief Null when the thread pool backend is used.
+    std::unique_ptr< IoUring > ring_;
+
+    /// \brief Started by the first load that uses the thread pool backend.
+    std::unique_ptr< ThreadPool > pool_;
+
+    auto load_with_io_uring(
+        std::span< std::filesystem::path const > file_paths,
+        FileLoadCallbacks const&                 callbacks
+    ) -> void;
+
+    auto load_with_thread_pool(
+        std::span< std::filesystem::path const > file_paths,
+        FileLoadCallbacks const&                 callbacks
+    ) -> void;
+};
+
+} // namespace ltb::utils
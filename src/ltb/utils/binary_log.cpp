@@ -0,0 +1,621 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "binary_log.hpp"
+
+#include "lock_free_list.hpp"
+#include "tsc_clock.hpp"
+
+// external
+#ifdef SPDLOG_FMT_EXTERNAL
+#include <fmt/args.h>
+#else
+#include <spdlog/fmt/bundled/args.h>
+#endif
+
+// standard
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ltb::utils
+{
+namespace
+{
+
+constexpr auto file_magic   = std::string_view( "LTBBLOG1" );
+constexpr auto file_version = uint32{ 1U };
+
+enum class FileRecord : uint8
+{
+    Site,
+    Message,
+};
+
+/// \brief Precedes each payload in a thread buffer.
+struct RecordHeader
+{
+    uint32 site_id      = 0U;
+    uint32 payload_size = 0U;
+    int64  timestamp_ns = 0;
+};
+
+auto next_thread_id( ) -> uint64
+{
+    static auto next_id = std::atomic< uint64 >{ 1U };
+    return next_id.fetch_add( 1U, std::memory_order_relaxed );
+}
+
+/// \brief A byte ring written only by its owning thread and read only by the writer,
+///        so the indices are the only synchronization needed.
+struct ThreadBuffer
+{
+    std::array< std::byte, binary_log_bytes_per_thread > bytes = { };
+
+    std::atomic< uint64 > write_index = 0U;
+    std::atomic< uint64 > read_index  = 0U;
+    std::atomic< uint64 > dropped     = 0U;
+
+    uint64 thread_id = next_thread_id( );
+
+    ThreadBuffer* next = nullptr;
+
+    auto copy_in( uint64 const index, void const* const data, uint64 const size ) -> void
+    {
+        auto const offset = index % bytes.size( );
+        auto const first  = std::min( size, bytes.size( ) - offset );
+        std::memcpy( bytes.data( ) + offset, data, first );
+        std::memcpy( bytes.data( ), static_cast< std::byte const* >( data ) + first, size - first );
+    }
+
+    auto copy_out( uint64 const index, void* const data, uint64 const size ) const -> void
+    {
+        auto const offset = index % bytes.size( );
+        auto const first  = std::min( size, bytes.size( ) - offset );
+        std::memcpy( data, bytes.data( ) + offset, first );
+        std::memcpy( static_cast< std::byte* >( data ) + first, bytes.data( ), size - first );
+    }
+};
+
+using ThreadBufferList = LockFreeList< ThreadBuffer >;
+
+struct SiteRegistry
+{
+    std::mutex                    mutex = { };
+    std::vector< BinaryLogSite* > sites = { };
+};
+
+auto buffer_list( ) -> ThreadBufferList&
+{
+    static auto list = ThreadBufferList{ };
+    return list;
+}
+
+auto site_registry( ) -> SiteRegistry&
+{
+    static auto registry = SiteRegistry{ };
+    return registry;
+}
+
+auto local_buffer( ) -> ThreadBuffer&
+{
+    thread_local auto* const buffer = buffer_list( ).push( std::make_unique< ThreadBuffer >( ) );
+    return *buffer;
+}
+
+template < typename T >
+auto write_pod( std::ostream& stream, T const& value ) -> void
+{
+    stream.write( reinterpret_cast< char const* >( &value ), sizeof( T ) );
+}
+
+auto write_string( std::ostream& stream, std::string_view const value ) -> void
+{
+    write_pod( stream, static_cast< uint32 >( value.size( ) ) );
+    stream.write( value.data( ), static_cast< std::streamsize >( value.size( ) ) );
+}
+
+template < typename T >
+auto read_pod( std::istream& stream, T& value ) -> bool
+{
+    return static_cast< bool >(
+        stream.read( reinterpret_cast< char* >( &value ), sizeof( T ) )
+    );
+}
+
+auto read_string( std::istream& stream, std::string& value ) -> bool
+{
+    auto size = uint32{ 0U };
+    if ( !read_pod( stream, size ) )
+    {
+        return false;
+    }
+    value.resize( size );
+    return static_cast< bool >( stream.read( value.data( ), size ) );
+}
+
+/// \brief spdlog stamps messages with system_clock, so TSC timestamps are shifted by
+///        the offset between the clocks when the writer formats them live.
+auto to_log_time( int64 const timestamp_ns, std::chrono::nanoseconds const offset )
+    -> spdlog::log_clock::time_point
+{
+    return spdlog::log_clock::time_point( std::chrono::duration_cast< spdlog::log_clock::duration >(
+        std::chrono::nanoseconds( timestamp_ns ) + offset
+    ) );
+}
+
+} // namespace
+
+auto BinaryLogPayload::bytes( ) const -> std::span< std::byte const >
+{
+    return { bytes_.data( ), size_ };
+}
+
+auto BinaryLogPayload::truncated( ) const -> bool
+{
+    return truncated_;
+}
+
+auto BinaryLogPayload::append_string( std::string_view const value ) -> void
+{
+    constexpr auto header_size = 1U + sizeof( uint32 );
+    if ( truncated_ )
+    {
+        return;
+    }
+    if ( size_ + header_size > capacity )
+    {
+        truncate( );
+        return;
+    }
+
+    auto const kept  = value.substr( 0U, capacity - size_ - header_size );
+    auto const count = static_cast< uint32 >( kept.size( ) );
+
+    bytes_[ size_ ] = static_cast< std::byte >( BinaryLogArgument::String );
+    std::memcpy( bytes_.data( ) + size_ + 1U, &count, sizeof( count ) );
+    std::memcpy( bytes_.data( ) + size_ + header_size, kept.data( ), kept.size( ) );
+    size_ += header_size + kept.size( );
+
+    if ( kept.size( ) < value.size( ) )
+    {
+        truncate( );
+    }
+}
+
+auto BinaryLogPayload::truncate( ) -> void
+{
+    bytes_[ size_ ] = static_cast< std::byte >( BinaryLogArgument::Truncated );
+    size_          += 1U;
+    truncated_      = true;
+}
+
+auto register_binary_log_site( BinaryLogSite& site ) -> uint32
+{
+    auto& registry = site_registry( );
+
+    auto const lock = std::scoped_lock( registry.mutex );
+
+    // Another thread may have registered the site while this one waited.
+    if ( auto const id = site.id.load( std::memory_order_acquire ); 0U != id )
+    {
+        return id;
+    }
+
+    registry.sites.emplace_back( &site );
+    auto const id = static_cast< uint32 >( registry.sites.size( ) );
+    site.id.store( id, std::memory_order_release );
+    return id;
+}
+
+auto push_binary_log_record( uint32 const site_id, std::span< std::byte const > const payload )
+    -> void
+{
+    auto& buffer = local_buffer( );
+
+    auto const header = RecordHeader{
+        .site_id      = site_id,
+        .payload_size = static_cast< uint32 >( payload.size( ) ),
+        .timestamp_ns = TscClock::now( ).time_since_epoch( ).count( ),
+    };
+    auto const record_size = sizeof( header ) + payload.size( );
+
+    auto const write = buffer.write_index.load( std::memory_order_relaxed );
+    if ( ( write - buffer.read_index.load( std::memory_order_acquire ) + record_size )
+         > buffer.bytes.size( ) )
+    {
+        buffer.dropped.fetch_add( 1U, std::memory_order_relaxed );
+        return;
+    }
+
+    buffer.copy_in( write, &header, sizeof( header ) );
+    buffer.copy_in( write + sizeof( header ), payload.data( ), payload.size( ) );
+    buffer.write_index.store( write + record_size, std::memory_order_release );
+}
+
+auto dropped_binary_log_records( ) -> uint64
+{
+    auto total = uint64{ 0U };
+    for ( auto* buffer = buffer_list( ).head( ); nullptr != buffer; buffer = buffer->next )
+    {
+        total += buffer->dropped.load( std::memory_order_relaxed );
+    }
+    return total;
+}
+
+auto format_binary_log_payload(
+    std::string_view const             format,
+    std::span< std::byte const > const payload
+) -> std::string
+{
+    auto arguments = fmt::dynamic_format_arg_store< fmt::format_context >{ };
+
+    auto const read = [ &payload ]( auto& value, uint64 const offset )
+    {
+        std::memcpy( &value, payload.data( ) + offset, sizeof( value ) );
+    };
+
+    auto offset    = 0UZ;
+    auto truncated = false;
+    while ( offset < payload.size( ) )
+    {
+        auto const type = static_cast< BinaryLogArgument >( payload[ offset++ ] );
+        auto const size = ( BinaryLogArgument::Bool == type ) ? 1UZ : 8UZ;
+
+        if ( BinaryLogArgument::Truncated == type )
+        {
+            truncated = true;
+            break;
+        }
+
+        if ( BinaryLogArgument::String == type )
+        {
+            auto count = uint32{ 0U };
+            if ( offset + sizeof( count ) > payload.size( ) )
+            {
+                truncated = true;
+                break;
+            }
+            read( count, offset );
+            offset += sizeof( count );
+
+            count = static_cast< uint32 >( std::min< uint64 >( count, payload.size( ) - offset ) );
+            arguments.push_back(
+                std::string( reinterpret_cast< char const* >( payload.data( ) + offset ), count )
+            );
+            offset += count;
+            continue;
+        }
+
+        if ( offset + size > payload.size( ) )
+        {
+            truncated = true;
+            break;
+        }
+
+        switch ( type )
+        {
+            case BinaryLogArgument::Int64:
+            {
+                auto value = int64{ 0 };
+                read( value, offset );
+                arguments.push_back( value );
+                break;
+            }
+            case BinaryLogArgument::UInt64:
+            {
+                auto value = uint64{ 0U };
+                read( value, offset );
+                arguments.push_back( value );
+                break;
+            }
+            case BinaryLogArgument::Float64:
+            {
+                auto value = float64{ 0.0 };
+                read( value, offset );
+                arguments.push_back( value );
+                break;
+            }
+            case BinaryLogArgument::Bool:
+            {
+                arguments.push_back( std::to_integer< uint8 >( payload[ offset ] ) != 0U );
+                break;
+            }
+            case BinaryLogArgument::String:
+            case BinaryLogArgument::Truncated:
+                break;
+            default:
+                return fmt::format( "{} <unknown argument type>", format );
+        }
+        offset += size;
+    }
+
+    try
+    {
+        auto text = fmt::vformat( format, arguments );
+        if ( truncated )
+        {
+            text += " <arguments truncated>";
+        }
+        return text;
+    }
+    catch ( fmt::format_error const& error )
+    {
+        return fmt::format(
+            "{} <{}{}>",
+            format,
+            error.what( ),
+            truncated ? ", arguments truncated" : ""
+        );
+    }
+}
+
+BinaryLogWriter::BinaryLogWriter( BinaryLogWriterSettings settings )
+    : settings_( std::move( settings ) )
+{
+}
+
+BinaryLogWriter::~BinaryLogWriter( )
+{
+    stop( );
+}
+
+auto BinaryLogWriter::start( ) -> utils::Result< void >
+{
+    if ( is_running( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::InvalidState,
+            "Binary log writer is already running"
+        );
+    }
+
+    if ( !settings_.file.empty( ) )
+    {
+        file_ = std::ofstream( settings_.file, std::ios::binary );
+        if ( !file_.is_open( ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Failed to open binary log file '{}'",
+                settings_.file.string( )
+            );
+        }
+        file_.write( file_magic.data( ), static_cast< std::streamsize >( file_magic.size( ) ) );
+        write_pod( file_, file_version );
+        sites_written_ = 0U;
+    }
+
+    thread_ = std::jthread( [ this ]( std::stop_token const& stop_token ) { run( stop_token ); } );
+    return utils::success( );
+}
+
+auto BinaryLogWriter::stop( ) -> void
+{
+    if ( thread_.joinable( ) )
+    {
+        thread_.request_stop( );
+        thread_.join( );
+    }
+    if ( file_.is_open( ) )
+    {
+        file_.close( );
+    }
+}
+
+auto BinaryLogWriter::is_running( ) const -> bool
+{
+    return thread_.joinable( );
+}
+
+auto BinaryLogWriter::run( std::stop_token const& stop_token ) -> void
+{
+    while ( !stop_token.stop_requested( ) )
+    {
+        drain( );
+        std::this_thread::sleep_for( settings_.interval );
+    }
+    drain( );
+
+    if ( auto const dropped = dropped_binary_log_records( ); dropped > 0U )
+    {
+        spdlog::warn( "Binary log dropped {} records. Drain more often.", dropped );
+    }
+}
+
+auto BinaryLogWriter::drain( ) -> void
+{
+    auto sites = std::vector< BinaryLogSite* >{ };
+
+    // Records can refer to sites registered after the last sync, so this runs
+    // again whenever an unknown id is seen.
+    auto const sync_sites = [ this, &sites ]
+    {
+        {
+            auto& registry = site_registry( );
+
+            auto const lock = std::scoped_lock( registry.mutex );
+            sites           = registry.sites;
+        }
+
+        if ( file_.is_open( ) )
+        {
+            for ( ; sites_written_ < sites.size( ); ++sites_written_ )
+            {
+                auto const* const site = sites[ sites_written_ ];
+                write_pod( file_, FileRecord::Site );
+                write_pod( file_, sites_written_ + 1U );
+                write_pod( file_, static_cast< uint8 >( site->level ) );
+                write_pod( file_, site->line );
+                write_string( file_, site->format );
+                write_string( file_, site->file );
+            }
+        }
+    };
+    sync_sites( );
+
+    auto const clock_offset = std::chrono::duration_cast< std::chrono::nanoseconds >(
+        spdlog::log_clock::now( ).time_since_epoch( ) - TscClock::now( ).time_since_epoch( )
+    );
+
+    auto payload = std::array< std::byte, binary_log_max_payload_bytes >{ };
+
+    for ( auto* buffer = buffer_list( ).head( ); nullptr != buffer; buffer = buffer->next )
+    {
+        auto       read  = buffer->read_index.load( std::memory_order_relaxed );
+        auto const write = buffer->write_index.load( std::memory_order_acquire );
+
+        while ( read < write )
+        {
+            auto header = RecordHeader{ };
+            buffer->copy_out( read, &header, sizeof( header ) );
+            buffer->copy_out( read + sizeof( header ), payload.data( ), header.payload_size );
+            read += sizeof( header ) + header.payload_size;
+
+            auto const bytes = std::span< std::byte const >( payload.data( ), header.payload_size );
+
+            if ( header.site_id > sites.size( ) )
+            {
+                sync_sites( );
+            }
+
+            if ( file_.is_open( ) )
+            {
+                write_pod( file_, FileRecord::Message );
+                write_pod( file_, header.site_id );
+                write_pod( file_, buffer->thread_id );
+                write_pod( file_, header.timestamp_ns );
+                write_pod( file_, header.payload_size );
+                file_.write(
+                    reinterpret_cast< char const* >( bytes.data( ) ),
+                    static_cast< std::streamsize >( bytes.size( ) )
+                );
+            }
+            else
+            {
+                auto const* const site = sites[ header.site_id - 1U ];
+                spdlog::default_logger_raw( )->log(
+                    to_log_time( header.timestamp_ns, clock_offset ),
+                    spdlog::source_loc{ site->file, static_cast< int >( site->line ), "" },
+                    site->level,
+                    format_binary_log_payload( site->format, bytes )
+                );
+            }
+        }
+        buffer->read_index.store( read, std::memory_order_release );
+    }
+
+    if ( file_.is_open( ) )
+    {
+        file_.flush( );
+    }
+}
+
+auto decode_binary_log_file(
+    std::filesystem::path const& log_file,
+    BinaryLogCallback const&     callback
+) -> utils::Result< void >
+{
+    auto file = std::ifstream( log_file, std::ios::binary );
+    if ( !file.is_open( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Failed to open binary log '{}'", log_file.string( ) );
+    }
+
+    auto magic   = std::string( file_magic.size( ), '\0' );
+    auto version = uint32{ 0U };
+    if ( !file.read( magic.data( ), static_cast< std::streamsize >( magic.size( ) ) )
+         || ( magic != file_magic ) || !read_pod( file, version ) || ( version != file_version ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "'{}' is not a binary log", log_file.string( ) );
+    }
+
+    struct Site
+    {
+        spdlog::level::level_enum level  = spdlog::level::info;
+        uint32                    line   = 0U;
+        std::string               format = "";
+        std::string               file   = "";
+    };
+    auto sites = std::vector< Site >{ };
+
+    auto payload = std::vector< std::byte >{ };
+    auto kind    = FileRecord{ };
+
+    while ( read_pod( file, kind ) )
+    {
+        if ( FileRecord::Site == kind )
+        {
+            auto id    = uint32{ 0U };
+            auto level = uint8{ 0U };
+            auto site  = Site{ };
+            if ( !read_pod( file, id ) || !read_pod( file, level ) || !read_pod( file, site.line )
+                 || !read_string( file, site.format ) || !read_string( file, site.file ) )
+            {
+                return LTB_MAKE_UNEXPECTED_ERROR( "Truncated site in '{}'", log_file.string( ) );
+            }
+            // The writer numbers sites from one in the order it writes them.
+            if ( ( 0U == id ) || ( id > sites.size( ) + 1U ) )
+            {
+                return LTB_MAKE_UNEXPECTED_ERROR(
+                    "Site {} is out of order in '{}'",
+                    id,
+                    log_file.string( )
+                );
+            }
+            site.level = static_cast< spdlog::level::level_enum >( level );
+            if ( id > sites.size( ) )
+            {
+                sites.emplace_back( std::move( site ) );
+            }
+            else
+            {
+                sites[ id - 1U ] = std::move( site );
+            }
+            continue;
+        }
+
+        auto site_id      = uint32{ 0U };
+        auto message      = BinaryLogMessage{ };
+        auto payload_size = uint32{ 0U };
+        if ( !read_pod( file, site_id ) || !read_pod( file, message.thread_id )
+             || !read_pod( file, message.timestamp_ns ) || !read_pod( file, payload_size ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR( "Truncated record in '{}'", log_file.string( ) );
+        }
+        if ( payload_size > binary_log_max_payload_bytes )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Record payload of {} bytes is too large in '{}'",
+                payload_size,
+                log_file.string( )
+            );
+        }
+
+        payload.resize( payload_size );
+        if ( !file.read( reinterpret_cast< char* >( payload.data( ) ), payload_size ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR( "Truncated record in '{}'", log_file.string( ) );
+        }
+        if ( ( 0U == site_id ) || ( site_id > sites.size( ) ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Record refers to unknown site {} in '{}'",
+                site_id,
+                log_file.string( )
+            );
+        }
+
+        auto const& site = sites[ site_id - 1U ];
+        message.level    = site.level;
+        message.file     = site.file;
+        message.line     = site.line;
+        message.text     = format_binary_log_payload( site.format, payload );
+        callback( message );
+    }
+
+    return utils::success( );
+}
+
+} // namespace ltb::utils
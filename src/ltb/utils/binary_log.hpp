@@ -0,0 +1,249 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "duration.hpp"
+#include "result.hpp"
+#include "types.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+namespace ltb::utils
+{
+
+/// \brief A binary log call site. One is created statically per `LTB_BINARY_LOG`.
+///        Only its id and raw argument bytes are written per call; the format string
+///        is written to the log once.
+struct BinaryLogSite
+{
+    spdlog::level::level_enum level  = spdlog::level::info;
+    char const*               format = "";
+    char const*               file   = "";
+    uint32                    line   = 0U;
+
+    /// \brief Assigned on the first call. Zero means unregistered.
+    std::atomic< uint32 > id = 0U;
+};
+
+enum class BinaryLogArgument : uint8
+{
+    Int64,
+    UInt64,
+    Float64,
+    Bool,
+    String,
+
+    /// \brief Ends a payload whose arguments did not all fit.
+    Truncated,
+};
+
+/// \brief Arguments past this many encoded bytes are dropped and strings are cut short.
+///        The payload then ends with a `Truncated` marker.
+constexpr auto binary_log_max_payload_bytes = 256UZ;
+
+/// \brief Records written to a full buffer are dropped and counted.
+constexpr auto binary_log_bytes_per_thread = 1UZ << 16U;
+
+template < typename T >
+concept BinaryLoggable = std::is_arithmetic_v< T > || std::is_enum_v< T >
+                      || std::convertible_to< T const&, std::string_view >;
+
+/// \brief Encodes arguments as a type tag followed by their raw bytes, on the stack.
+class BinaryLogPayload
+{
+public:
+    template < BinaryLoggable T >
+    auto append( T const& value ) -> void
+    {
+        if constexpr ( std::is_same_v< T, bool > )
+        {
+            write_value( BinaryLogArgument::Bool, static_cast< uint8 >( value ) );
+        }
+        else if constexpr ( std::is_enum_v< T > )
+        {
+            append( static_cast< std::underlying_type_t< T > >( value ) );
+        }
+        else if constexpr ( std::is_floating_point_v< T > )
+        {
+            write_value( BinaryLogArgument::Float64, static_cast< float64 >( value ) );
+        }
+        else if constexpr ( std::is_signed_v< T > )
+        {
+            write_value( BinaryLogArgument::Int64, static_cast< int64 >( value ) );
+        }
+        else if constexpr ( std::is_unsigned_v< T > )
+        {
+            write_value( BinaryLogArgument::UInt64, static_cast< uint64 >( value ) );
+        }
+        else
+        {
+            append_string( std::string_view( value ) );
+        }
+    }
+
+    [[nodiscard( "Const getter" )]] auto bytes( ) const -> std::span< std::byte const >;
+
+    /// \brief True once an argument did not fit. Later arguments are dropped.
+    [[nodiscard( "Const getter" )]] auto truncated( ) const -> bool;
+
+private:
+    /// \brief The last byte is kept free for the `Truncated` marker.
+    static constexpr auto capacity = binary_log_max_payload_bytes - 1U;
+
+    /// \brief Only the first `size_` bytes are ever written.
+    std::array< std::byte, binary_log_max_payload_bytes > bytes_;
+    uint64                                                size_      = 0U;
+    bool                                                  truncated_ = false;
+
+    template < typename T >
+    auto write_value( BinaryLogArgument const type, T const value ) -> void
+    {
+        if ( truncated_ )
+        {
+            return;
+        }
+        if ( size_ + 1U + sizeof( T ) > capacity )
+        {
+            truncate( );
+            return;
+        }
+        bytes_[ size_ ] = static_cast< std::byte >( type );
+        std::memcpy( bytes_.data( ) + size_ + 1U, &value, sizeof( T ) );
+        size_ += 1U + sizeof( T );
+    }
+
+    auto append_string( std::string_view value ) -> void;
+
+    /// \brief Ends the payload with the `Truncated` marker.
+    auto truncate( ) -> void;
+};
+
+/// \brief Assigns the site an id and makes it visible to writers. Called once per site.
+auto register_binary_log_site( BinaryLogSite& site ) -> uint32;
+
+/// \brief Copies a record into the calling thread's buffer. Lock-free and allocation-free
+///        except for the first call on each thread.
+auto push_binary_log_record( uint32 site_id, std::span< std::byte const > payload ) -> void;
+
+/// \brief The number of records dropped because a thread's buffer was full.
+auto dropped_binary_log_records( ) -> uint64;
+
+/// \brief Records a call without formatting it. Use `LTB_BINARY_LOG` rather than this
+///        directly. Honors the default spdlog logger's level.
+template < BinaryLoggable... Args >
+auto binary_log( BinaryLogSite& site, Args const&... args ) -> void
+{
+    if ( !spdlog::should_log( site.level ) )
+    {
+        return;
+    }
+
+    auto id = site.id.load( std::memory_order_acquire );
+    if ( 0U == id )
+    {
+        id = register_binary_log_site( site );
+    }
+
+    auto payload = BinaryLogPayload{ };
+    ( payload.append( args ), ... );
+    push_binary_log_record( id, payload.bytes( ) );
+}
+
+/// \brief Formats `format` with arguments decoded from a payload. Malformed or truncated
+///        payloads produce a best-effort message rather than an error, and truncated ones
+///        are marked as such.
+auto format_binary_log_payload( std::string_view format, std::span< std::byte const > payload )
+    -> std::string;
+
+struct BinaryLogWriterSettings
+{
+    /// \brief When set, records are written here for `decode_binary_log_file`. Otherwise
+    ///        they are formatted on the writer thread and sent to the default spdlog logger.
+    std::filesystem::path file = { };
+
+    /// \brief How often thread buffers are drained.
+    Duration interval = duration_millis( 10 );
+};
+
+/// \brief Drains every thread's binary log buffer from a background thread until destroyed.
+class BinaryLogWriter
+{
+public:
+    explicit BinaryLogWriter( BinaryLogWriterSettings settings );
+    ~BinaryLogWriter( );
+
+    // No copy or move. The writer thread refers to this object.
+    BinaryLogWriter( BinaryLogWriter const& )                        = delete;
+    BinaryLogWriter( BinaryLogWriter&& ) noexcept                    = delete;
+    auto operator=( BinaryLogWriter const& ) -> BinaryLogWriter&     = delete;
+    auto operator=( BinaryLogWriter&& ) noexcept -> BinaryLogWriter& = delete;
+
+    auto start( ) -> utils::Result< void >;
+
+    /// \brief Drains anything left in the buffers, then stops the writer thread.
+    auto stop( ) -> void;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_running( ) const -> bool;
+
+private:
+    BinaryLogWriterSettings settings_;
+
+    std::ofstream file_          = { };
+    uint32        sites_written_ = 0U;
+    std::jthread  thread_        = { };
+
+    auto run( std::stop_token const& stop_token ) -> void;
+    auto drain( ) -> void;
+};
+
+struct BinaryLogMessage
+{
+    spdlog::level::level_enum level        = spdlog::level::info;
+    std::string_view          file         = "";
+    uint32                    line         = 0U;
+    uint64                    thread_id    = 0U;
+    int64                     timestamp_ns = 0;
+    std::string               text         = "";
+};
+
+using BinaryLogCallback = std::function< void( BinaryLogMessage const& ) >;
+
+/// \brief Reads a file written by `BinaryLogWriter` and formats every record in order.
+///        Timestamps are `TscClock` nanoseconds.
+auto decode_binary_log_file(
+    std::filesystem::path const& log_file,
+    BinaryLogCallback const&     callback
+) -> utils::Result< void >;
+
+} // namespace ltb::utils
+
+/// \brief Records `format` and its arguments for formatting later, off the calling thread.
+///        Arguments must be arithmetic, enums or convertible to `std::string_view`.
+#define LTB_BINARY_LOG( level, format, ... )                                                       \
+    do                                                                                             \
+    {                                                                                              \
+        static auto ltb_binary_log_site                                                            \
+            = ::ltb::utils::BinaryLogSite{ level, format, __FILE__, __LINE__ };                    \
+        ::ltb::utils::binary_log( ltb_binary_log_site __VA_OPT__(, ) __VA_ARGS__ );                \
+    } while ( false )
+
+#define LTB_BINARY_LOG_TRACE( ... ) LTB_BINARY_LOG( ::spdlog::level::trace, __VA_ARGS__ )
+#define LTB_BINARY_LOG_DEBUG( ... ) LTB_BINARY_LOG( ::spdlog::level::debug, __VA_ARGS__ )
+#define LTB_BINARY_LOG_INFO( ... ) LTB_BINARY_LOG( ::spdlog::level::info, __VA_ARGS__ )
@@ -0,0 +1,274 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "chunked_file_reader.hpp"
+
+// standard
+#include <algorithm>
+#include <utility>
+
+namespace ltb::utils
+{
+
+FileChunk::~FileChunk( )
+{
+    release( );
+}
+
+FileChunk::FileChunk( FileChunk&& other ) noexcept
+    : reader_( std::exchange( other.reader_, nullptr ) )
+    , index_( other.index_ )
+    , offset_( other.offset_ )
+    , bytes_( std::exchange( other.bytes_, { } ) )
+{
+}
+
+auto FileChunk::operator=( FileChunk&& other ) noexcept -> FileChunk&
+{
+    if ( this != &other )
+    {
+        release( );
+        reader_ = std::exchange( other.reader_, nullptr );
+        index_  = other.index_;
+        offset_ = other.offset_;
+        bytes_  = std::exchange( other.bytes_, { } );
+    }
+    return *this;
+}
+
+auto FileChunk::offset( ) const -> uint64
+{
+    return offset_;
+}
+
+auto FileChunk::bytes( ) const -> std::span< std::byte const >
+{
+    return bytes_;
+}
+
+auto FileChunk::release( ) -> void
+{
+    if ( nullptr != reader_ )
+    {
+        std::exchange( reader_, nullptr )->release( index_ );
+        bytes_ = { };
+    }
+}
+
+ChunkedFileReader::ChunkedFileReader( ChunkedFileReaderSettings settings )
+    : settings_( std::move( settings ) )
+{
+}
+
+ChunkedFileReader::~ChunkedFileReader( )
+{
+    close( );
+}
+
+auto ChunkedFileReader::open( std::filesystem::path const& file_path ) -> Result< void >
+{
+    close( );
+
+    if ( ( 0U == settings_.chunk_size )
+         || ( ( settings_.max_buffered_bytes / settings_.chunk_size ) < 2U ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::InvalidArgument,
+            "A {} byte memory ceiling can't double buffer {} byte chunks",
+            settings_.max_buffered_bytes,
+            settings_.chunk_size
+        );
+    }
+
+    file_ = std::ifstream( file_path, std::ios::ate | std::ios::binary );
+    if ( !file_.is_open( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::Io,
+            "Failed to open file '{}'",
+            file_path.string( )
+        );
+    }
+
+    file_path_   = file_path;
+    size_        = static_cast< uint64 >( file_.tellg( ) );
+    chunk_count_ = ( size_ + settings_.chunk_size - 1U ) / settings_.chunk_size;
+    file_.seekg( 0 );
+
+    // Small files don't need every buffer the ceiling allows, or full-sized ones.
+    auto const buffer_count
+        = std::min( settings_.max_buffered_bytes / settings_.chunk_size, chunk_count_ );
+    auto const buffer_size = std::min( settings_.chunk_size, size_ );
+
+    buffers_.assign( buffer_count, std::vector< std::byte >( buffer_size ) );
+    states_.assign( buffer_count, BufferState::Free );
+
+    thread_ = std::jthread( [ this ]( std::stop_token const& stop_token ) {
+        read_ahead( stop_token );
+    } );
+    return success( );
+}
+
+auto ChunkedFileReader::close( ) -> void
+{
+    if ( thread_.joinable( ) )
+    {
+        thread_.request_stop( );
+        thread_.join( );
+    }
+    if ( file_.is_open( ) )
+    {
+        file_.close( );
+    }
+
+    file_path_.clear( );
+    size_        = 0U;
+    chunk_count_ = 0U;
+    buffers_.clear( );
+
+    // Chunks released after this see no states and leave them alone.
+    auto const lock = std::scoped_lock( mutex_ );
+    states_.clear( );
+    next_chunk_ = 0U;
+    error_.reset( );
+    error_chunk_ = 0U;
+}
+
+auto ChunkedFileReader::next( ) -> Result< std::optional< FileChunk > >
+{
+    if ( !is_open( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::InvalidState,
+            "No file is open for reading"
+        );
+    }
+
+    auto lock = std::unique_lock( mutex_ );
+
+    auto const index = next_chunk_;
+    if ( index == chunk_count_ )
+    {
+        return std::nullopt;
+    }
+
+    auto const buffer = index % buffers_.size( );
+    if ( BufferState::InUse == states_[ buffer ] )
+    {
+        // The reader can't refill the buffer this chunk needs until the caller lets go
+        // of it, so waiting here would never return.
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::InvalidState,
+            "All {} chunk buffers of '{}' are held. Release a chunk before reading another",
+            buffers_.size( ),
+            file_path_.string( )
+        );
+    }
+
+    changed_.wait( lock, [ this, index, buffer ] {
+        return ( BufferState::Ready == states_[ buffer ] )
+            || ( error_.has_value( ) && ( index == error_chunk_ ) );
+    } );
+
+    if ( BufferState::Ready != states_[ buffer ] )
+    {
+        // Nothing after the failed chunk was read, so the reader is finished.
+        next_chunk_ = chunk_count_;
+        return tl::make_unexpected( *std::exchange( error_, std::nullopt ) );
+    }
+
+    states_[ buffer ] = BufferState::InUse;
+    ++next_chunk_;
+
+    auto chunk    = FileChunk{ };
+    chunk.reader_ = this;
+    chunk.index_  = index;
+    chunk.offset_ = index * settings_.chunk_size;
+    chunk.bytes_  = std::span( buffers_[ buffer ] )
+                       .first( std::min( settings_.chunk_size, size_ - chunk.offset_ ) );
+    return chunk;
+}
+
+auto ChunkedFileReader::is_open( ) const -> bool
+{
+    return thread_.joinable( );
+}
+
+auto ChunkedFileReader::size( ) const -> uint64
+{
+    return size_;
+}
+
+auto ChunkedFileReader::settings( ) const -> ChunkedFileReaderSettings const&
+{
+    return settings_;
+}
+
+auto ChunkedFileReader::read_ahead( std::stop_token const& stop_token ) -> void
+{
+    for ( auto index = uint64{ 0U }; index < chunk_count_; ++index )
+    {
+        auto const buffer = index % buffers_.size( );
+        {
+            auto lock = std::unique_lock( mutex_ );
+            if ( !changed_.wait( lock, stop_token, [ this, buffer ] {
+                     return BufferState::Free == states_[ buffer ];
+                 } ) )
+            {
+                return;
+            }
+        }
+
+        // The buffer is free, so nothing else touches it until it is marked ready.
+        auto const offset = index * settings_.chunk_size;
+        auto const size   = std::min( settings_.chunk_size, size_ - offset );
+        file_.read(
+            reinterpret_cast< char* >( buffers_[ buffer ].data( ) ),
+            static_cast< std::streamsize >( size )
+        );
+        auto const read_size = static_cast< uint64 >( file_.gcount( ) );
+
+        {
+            auto const lock = std::scoped_lock( mutex_ );
+            if ( read_size == size )
+            {
+                states_[ buffer ] = BufferState::Ready;
+            }
+            else
+            {
+                error_ = LTB_MAKE_ERROR_WITH_CODE(
+                    ErrorCode::Io,
+                    "Read {} of {} bytes at offset {} of file '{}'",
+                    read_size,
+                    size,
+                    offset,
+                    file_path_.string( )
+                );
+                error_chunk_ = index;
+            }
+        }
+        changed_.notify_all( );
+
+        if ( read_size != size )
+        {
+            return;
+        }
+    }
+}
+
+auto ChunkedFileReader::release( uint64 const chunk_index ) -> void
+{
+    {
+        auto const lock = std::scoped_lock( mutex_ );
+
+        // The reader was closed while the chunk was held, so its buffer is already gone.
+        if ( states_.empty( ) )
+        {
+            return;
+        }
+        states_[ chunk_index % states_.size( ) ] = BufferState::Free;
+    }
+    changed_.notify_all( );
+}
+
+} // namespace ltb::utils
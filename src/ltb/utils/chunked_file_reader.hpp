@@ -0,0 +1,151 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "error.hpp"
+#include "result.hpp"
+#include "types.hpp"
+
+// standard
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace ltb::utils
+{
+
+class ChunkedFileReader;
+
+struct ChunkedFileReaderSettings
+{
+    /// \brief Bytes per chunk. Every chunk but the last is exactly this size.
+    uint64 chunk_size = 4UZ << 20U;
+
+    /// \brief The most memory the reader ever holds. It is split into
+    ///        `max_buffered_bytes / chunk_size` buffers, which must be at least two so one
+    ///        chunk can be read while another is processed.
+    uint64 max_buffered_bytes = 32UZ << 20U;
+};
+
+/// \brief One chunk of a file, borrowed from a `ChunkedFileReader`. Its buffer is handed
+///        back for the reader to refill when the chunk is destroyed, so hold on to chunks
+///        only as long as they are needed.
+class FileChunk
+{
+public:
+    FileChunk( ) = default;
+    ~FileChunk( );
+
+    // No copy. Moving transfers the borrowed buffer.
+    FileChunk( FileChunk const& )                    = delete;
+    auto operator=( FileChunk const& ) -> FileChunk& = delete;
+    FileChunk( FileChunk&& other ) noexcept;
+    auto operator=( FileChunk&& other ) noexcept -> FileChunk&;
+
+    /// \brief Where this chunk starts in the file.
+    [[nodiscard( "Const getter" )]] auto offset( ) const -> uint64;
+    [[nodiscard( "Const getter" )]] auto bytes( ) const -> std::span< std::byte const >;
+
+    /// \brief Returns the buffer to the reader early.
+    auto release( ) -> void;
+
+private:
+    ChunkedFileReader*           reader_ = nullptr;
+    uint64                       index_  = 0U;
+    uint64                       offset_ = 0U;
+    std::span< std::byte const > bytes_  = { };
+
+    friend class ChunkedFileReader;
+};
+
+/// \brief Streams a file in fixed-size chunks without ever holding more than
+///        `max_buffered_bytes` of it, for files too large to load whole.
+///
+/// A background thread reads ahead into every free buffer while the caller processes
+/// earlier chunks. Once all buffers are full it waits for the caller to release one, so a
+/// slow consumer holds the reader back instead of memory growing.
+///
+/// \code
+/// auto reader = utils::ChunkedFileReader{ };
+/// LTB_CHECK( reader.open( "points.bin" ) );
+/// while ( true )
+/// {
+///     LTB_CHECK( auto chunk, reader.next( ) );
+///     if ( !chunk ) { break; }
+///     process( chunk->bytes( ) );
+/// }
+/// \endcode
+class ChunkedFileReader
+{
+public:
+    explicit ChunkedFileReader( ChunkedFileReaderSettings settings = { } );
+    ~ChunkedFileReader( );
+
+    // No copy or move. The read-ahead thread and outstanding chunks refer to this object.
+    ChunkedFileReader( ChunkedFileReader const& )                        = delete;
+    ChunkedFileReader( ChunkedFileReader&& ) noexcept                    = delete;
+    auto operator=( ChunkedFileReader const& ) -> ChunkedFileReader&     = delete;
+    auto operator=( ChunkedFileReader&& ) noexcept -> ChunkedFileReader& = delete;
+
+    /// \brief Opens a file and starts reading ahead. Closes any file already open.
+    auto open( std::filesystem::path const& file_path ) -> Result< void >;
+
+    /// \brief Stops reading ahead and closes the file. Every chunk from the file must be
+    ///        destroyed or released first.
+    auto close( ) -> void;
+
+    /// \brief Blocks until the next chunk has been read. Returns no chunk at the end of the
+    ///        file. A read error is returned once every chunk before it has been returned,
+    ///        after which the reader is finished and returns no more chunks.
+    auto next( ) -> Result< std::optional< FileChunk > >;
+
+    [[nodiscard( "Const getter" )]] auto is_open( ) const -> bool;
+
+    /// \brief The size of the open file in bytes.
+    [[nodiscard( "Const getter" )]] auto size( ) const -> uint64;
+
+    [[nodiscard( "Const getter" )]] auto settings( ) const -> ChunkedFileReaderSettings const&;
+
+private:
+    enum class BufferState : uint8
+    {
+        Free,
+        Ready,
+        InUse,
+    };
+
+    ChunkedFileReaderSettings settings_;
+
+    std::filesystem::path file_path_   = { };
+    uint64                size_        = 0U;
+    uint64                chunk_count_ = 0U;
+
+    /// \brief Chunk `i` is read into buffer `i % buffers_.size( )`.
+    std::vector< std::vector< std::byte > > buffers_ = { };
+
+    /// \brief Only touched by the read-ahead thread while it runs.
+    std::ifstream file_ = { };
+
+    std::mutex                  mutex_       = { };
+    std::condition_variable_any changed_     = { };
+    std::vector< BufferState >  states_      = { };
+    uint64                      next_chunk_  = 0U;
+    std::optional< Error >      error_       = std::nullopt;
+    uint64                      error_chunk_ = 0U;
+    std::jthread                thread_      = { };
+
+    auto read_ahead( std::stop_token const& stop_token ) -> void;
+    auto release( uint64 chunk_index ) -> void;
+
+    friend class FileChunk;
+};
+
+} // namespace ltb::utils
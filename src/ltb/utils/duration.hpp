@@ -10,11 +10,14 @@ namespace ltb::utils
 
 using Duration = std::chrono::steady_clock::duration;
 
+// The `to_*` helpers accept any clock's duration, for example `TscClock::duration`.
+
 namespace detail
 {
 
-template < typename IntegralType, typename PeriodType >
-constexpr auto time_to_integral( Duration const& duration ) -> IntegralType
+template < typename IntegralType, typename PeriodType, typename Rep, typename Period >
+constexpr auto time_to_integral( std::chrono::duration< Rep, Period > const& duration )
+    -> IntegralType
 {
     using DurationType = std::chrono::duration< IntegralType, typename PeriodType::period >;
     return std::chrono::duration_cast< DurationType >( duration ).count( );
@@ -29,38 +32,38 @@ constexpr auto time_from_integral( IntegralType value ) -> Duration
 
 } // namespace detail
 
-template < typename TargetType = float >
-constexpr auto to_hours( Duration const& duration ) -> TargetType
+template < typename TargetType = float, typename Rep, typename Period >
+constexpr auto to_hours( std::chrono::duration< Rep, Period > const& duration ) -> TargetType
 {
     return detail::time_to_integral< TargetType, std::chrono::hours >( duration );
 }
 
-template < typename TargetType = float >
-constexpr auto to_minutes( Duration const& duration ) -> TargetType
+template < typename TargetType = float, typename Rep, typename Period >
+constexpr auto to_minutes( std::chrono::duration< Rep, Period > const& duration ) -> TargetType
 {
     return detail::time_to_integral< TargetType, std::chrono::minutes >( duration );
 }
 
-template < typename TargetType = float >
-constexpr auto to_seconds( Duration const& duration ) -> TargetType
+template < typename TargetType = float, typename Rep, typename Period >
+constexpr auto to_seconds( std::chrono::duration< Rep, Period > const& duration ) -> TargetType
 {
     return detail::time_to_integral< TargetType, std::chrono::seconds >( duration );
 }
 
-template < typename TargetType = float >
-constexpr auto to_millis( Duration const& duration ) -> TargetType
+template < typename TargetType = float, typename Rep, typename Period >
+constexpr auto to_millis( std::chrono::duration< Rep, Period > const& duration ) -> TargetType
 {
     return detail::time_to_integral< TargetType, std::chrono::milliseconds >( duration );
 }
 
-template < typename TargetType = float >
-constexpr auto to_micros( Duration const& duration ) -> TargetType
+template < typename TargetType = float, typename Rep, typename Period >
+constexpr auto to_micros( std::chrono::duration< Rep, Period > const& duration ) -> TargetType
 {
     return detail::time_to_integral< TargetType, std::chrono::microseconds >( duration );
 }
 
-template < typename TargetType = float >
-constexpr auto to_nanos( Duration const& duration ) -> TargetType
+template < typename TargetType = float, typename Rep, typename Period >
+constexpr auto to_nanos( std::chrono::duration< Rep, Period > const& duration ) -> TargetType
 {
     return detail::time_to_integral< TargetType, std::chrono::nanoseconds >( duration );
 }
@@ -3,60 +3,61 @@
 // ///////////////////////////////////////////////////////////////////////////////////////
 #include "error.hpp"
 
+// external
+#include <magic_enum.hpp>
+
+// standard
+#include <iterator>
+
 namespace ltb::utils
 {
 
-SourceLocation::SourceLocation( std::filesystem::path file, int line )
-    : filename( std::move( file ) )
-    , line_number( line )
+auto to_string( ErrorCode const code ) -> std::string_view
 {
+    return magic_enum::enum_name( code );
 }
 
-namespace
-{
-
-///
-/// \brief Prepend the file and line number to the message if they were specified.
-///
-auto create_debug_message( SourceLocation const& source_location, std::string const& error_message )
-    -> std::string
+auto Error::severity( ) const -> Error::Severity const&
 {
-    std::string result = "[" + source_location.filename.string( );
-
-    if ( source_location.line_number >= 0 )
-    {
-        result += ':' + std::to_string( source_location.line_number );
-    }
-
-    result += "] " + error_message;
-    return result;
+    return severity_;
 }
 
-} // namespace
-
-Error::~Error( ) = default;
-
-Error::Error( SourceLocation source_location, Severity severity, std::string error_message )
-    : source_location_( std::move( source_location ) )
-    , severity_( severity )
-    , error_message_( std::move( error_message ) )
-    , debug_message_( create_debug_message( source_location_, error_message_ ) )
+auto Error::code( ) const -> ErrorCode
 {
+    return code_;
 }
 
-auto Error::severity( ) const -> Error::Severity const&
+auto Error::error_message( ) const -> std::string_view
 {
-    return severity_;
+    if ( heap_message_.empty( ) )
+    {
+        return { inline_message_.data( ), inline_size_ };
+    }
+    return heap_message_;
 }
 
-auto Error::error_message( ) const -> std::string const&
+auto Error::debug_error_message( ) const -> std::string
 {
-    return error_message_;
+    auto message = fmt::memory_buffer{ };
+    append_debug_error_message( message );
+    return fmt::to_string( message );
 }
 
-auto Error::debug_error_message( ) const -> std::string const&
+auto Error::append_debug_error_message( fmt::memory_buffer& buffer ) const -> void
 {
-    return debug_message_;
+    // Prepend the file and line number to the message if they were specified.
+    fmt::format_to( std::back_inserter( buffer ), "[{}", source_location_.filename );
+    if ( source_location_.line_number >= 0 )
+    {
+        fmt::format_to( std::back_inserter( buffer ), ":{}", source_location_.line_number );
+    }
+    fmt::format_to( std::back_inserter( buffer ), "] " );
+
+    if ( ErrorCode::Unknown != code_ )
+    {
+        fmt::format_to( std::back_inserter( buffer ), "{}: ", to_string( code_ ) );
+    }
+    fmt::format_to( std::back_inserter( buffer ), "{}", error_message( ) );
 }
 
 auto Error::source_location( ) const -> SourceLocation const&
@@ -64,14 +65,26 @@ auto Error::source_location( ) const -> SourceLocation const&
     return source_location_;
 }
 
-auto Error::append_message( Error const& error, std::string const& message ) -> Error
+auto Error::append_message( Error const& error, std::string_view const message ) -> Error
 {
-    return Error( error.source_location_, error.severity_, error.error_message_ + " " + message );
+    return Error(
+        error.source_location_,
+        error.severity_,
+        error.code_,
+        "{} {}",
+        error.error_message( ),
+        message
+    );
 }
 
 auto Error::operator==( Error const& other ) const -> bool
 {
-    return debug_message_ == other.debug_message_;
+    // The code is compared first so errors of different kinds rarely reach the strings.
+    return ( code_ == other.code_ )
+        && ( std::string_view( source_location_.filename )
+             == std::string_view( other.source_location_.filename ) )
+        && ( source_location_.line_number == other.source_location_.line_number )
+        && ( error_message( ) == other.error_message( ) );
 }
 
 auto Error::operator!=( Error const& other ) const -> bool
@@ -3,12 +3,19 @@
 // ///////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+// project
+#include "types.hpp"
+
 // external
 #include <spdlog/fmt/fmt.h>
 
 // standard
-#include <filesystem>
+#include <array>
+#include <limits>
+#include <source_location>
 #include <string>
+#include <string_view>
+#include <utility>
 
 ///\brief Macro used to auto-fill line and file information when creating an error.
 ///
@@ -20,47 +27,113 @@
     ::ltb::utils::Error(                                                                           \
         { __FILE__, __LINE__ },                                                                    \
         ::ltb::utils::Error::Severity::Error,                                                      \
-        fmt::format( __VA_ARGS__ )                                                                 \
+        __VA_ARGS__                                                                                \
     )
 
 ///\brief Macro used to auto-fill line and file information when creating a warning.
 /// \code
-/// ltb::utils::Error error = ROTOR_MAKE_WARNING("Not so bad thing happened!");
+/// ltb::utils::Error error = LTB_MAKE_WARNING("Not so bad thing happened!");
 /// assert(error.severity() == ltb::utils::Error::Severity::Warning);
 /// \endcode
 #define LTB_MAKE_WARNING( ... )                                                                    \
     ::ltb::utils::Error(                                                                           \
         { __FILE__, __LINE__ },                                                                    \
         ::ltb::utils::Error::Severity::Warning,                                                    \
-        ,                                                                                          \
-        fmt::format( __VA_ARGS__ )                                                                 \
+        __VA_ARGS__                                                                                \
+    )
+
+///\brief Macro used to auto-fill line and file information when creating an error that
+///        callers can classify by `code` rather than by message.
+/// \code
+/// ltb::utils::Error error = LTB_MAKE_ERROR_WITH_CODE(ltb::utils::ErrorCode::CacheMiss, "...");
+/// assert(error.code() == ltb::utils::ErrorCode::CacheMiss);
+/// \endcode
+#define LTB_MAKE_ERROR_WITH_CODE( code, ... )                                                      \
+    ::ltb::utils::Error(                                                                           \
+        { __FILE__, __LINE__ },                                                                    \
+        ::ltb::utils::Error::Severity::Error,                                                      \
+        code,                                                                                      \
+        __VA_ARGS__                                                                                \
     )
 
 namespace ltb::utils
 {
 
+/// \brief Classifies an error so callers can choose a fallback with an integer compare
+///        instead of inspecting the message.
+enum class ErrorCode : uint8
+{
+    Unknown,
+    InvalidArgument,
+    InvalidState,
+    InvalidData,
+    NotFound,
+    CacheMiss,
+    Unsupported,
+    Io,
+    OutOfMemory,
+    DeviceLost,
+};
+
+auto to_string( ErrorCode code ) -> std::string_view;
+
+/// \brief Where an error was created. `filename` is not copied, so it must have static
+///        storage duration, like `__FILE__` or `std::source_location::file_name()`.
 struct SourceLocation
 {
-    std::filesystem::path filename;
-    int                   line_number;
+    char const* filename;
+    int         line_number;
 
     SourceLocation( ) = delete;
-    SourceLocation( std::filesystem::path file, int line );
+    constexpr SourceLocation( char const* const file, int const line )
+        : filename( file )
+        , line_number( line )
+    {
+    }
+    constexpr explicit SourceLocation( std::source_location const& location )
+        : SourceLocation( location.file_name( ), static_cast< int >( location.line( ) ) )
+    {
+    }
 };
 
 ///\brief A simple class used to pass error messages around.
+///
+/// Errors are created on expected failure paths inside loops, so creating, copying and
+/// propagating one does not allocate unless the message outgrows the inline buffer. The
+/// message is formatted once and the debug message is only built when it is requested.
 class Error
 {
 public:
-    enum class Severity
+    enum class Severity : uint8
     {
         Error,
         Warning,
     };
 
+    /// \brief Messages up to this many characters are stored without allocating.
+    static constexpr auto inline_message_capacity = 71UZ;
+
     Error( ) = delete;
-    explicit Error( SourceLocation source_location, Severity severity, std::string error_message );
-    virtual ~Error( );
+
+    template < typename... Args >
+    explicit Error(
+        SourceLocation const                source_location,
+        Severity const                      severity,
+        fmt::format_string< Args... > const format,
+        Args&&... args
+    );
+
+    template < typename... Args >
+    explicit Error(
+        SourceLocation const                source_location,
+        Severity const                      severity,
+        ErrorCode const                     code,
+        fmt::format_string< Args... > const format,
+        Args&&... args
+    );
+
+    // Inline, so the moved-from errors left behind by propagation are cheap to destroy.
+    ~Error( ) = default;
 
     // default copy
     Error( Error const& )                    = default;
@@ -71,11 +144,22 @@ public:
     auto operator=( Error&& ) noexcept -> Error& = default;
 
     [[nodiscard]] auto severity( ) const -> Severity const&;
-    [[nodiscard]] auto error_message( ) const -> std::string const&;
-    [[nodiscard]] auto debug_error_message( ) const -> std::string const&;
+    [[nodiscard]] auto code( ) const -> ErrorCode;
+
+    /// \brief Null-terminated.
+    [[nodiscard]] auto error_message( ) const -> std::string_view;
+
+    /// \brief "[file:line] error message", or "[file:line] Code: error message" when the
+    ///        error has a code. Formatted on every call.
+    [[nodiscard]] auto debug_error_message( ) const -> std::string;
+
+    /// \brief Appends `debug_error_message( )` to `buffer`, which only allocates when the
+    ///        message outgrows the buffer's inline storage.
+    auto append_debug_error_message( fmt::memory_buffer& buffer ) const -> void;
+
     [[nodiscard]] auto source_location( ) const -> SourceLocation const&;
 
-    static auto append_message( Error const& error, std::string const& message ) -> Error;
+    static auto append_message( Error const& error, std::string_view message ) -> Error;
 
     auto operator==( Error const& other ) const -> bool;
     auto operator!=( Error const& other ) const -> bool;
@@ -83,11 +167,67 @@ public:
 private:
     SourceLocation source_location_; ///< File and line number where error was created
     Severity       severity_; ///< The type of error (warning or error)
-    std::string    error_message_; ///< The error message
-    std::string
-        debug_message_; ///< Error message with file and line number "[file:line] error message"
+    ErrorCode      code_ = ErrorCode::Unknown; ///< What kind of failure this is
+    uint8          inline_size_ = 0U; ///< Characters used in `inline_message_`
+
+    /// \brief The error message when it fits, null-terminated.
+    std::array< char, inline_message_capacity + 1UZ > inline_message_ = { };
+
+    /// \brief The error message when it doesn't fit inline. Empty strings don't allocate.
+    std::string heap_message_ = { };
 };
 
+static_assert( Error::inline_message_capacity <= std::numeric_limits< uint8 >::max( ) );
+
+template < typename... Args >
+Error::Error(
+    SourceLocation const                source_location,
+    Severity const                      severity,
+    fmt::format_string< Args... > const format,
+    Args&&... args
+)
+    : Error(
+          source_location,
+          severity,
+          ErrorCode::Unknown,
+          format,
+          std::forward< Args >( args )...
+      )
+{
+}
+
+template < typename... Args >
+Error::Error(
+    SourceLocation const                source_location,
+    Severity const                      severity,
+    ErrorCode const                     code,
+    fmt::format_string< Args... > const format,
+    Args&&... args
+)
+    : source_location_( source_location )
+    , severity_( severity )
+    , code_( code )
+{
+    auto const format_args = fmt::make_format_args( args... );
+
+    auto const result = fmt::vformat_to_n(
+        inline_message_.data( ),
+        inline_message_capacity,
+        fmt::string_view( format ),
+        format_args
+    );
+    if ( result.size <= inline_message_capacity )
+    {
+        inline_size_                   = static_cast< uint8 >( result.size );
+        inline_message_[ result.size ] = '\0';
+    }
+    else
+    {
+        // Rare: format again into a heap string rather than truncating.
+        heap_message_ = fmt::vformat( fmt::string_view( format ), format_args );
+    }
+}
+
 /// \brief An error with extra data pertaining to a specific type of error.
 template < typename Context >
 struct ContextError
@@ -97,12 +237,14 @@ struct ContextError
 
     [[nodiscard]] auto severity( ) const -> Error::Severity const& { return error.severity( ); }
 
-    [[nodiscard]] auto error_message( ) const -> std::string const&
+    [[nodiscard]] auto code( ) const -> ErrorCode { return error.code( ); }
+
+    [[nodiscard]] auto error_message( ) const -> std::string_view
     {
         return error.error_message( );
     }
 
-    [[nodiscard]] auto debug_error_message( ) const -> std::string const&
+    [[nodiscard]] auto debug_error_message( ) const -> std::string
     {
         return error.debug_error_message( );
     }
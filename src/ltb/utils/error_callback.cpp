@@ -10,14 +10,13 @@ namespace ltb::utils
 
 auto log_error( Error const& error ) -> void
 {
-    if ( error.severity( ) == Error::Severity::Warning )
-    {
-        spdlog::warn( "{}", error.debug_error_message( ) );
-    }
-    else
-    {
-        spdlog::error( "{}", error.debug_error_message( ) );
-    }
+    // Formats into a stack buffer so typical messages are logged without allocating.
+    auto message = fmt::memory_buffer{ };
+    error.append_debug_error_message( message );
+
+    auto const level = ( error.severity( ) == Error::Severity::Warning ) ? spdlog::level::warn
+                                                                         : spdlog::level::err;
+    spdlog::log( level, "{}", std::string_view( message.data( ), message.size( ) ) );
 }
 
 auto invoke_if_non_null( ErrorCallback const& callback, Error error ) -> void
@@ -0,0 +1,149 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "error_collector.hpp"
+
+// standard
+#include <array>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace ltb::utils
+{
+namespace
+{
+
+/// \brief Collectors that a thread reports to at once before it re-registers with one.
+constexpr auto cached_collectors_per_thread = 8UZ;
+
+/// \brief Keeps each thread's counters on their own cache line.
+constexpr auto cache_line_size = 64UZ;
+
+auto next_collector_id( ) -> uint64
+{
+    static auto next_id = std::atomic< uint64 >{ 1U };
+    return next_id.fetch_add( 1U, std::memory_order_relaxed );
+}
+
+} // namespace
+
+/// \brief Written only by its owning thread. `kept` publishes the errors to readers, and
+///        `errors` never reallocates, so readers can copy the first `kept` without locking.
+struct alignas( cache_line_size ) ErrorCollector::ThreadErrors
+{
+    std::vector< Error > errors = { };
+
+    std::atomic< uint64 > kept          = 0U;
+    std::atomic< uint64 > error_count   = 0U;
+    std::atomic< uint64 > warning_count = 0U;
+
+    ThreadErrors* next = nullptr;
+};
+
+ErrorCollector::ErrorCollector( ErrorCollectorSettings settings )
+    : settings_( std::move( settings ) )
+    , id_( next_collector_id( ) )
+{
+}
+
+ErrorCollector::~ErrorCollector( ) = default;
+
+auto ErrorCollector::collect( Error error ) -> void
+{
+    auto& local = local_errors( );
+
+    // Only this thread writes these, so a relaxed load and store is enough.
+    auto& count = ( Error::Severity::Warning == error.severity( ) ) ? local.warning_count
+                                                                     : local.error_count;
+    count.store( count.load( std::memory_order_relaxed ) + 1U, std::memory_order_relaxed );
+
+    auto const kept = local.kept.load( std::memory_order_relaxed );
+    if ( kept < settings_.max_errors_per_thread )
+    {
+        local.errors.emplace_back( std::move( error ) );
+        local.kept.store( kept + 1U, std::memory_order_release );
+    }
+}
+
+auto ErrorCollector::callback( ) -> ErrorCallback
+{
+    return [ this ]( Error error ) { collect( std::move( error ) ); };
+}
+
+auto ErrorCollector::counts( ) const -> ErrorCounts
+{
+    auto counts = ErrorCounts{ };
+    auto kept   = uint64{ 0U };
+
+    for ( auto const* errors = threads_.head( ); nullptr != errors; errors = errors->next )
+    {
+        kept            += errors->kept.load( std::memory_order_acquire );
+        counts.errors   += errors->error_count.load( std::memory_order_relaxed );
+        counts.warnings += errors->warning_count.load( std::memory_order_relaxed );
+    }
+
+    // Counters are read after `kept`, so they are never behind it.
+    counts.dropped = ( counts.errors + counts.warnings ) - kept;
+    return counts;
+}
+
+auto ErrorCollector::has_errors( ) const -> bool
+{
+    for ( auto const* errors = threads_.head( ); nullptr != errors; errors = errors->next )
+    {
+        if ( ( errors->error_count.load( std::memory_order_relaxed ) > 0U )
+             || ( errors->warning_count.load( std::memory_order_relaxed ) > 0U ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto ErrorCollector::errors( ) const -> std::vector< Error >
+{
+    auto merged = std::vector< Error >{ };
+
+    for ( auto const* errors = threads_.head( ); nullptr != errors; errors = errors->next )
+    {
+        auto const  kept  = errors->kept.load( std::memory_order_acquire );
+        auto const* begin = errors->errors.data( );
+        merged.insert( merged.end( ), begin, begin + kept );
+    }
+
+    return merged;
+}
+
+auto ErrorCollector::local_errors( ) -> ThreadErrors&
+{
+    struct CachedCollector
+    {
+        uint64        collector_id = 0U;
+        ThreadErrors* errors       = nullptr;
+    };
+    thread_local auto cache     = std::array< CachedCollector, cached_collectors_per_thread >{ };
+    thread_local auto next_slot = 0UZ;
+
+    for ( auto const& cached : cache )
+    {
+        if ( id_ == cached.collector_id )
+        {
+            return *cached.errors;
+        }
+    }
+
+    // First error from this thread. If the thread's cache evicted this collector, the
+    // thread gets a second buffer, which is merged like any other.
+    auto owned = std::make_unique< ThreadErrors >( );
+    owned->errors.reserve( settings_.max_errors_per_thread );
+
+    auto* const errors = threads_.push( std::move( owned ) );
+
+    cache[ next_slot ] = { .collector_id = id_, .errors = errors };
+    next_slot          = ( next_slot + 1UZ ) % cache.size( );
+
+    return *errors;
+}
+
+} // namespace ltb::utils
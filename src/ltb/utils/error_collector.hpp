@@ -0,0 +1,90 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "error.hpp"
+#include "error_callback.hpp"
+#include "lock_free_list.hpp"
+#include "types.hpp"
+
+// standard
+#include <vector>
+
+namespace ltb::utils
+{
+
+struct ErrorCollectorSettings
+{
+    /// \brief Errors kept per thread. Later errors on that thread are only counted.
+    uint32 max_errors_per_thread = 64U;
+};
+
+struct ErrorCounts
+{
+    uint64 errors   = 0U;
+    uint64 warnings = 0U;
+
+    /// \brief Errors and warnings counted but not kept because a thread reached its cap.
+    uint64 dropped = 0U;
+};
+
+/// \brief Collects errors from many threads at once, for example from a
+///        `std::for_each( std::execution::par, ... )` over thousands of assets.
+///
+/// Each thread appends to its own buffer, so failing tasks never wait on each other or
+/// on a lock. Buffers are merged only when `errors()` or `counts()` is called.
+///
+/// \code
+/// auto collector = utils::ErrorCollector{ };
+/// auto const on_error = collector.callback( );
+/// std::for_each( std::execution::par, assets.begin( ), assets.end( ), [ & ]( auto& asset ) {
+///     LTB_CHECK_OR( validate( asset ), on_error );
+/// } );
+/// for ( auto const& error : collector.errors( ) ) { utils::log_error( error ); }
+/// \endcode
+class ErrorCollector
+{
+public:
+    explicit ErrorCollector( ErrorCollectorSettings settings = { } );
+    ~ErrorCollector( );
+
+    // No copy or move. Threads keep pointers to their buffers in this collector.
+    ErrorCollector( ErrorCollector const& )                        = delete;
+    ErrorCollector( ErrorCollector&& ) noexcept                    = delete;
+    auto operator=( ErrorCollector const& ) -> ErrorCollector&     = delete;
+    auto operator=( ErrorCollector&& ) noexcept -> ErrorCollector& = delete;
+
+    /// \brief Thread-safe and lock-free. Allocates only on a thread's first error.
+    auto collect( Error error ) -> void;
+
+    /// \brief A callback for `invoke_if_non_null` and the `LTB_CHECK_OR` macros. It
+    ///        refers to this collector, so it must not outlive it.
+    [[nodiscard]] auto callback( ) -> ErrorCallback;
+
+    /// \brief Safe to call while other threads are collecting.
+    [[nodiscard( "Const getter" )]] auto counts( ) const -> ErrorCounts;
+
+    /// \brief Safe to call while other threads are collecting.
+    [[nodiscard( "Const getter" )]] auto has_errors( ) const -> bool;
+
+    /// \brief Copies of the kept errors, grouped by thread in the order each thread
+    ///        collected them. Safe to call while other threads are collecting.
+    [[nodiscard( "Const getter" )]] auto errors( ) const -> std::vector< Error >;
+
+private:
+    struct ThreadErrors;
+
+    ErrorCollectorSettings settings_;
+
+    /// \brief Distinguishes this collector in each thread's buffer cache. Never reused.
+    uint64 id_;
+
+    /// \brief One buffer per thread that has collected an error.
+    LockFreeList< ThreadErrors > threads_;
+
+    auto local_errors( ) -> ThreadErrors&;
+};
+
+} // namespace ltb::utils
@@ -6,6 +6,12 @@
 namespace ltb::utils
 {
 
+auto thread_file_loader( ) -> BatchFileLoader&
+{
+    thread_local auto loader = BatchFileLoader{ };
+    return loader;
+}
+
 // auto get_binary_file_contents(std::filesystem::path const& file_path) -> utils::Result<std::vector<char>> {
 //     auto file = std::ifstream(file_path, std::ios::ate | std::ios::binary);
 //
@@ -3,11 +3,14 @@
 // ///////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "batch_file_loader.hpp"
 #include "result.hpp"
 
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace ltb::utils
@@ -21,7 +24,11 @@ auto get_binary_file_contents( std::filesystem::path const& file_path )
 
     if ( !file.is_open( ) )
     {
-        return LTB_MAKE_UNEXPECTED_ERROR( "Failed to open file '{}'", file_path.string( ) );
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::Io,
+            "Failed to open file '{}'",
+            file_path.string( )
+        );
     }
 
     auto file_size = static_cast< size_t >( file.tellg( ) );
@@ -42,24 +49,44 @@ auto get_binary_file_contents( std::filesystem::path const& file_path )
     return buffer;
 }
 
+/// \brief A loader with default settings kept for the calling thread, so repeated batch
+///        loads reuse its `io_uring` or worker threads instead of setting them up each time.
+auto thread_file_loader( ) -> BatchFileLoader&;
+
+/// \brief Loads every file with many reads in flight at once (see `BatchFileLoader`).
+///        If any file fails, returns the error of the first one in `file_paths` that did.
 template < typename T >
 auto get_binary_files_contents( std::vector< std::filesystem::path > const& file_paths )
     -> utils::Result< std::vector< std::vector< T > > >
 {
+    auto buffers      = std::vector< std::vector< T > >( file_paths.size( ) );
+    auto failed_index = file_paths.size( );
+    auto error        = std::optional< Error >{ };
 
-    auto buffers = std::vector< std::vector< T > >{ };
-    buffers.reserve( file_paths.size( ) );
-
-    for ( auto const& file_path : file_paths )
-    {
-        auto buffer = get_binary_file_contents< T >( file_path );
-        if ( !buffer )
+    thread_file_loader( ).load(
+        file_paths,
         {
-            return tl::make_unexpected( buffer.error( ) );
+            .allocate =
+                [ &buffers ]( std::size_t const index, uint64 const size ) {
+                    auto& buffer = buffers[ index ];
+                    buffer.resize( ( size + sizeof( T ) - 1UZ ) / sizeof( T ) );
+                    return std::as_writable_bytes( std::span( buffer ) );
+                },
+            .loaded =
+                [ &failed_index, &error ]( std::size_t const index, Result< void > result ) {
+                    if ( !result && ( index < failed_index ) )
+                    {
+                        failed_index = index;
+                        error        = std::move( result ).error( );
+                    }
+                },
         }
-        buffers.emplace_back( std::move( buffer.value( ) ) );
-    }
+    );
 
+    if ( error )
+    {
+        return tl::make_unexpected( std::move( *error ) );
+    }
     return buffers;
 }
 
@@ -0,0 +1,164 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "frame_statistics.hpp"
+
+#include "allocation_tracker.hpp"
+
+// external
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+namespace ltb::utils
+{
+namespace
+{
+
+auto to_sample( Duration const& duration ) -> uint64
+{
+    return static_cast< uint64 >( std::max( to_nanos< int64 >( duration ), int64{ 0 } ) );
+}
+
+} // namespace
+
+FrameStatistics::FrameStatistics( FrameStatisticsSettings settings )
+    : settings_( std::move( settings ) )
+    , slice_duration_( settings_.window_duration / std::max( settings_.window_slices, 1U ) )
+    , slices_( std::max( settings_.window_slices, 1U ) )
+{
+}
+
+auto FrameStatistics::record( Duration const frame_time ) -> void
+{
+    LTB_ASSERT_NO_ALLOC( "FrameStatistics::record" );
+
+    auto const sample = to_sample( frame_time );
+
+    slices_[ current_slice_ ].record( sample );
+    session_.record( sample );
+
+    slice_elapsed_ += frame_time;
+    since_last_report_ += frame_time;
+
+    if ( slice_elapsed_ >= slice_duration_ )
+    {
+        current_slice_ = ( current_slice_ + 1UZ ) % slices_.size( );
+        slices_[ current_slice_ ].reset( );
+        slice_elapsed_ = Duration{ };
+    }
+}
+
+auto FrameStatistics::window_report( ) -> FrameStatisticsReport
+{
+    window_.reset( );
+    for ( auto const& slice : slices_ )
+    {
+        window_.merge( slice );
+    }
+    return make_report( window_ );
+}
+
+auto FrameStatistics::session_report( ) const -> FrameStatisticsReport
+{
+    return make_report( session_ );
+}
+
+auto FrameStatistics::report_if_due( ) -> utils::Result< void >
+{
+    if ( ( Duration::zero( ) == settings_.report_interval )
+         || ( since_last_report_ < settings_.report_interval ) )
+    {
+        return utils::success( );
+    }
+    since_last_report_ = Duration{ };
+    return write_report( window_report( ) );
+}
+
+auto FrameStatistics::write_report( FrameStatisticsReport const& report ) const
+    -> utils::Result< void >
+{
+    if ( settings_.report_file.empty( ) )
+    {
+        auto const over_budget_percent
+            = ( 0U == report.frame_count )
+                ? 0.0
+                : ( 100.0 * static_cast< float64 >( report.over_budget_count )
+                    / static_cast< float64 >( report.frame_count ) );
+
+        spdlog::info(
+            "Frames: {} | p50 {:.2f}ms p90 {:.2f}ms p99 {:.2f}ms max {:.2f}ms | "
+            "over {:.2f}ms budget: {} ({:.1f}%)",
+            report.frame_count,
+            to_millis( report.p50 ),
+            to_millis( report.p90 ),
+            to_millis( report.p99 ),
+            to_millis( report.max ),
+            to_millis( report.frame_budget ),
+            report.over_budget_count,
+            over_budget_percent
+        );
+        return utils::success( );
+    }
+
+    auto file = std::ofstream( settings_.report_file, std::ios::app );
+    if ( !file.is_open( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Failed to open frame statistics file '{}'",
+            settings_.report_file.string( )
+        );
+    }
+
+    auto const line = nlohmann::json{
+        { "frame_count", report.frame_count },
+        { "over_budget_count", report.over_budget_count },
+        { "frame_budget_ns", to_nanos< int64 >( report.frame_budget ) },
+        { "p50_ns", to_nanos< int64 >( report.p50 ) },
+        { "p90_ns", to_nanos< int64 >( report.p90 ) },
+        { "p99_ns", to_nanos< int64 >( report.p99 ) },
+        { "max_ns", to_nanos< int64 >( report.max ) },
+        { "mean_ns", to_nanos< int64 >( report.mean ) },
+    };
+    file << line.dump( ) << '\n';
+
+    return utils::success( );
+}
+
+auto FrameStatistics::reset( ) -> void
+{
+    for ( auto& slice : slices_ )
+    {
+        slice.reset( );
+    }
+    session_.reset( );
+    current_slice_     = 0UZ;
+    slice_elapsed_     = Duration{ };
+    since_last_report_ = Duration{ };
+}
+
+auto FrameStatistics::settings( ) const -> FrameStatisticsSettings const&
+{
+    return settings_;
+}
+
+auto FrameStatistics::make_report( LogHistogram const& histogram ) const
+    -> FrameStatisticsReport
+{
+    return {
+        .frame_count       = histogram.count( ),
+        .over_budget_count = histogram.count_above( to_sample( settings_.frame_budget ) ),
+        .frame_budget      = settings_.frame_budget,
+        .p50               = duration_nanos( histogram.value_at_percentile( 50.0 ) ),
+        .p90               = duration_nanos( histogram.value_at_percentile( 90.0 ) ),
+        .p99               = duration_nanos( histogram.value_at_percentile( 99.0 ) ),
+        .max               = duration_nanos( histogram.max( ) ),
+        .mean              = duration_nanos( static_cast< uint64 >( histogram.mean( ) ) ),
+    };
+}
+
+} // namespace ltb::utils
@@ -0,0 +1,102 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "duration.hpp"
+#include "log_histogram.hpp"
+#include "result.hpp"
+#include "types.hpp"
+
+// standard
+#include <filesystem>
+#include <vector>
+
+namespace ltb::utils
+{
+
+struct FrameStatisticsSettings
+{
+    /// \brief Frames longer than this are counted as over budget.
+    Duration frame_budget = duration_micros( 16'667 );
+
+    /// \brief The rolling window is split into this many slices of equal length. The oldest
+    ///        slice is discarded whenever a new one starts, so the window covers between
+    ///        `window_duration * ( window_slices - 1 ) / window_slices` and
+    ///        `window_duration` of frames.
+    Duration window_duration = duration_seconds( 10 );
+    uint32   window_slices   = 10U;
+
+    /// \brief How often `report_if_due` dumps the rolling window. Zero disables it.
+    Duration report_interval = duration_seconds( 5 );
+
+    /// \brief When set, reports are appended to this file as JSON lines instead of logged.
+    std::filesystem::path report_file = { };
+};
+
+struct FrameStatisticsReport
+{
+    uint64 frame_count       = 0U;
+    uint64 over_budget_count = 0U;
+
+    Duration frame_budget = { };
+
+    Duration p50  = { };
+    Duration p90  = { };
+    Duration p99  = { };
+    Duration max  = { };
+    Duration mean = { };
+};
+
+/// \brief Keeps log-bucketed frame time histograms over a rolling window and for the whole
+///        session. Time is measured by summing the recorded frame times, so no clock is read.
+///
+/// Histograms are allocated up front; `record` is allocation-free and cheap enough to call
+/// every frame. It is not thread-safe; record from the thread that owns the frame loop.
+class FrameStatistics
+{
+public:
+    explicit FrameStatistics( FrameStatisticsSettings settings );
+
+    auto record( Duration frame_time ) -> void;
+
+    /// \brief Statistics for the frames in the rolling window.
+    [[nodiscard]] auto window_report( ) -> FrameStatisticsReport;
+
+    /// \brief Statistics for every frame since construction or `reset`.
+    [[nodiscard( "Const getter" )]]
+    auto session_report( ) const -> FrameStatisticsReport;
+
+    /// \brief Dumps the rolling window to the log or report file once
+    ///        `report_interval` worth of frames have been recorded since the last dump.
+    auto report_if_due( ) -> utils::Result< void >;
+
+    /// \brief Writes `report` to the log or report file.
+    auto write_report( FrameStatisticsReport const& report ) const -> utils::Result< void >;
+
+    auto reset( ) -> void;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> FrameStatisticsSettings const&;
+
+private:
+    FrameStatisticsSettings settings_;
+    Duration                slice_duration_;
+
+    std::vector< LogHistogram > slices_;
+    std::size_t                 current_slice_ = 0UZ;
+    Duration                    slice_elapsed_ = { };
+
+    LogHistogram session_;
+
+    // Scratch space for merging the slices without allocating.
+    LogHistogram window_;
+
+    Duration since_last_report_ = { };
+
+    [[nodiscard( "Const getter" )]]
+    auto make_report( LogHistogram const& histogram ) const -> FrameStatisticsReport;
+};
+
+} // namespace ltb::utils
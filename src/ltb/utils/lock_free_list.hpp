@@ -0,0 +1,79 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// standard
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace ltb::utils
+{
+
+/// \brief An intrusive singly linked list any thread can push to without locking. Nodes
+///        are never removed, only deleted with the list, so readers can walk it from
+///        `head( )` without locking either.
+///
+/// Used for per-thread buffers: each thread pushes its own node once and a collector walks
+/// every node. `Node` must have a `Node* next` member, which the list owns.
+///
+/// \code
+/// for ( auto* node = list.head( ); nullptr != node; node = node->next ) { ... }
+/// \endcode
+template < typename Node >
+class LockFreeList
+{
+public:
+    LockFreeList( ) = default;
+    ~LockFreeList( );
+
+    // No copy or move. Pushed nodes are handed out by pointer.
+    LockFreeList( LockFreeList const& )                        = delete;
+    LockFreeList( LockFreeList&& ) noexcept                    = delete;
+    auto operator=( LockFreeList const& ) -> LockFreeList&     = delete;
+    auto operator=( LockFreeList&& ) noexcept -> LockFreeList& = delete;
+
+    /// \brief Takes ownership of `owned` and makes it the new head.
+    auto push( std::unique_ptr< Node > owned ) -> Node*;
+
+    /// \brief The most recently pushed node, or null if the list is empty.
+    [[nodiscard( "Const getter" )]] auto head( ) const -> Node*;
+
+private:
+    std::atomic< Node* > head_ = nullptr;
+};
+
+template < typename Node >
+LockFreeList< Node >::~LockFreeList( )
+{
+    auto* node = head_.load( std::memory_order_acquire );
+    while ( nullptr != node )
+    {
+        delete std::exchange( node, node->next );
+    }
+}
+
+template < typename Node >
+auto LockFreeList< Node >::push( std::unique_ptr< Node > owned ) -> Node*
+{
+    auto* const node = owned.release( );
+    node->next       = head_.load( std::memory_order_relaxed );
+    while ( !head_.compare_exchange_weak(
+        node->next,
+        node,
+        std::memory_order_release,
+        std::memory_order_relaxed
+    ) )
+    {
+    }
+    return node;
+}
+
+template < typename Node >
+auto LockFreeList< Node >::head( ) const -> Node*
+{
+    return head_.load( std::memory_order_acquire );
+}
+
+} // namespace ltb::utils
@@ -0,0 +1,119 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "log_histogram.hpp"
+
+// standard
+#include <algorithm>
+#include <cmath>
+
+namespace ltb::utils
+{
+
+auto LogHistogram::record( uint64 const value ) -> void
+{
+    record( value, 1U );
+}
+
+auto LogHistogram::record( uint64 const value, uint64 const count ) -> void
+{
+    if ( 0U == count )
+    {
+        return;
+    }
+
+    counts_[ bucket_index( value ) ] += count;
+
+    min_ = ( 0U == total_count_ ) ? value : std::min( min_, value );
+    max_ = std::max( max_, value );
+    sum_ += static_cast< float64 >( value ) * static_cast< float64 >( count );
+    total_count_ += count;
+}
+
+auto LogHistogram::merge( LogHistogram const& other ) -> void
+{
+    if ( 0U == other.total_count_ )
+    {
+        return;
+    }
+
+    for ( auto index = 0UZ; index < bucket_count; ++index )
+    {
+        counts_[ index ] += other.counts_[ index ];
+    }
+
+    min_ = ( 0U == total_count_ ) ? other.min_ : std::min( min_, other.min_ );
+    max_ = std::max( max_, other.max_ );
+    sum_ += other.sum_;
+    total_count_ += other.total_count_;
+}
+
+auto LogHistogram::reset( ) -> void
+{
+    counts_.fill( 0U );
+    total_count_ = 0U;
+    min_         = 0U;
+    max_         = 0U;
+    sum_         = 0.0;
+}
+
+auto LogHistogram::count( ) const -> uint64
+{
+    return total_count_;
+}
+
+auto LogHistogram::min( ) const -> uint64
+{
+    return min_;
+}
+
+auto LogHistogram::max( ) const -> uint64
+{
+    return max_;
+}
+
+auto LogHistogram::mean( ) const -> float64
+{
+    if ( 0U == total_count_ )
+    {
+        return 0.0;
+    }
+    return sum_ / static_cast< float64 >( total_count_ );
+}
+
+auto LogHistogram::count_above( uint64 const threshold ) const -> uint64
+{
+    auto total = uint64{ 0U };
+    for ( auto index = bucket_index( threshold ) + 1U; index < bucket_count; ++index )
+    {
+        total += counts_[ index ];
+    }
+    return total;
+}
+
+auto LogHistogram::value_at_percentile( float64 const percentile ) const -> uint64
+{
+    if ( 0U == total_count_ )
+    {
+        return 0U;
+    }
+
+    auto const fraction = std::clamp( percentile, 0.0, 100.0 ) / 100.0;
+    auto const target   = std::max(
+        uint64{ 1U },
+        static_cast< uint64 >( std::ceil( fraction * static_cast< float64 >( total_count_ ) ) )
+    );
+
+    auto seen = uint64{ 0U };
+    for ( auto index = 0U; index < bucket_count; ++index )
+    {
+        seen += counts_[ index ];
+        if ( seen >= target )
+        {
+            return std::min( bucket_highest_value( index ), max_ );
+        }
+    }
+    return max_;
+}
+
+} // namespace ltb::utils
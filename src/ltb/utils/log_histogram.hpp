@@ -0,0 +1,123 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "types.hpp"
+
+// standard
+#include <array>
+#include <bit>
+
+namespace ltb::utils
+{
+
+/// \brief A fixed-size histogram of unsigned integer values with log-linear buckets, in the
+///        style of HdrHistogram. Every power of two is split into `sub_bucket_count` linear
+///        buckets, so values are stored with a relative error of at most 1/32 (~3%).
+///
+/// Recording never allocates. Values larger than `max_trackable_value` are clamped into the
+/// last bucket but still update `max( )` exactly.
+class LogHistogram
+{
+public:
+    static constexpr auto sub_bucket_bits  = 5U;
+    static constexpr auto sub_bucket_count = 1U << sub_bucket_bits;
+
+    /// \brief Values below 2^max_exponent are bucketed without clamping.
+    static constexpr auto max_exponent = 40U;
+    static constexpr auto bucket_count
+        = sub_bucket_count + ( ( max_exponent - sub_bucket_bits ) * sub_bucket_count );
+
+    static constexpr auto max_trackable_value = ( uint64{ 1U } << max_exponent ) - 1U;
+
+    auto record( uint64 value ) -> void;
+    auto record( uint64 value, uint64 count ) -> void;
+
+    /// \brief Adds every sample in `other` to this histogram.
+    auto merge( LogHistogram const& other ) -> void;
+
+    auto reset( ) -> void;
+
+    [[nodiscard( "Const getter" )]]
+    auto count( ) const -> uint64;
+
+    [[nodiscard( "Const getter" )]]
+    auto min( ) const -> uint64;
+
+    [[nodiscard( "Const getter" )]]
+    auto max( ) const -> uint64;
+
+    [[nodiscard( "Const getter" )]]
+    auto mean( ) const -> float64;
+
+    /// \brief The number of recorded values strictly greater than `threshold`,
+    ///        accurate to the bucket containing `threshold`.
+    [[nodiscard( "Const getter" )]]
+    auto count_above( uint64 threshold ) const -> uint64;
+
+    /// \brief The smallest bucket upper bound that at least `percentile`% of the recorded
+    ///        values fall at or below. `percentile` is clamped to [0, 100]. The result never
+    ///        exceeds `max( )`. Returns zero when the histogram is empty.
+    [[nodiscard( "Const getter" )]]
+    auto value_at_percentile( float64 percentile ) const -> uint64;
+
+    [[nodiscard]]
+    static constexpr auto bucket_index( uint64 value ) -> uint32;
+
+    [[nodiscard]]
+    static constexpr auto bucket_lowest_value( uint32 index ) -> uint64;
+
+    [[nodiscard]]
+    static constexpr auto bucket_highest_value( uint32 index ) -> uint64;
+
+private:
+    std::array< uint64, bucket_count > counts_ = { };
+
+    uint64 total_count_ = 0U;
+    uint64 min_         = 0U;
+    uint64 max_         = 0U;
+
+    // Summed as floating point so long runs of large values cannot overflow.
+    float64 sum_ = 0.0;
+};
+
+constexpr auto LogHistogram::bucket_index( uint64 const value ) -> uint32
+{
+    auto const clamped = ( value > max_trackable_value ) ? max_trackable_value : value;
+    if ( clamped < sub_bucket_count )
+    {
+        return static_cast< uint32 >( clamped );
+    }
+
+    // The exponent of the highest set bit, which is at least `sub_bucket_bits` here.
+    auto const exponent   = static_cast< uint32 >( std::bit_width( clamped ) ) - 1U;
+    auto const shift      = exponent - sub_bucket_bits;
+    auto const sub_bucket = static_cast< uint32 >( clamped >> shift ) - sub_bucket_count;
+
+    return sub_bucket_count + ( shift * sub_bucket_count ) + sub_bucket;
+}
+
+constexpr auto LogHistogram::bucket_lowest_value( uint32 const index ) -> uint64
+{
+    if ( index < sub_bucket_count )
+    {
+        return index;
+    }
+    auto const shift      = ( index - sub_bucket_count ) / sub_bucket_count;
+    auto const sub_bucket = ( index - sub_bucket_count ) % sub_bucket_count;
+    return uint64{ sub_bucket_count + sub_bucket } << shift;
+}
+
+constexpr auto LogHistogram::bucket_highest_value( uint32 const index ) -> uint64
+{
+    if ( index < sub_bucket_count )
+    {
+        return index;
+    }
+    auto const shift = ( index - sub_bucket_count ) / sub_bucket_count;
+    return bucket_lowest_value( index ) + ( uint64{ 1U } << shift ) - 1U;
+}
+
+} // namespace ltb::utils
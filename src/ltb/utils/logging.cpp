@@ -10,10 +10,34 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/join.hpp>
 #include <range/v3/view/transform.hpp>
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
+// standard
+#include <vector>
+
 namespace ltb::utils
 {
+namespace
+{
+
+auto to_spdlog_policy( LogOverflowPolicy const policy ) -> spdlog::async_overflow_policy
+{
+    switch ( policy )
+    {
+        case LogOverflowPolicy::Block:
+            return spdlog::async_overflow_policy::block;
+        case LogOverflowPolicy::Drop:
+            return spdlog::async_overflow_policy::discard_new;
+        case LogOverflowPolicy::DropOldest:
+            return spdlog::async_overflow_policy::overrun_oldest;
+    }
+    return spdlog::async_overflow_policy::block;
+}
+
+} // namespace
 
 auto try_setting_log_level( std::string const& log_level ) -> utils::Result< void >
 {
@@ -68,4 +92,94 @@ auto try_setting_log_level( std::string const& log_level ) -> utils::Result< voi
     return utils::success( );
 }
 
+auto start_async_logging( AsyncLoggingSettings const& settings ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( settings.queue_size > 0U );
+
+    stop_async_logging( );
+
+    auto const level = spdlog::get_level( );
+
+    // spdlog reports sink and thread pool failures with exceptions.
+    try
+    {
+        auto sinks = std::vector< spdlog::sink_ptr >{
+            std::make_shared< spdlog::sinks::stdout_color_sink_mt >( ),
+        };
+        if ( !settings.log_file.empty( ) )
+        {
+            sinks.emplace_back(
+                std::make_shared< spdlog::sinks::basic_file_sink_mt >( settings.log_file.string( ) )
+            );
+        }
+
+        spdlog::init_thread_pool( settings.queue_size, 1U );
+
+        auto logger = std::make_shared< spdlog::async_logger >(
+            spdlog::default_logger( )->name( ),
+            sinks.begin( ),
+            sinks.end( ),
+            spdlog::thread_pool( ),
+            to_spdlog_policy( settings.overflow_policy )
+        );
+        logger->set_level( level );
+        spdlog::set_default_logger( std::move( logger ) );
+    }
+    catch ( spdlog::spdlog_ex const& exception )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Failed to start async logging: {}", exception.what( ) );
+    }
+
+    return utils::success( );
+}
+
+auto stop_async_logging( ) -> void
+{
+    auto async_logger
+        = std::dynamic_pointer_cast< spdlog::async_logger >( spdlog::default_logger( ) );
+    if ( !async_logger )
+    {
+        return;
+    }
+
+    if ( auto const stats = async_logging_stats( );
+         ( stats.dropped_new > 0U ) || ( stats.dropped_oldest > 0U ) )
+    {
+        async_logger->warn(
+            "Async logging dropped {} new and {} queued messages",
+            stats.dropped_new,
+            stats.dropped_oldest
+        );
+    }
+
+    // The sinks are thread-safe, so the synchronous logger can share them while the
+    // writer thread drains what's left in the queue.
+    auto sync_logger = std::make_shared< spdlog::logger >(
+        async_logger->name( ),
+        async_logger->sinks( ).begin( ),
+        async_logger->sinks( ).end( )
+    );
+    sync_logger->set_level( async_logger->level( ) );
+    spdlog::set_default_logger( std::move( sync_logger ) );
+    async_logger->flush( );
+    async_logger.reset( );
+
+    // Releasing the registry's thread pool joins the writer after it drains the queue.
+    spdlog::details::registry::instance( ).set_tp( nullptr );
+}
+
+auto async_logging_stats( ) -> AsyncLoggingStats
+{
+    auto const pool = spdlog::thread_pool( );
+    if ( !pool )
+    {
+        return { };
+    }
+    return {
+        .queued         = pool->queue_size( ),
+        .dropped_new    = pool->discard_counter( ),
+        .dropped_oldest = pool->overrun_counter( ),
+    };
+}
+
 } // namespace ltb::utils
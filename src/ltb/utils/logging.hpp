@@ -5,6 +5,13 @@
 
 // project
 #include "result.hpp"
+#include "types.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <filesystem>
 
 namespace ltb::utils
 {
@@ -15,4 +22,114 @@ namespace ltb::utils
 ///        can be used to set the log level from command line inputs.
 auto try_setting_log_level( std::string const& log_level ) -> utils::Result< void >;
 
+/// \brief What a logging call does when the async queue is full.
+enum class LogOverflowPolicy
+{
+    Block,      ///< Wait for the writer thread to make room. Nothing is lost.
+    Drop,       ///< Discard the new message.
+    DropOldest, ///< Discard the oldest queued message to make room.
+};
+
+struct AsyncLoggingSettings
+{
+    /// \brief Messages that can be queued before the overflow policy applies.
+    uint64            queue_size      = 8192U;
+    LogOverflowPolicy overflow_policy = LogOverflowPolicy::DropOldest;
+
+    /// \brief Also write to this file when set. The console is always written to.
+    std::filesystem::path log_file = { };
+};
+
+/// \brief Replaces the default spdlog logger with one that formats on the calling thread
+///        and hands messages to a bounded queue drained by a background writer thread,
+///        so slow terminals or disks don't stall the caller. The current level is kept.
+auto start_async_logging( AsyncLoggingSettings const& settings ) -> utils::Result< void >;
+
+/// \brief Writes every queued message, stops the writer thread and restores a
+///        synchronous default logger with the same sinks. Does nothing if async
+///        logging isn't running.
+auto stop_async_logging( ) -> void;
+
+struct AsyncLoggingStats
+{
+    uint64 queued         = 0U;
+    uint64 dropped_new    = 0U;
+    uint64 dropped_oldest = 0U;
+};
+
+/// \brief All zeros when async logging isn't running.
+auto async_logging_stats( ) -> AsyncLoggingStats;
+
 } // namespace ltb::utils
+
+// Compile-time log level floors. These match spdlog::level::level_enum.
+#define LTB_LOG_LEVEL_TRACE 0
+#define LTB_LOG_LEVEL_DEBUG 1
+#define LTB_LOG_LEVEL_INFO 2
+#define LTB_LOG_LEVEL_WARN 3
+#define LTB_LOG_LEVEL_ERROR 4
+#define LTB_LOG_LEVEL_CRITICAL 5
+#define LTB_LOG_LEVEL_OFF 6
+
+static_assert( LTB_LOG_LEVEL_TRACE == ::spdlog::level::trace );
+static_assert( LTB_LOG_LEVEL_OFF == ::spdlog::level::off );
+
+/// \brief Set with the `LTB_LOG_LEVEL` CMake cache variable. `LTB_LOG_*` calls below this
+///        level compile to nothing; calls at or above it are still filtered at runtime by
+///        the spdlog level (see `try_setting_log_level`).
+#ifndef LTB_LOG_LEVEL
+#define LTB_LOG_LEVEL LTB_LOG_LEVEL_TRACE
+#endif
+
+// Do not use this macro directly; use the LTB_LOG_* macros instead.
+// The runtime check comes first so arguments aren't evaluated for filtered messages.
+#define DETAIL_LTB_LOG( level, ... )                                                               \
+    do                                                                                             \
+    {                                                                                              \
+        if ( ::spdlog::should_log( level ) )                                                       \
+        {                                                                                          \
+            ::spdlog::default_logger_raw( )->log(                                                  \
+                ::spdlog::source_loc{ __FILE__, __LINE__, SPDLOG_FUNCTION },                       \
+                level,                                                                             \
+                __VA_ARGS__                                                                        \
+            );                                                                                     \
+        }                                                                                          \
+    } while ( false )
+
+#define DETAIL_LTB_LOG_DISABLED( ... ) static_cast< void >( 0 )
+
+#if LTB_LOG_LEVEL <= LTB_LOG_LEVEL_TRACE
+#define LTB_LOG_TRACE( ... ) DETAIL_LTB_LOG( ::spdlog::level::trace, __VA_ARGS__ )
+#else
+#define LTB_LOG_TRACE( ... ) DETAIL_LTB_LOG_DISABLED( __VA_ARGS__ )
+#endif
+
+#if LTB_LOG_LEVEL <= LTB_LOG_LEVEL_DEBUG
+#define LTB_LOG_DEBUG( ... ) DETAIL_LTB_LOG( ::spdlog::level::debug, __VA_ARGS__ )
+#else
+#define LTB_LOG_DEBUG( ... ) DETAIL_LTB_LOG_DISABLED( __VA_ARGS__ )
+#endif
+
+#if LTB_LOG_LEVEL <= LTB_LOG_LEVEL_INFO
+#define LTB_LOG_INFO( ... ) DETAIL_LTB_LOG( ::spdlog::level::info, __VA_ARGS__ )
+#else
+#define LTB_LOG_INFO( ... ) DETAIL_LTB_LOG_DISABLED( __VA_ARGS__ )
+#endif
+
+#if LTB_LOG_LEVEL <= LTB_LOG_LEVEL_WARN
+#define LTB_LOG_WARN( ... ) DETAIL_LTB_LOG( ::spdlog::level::warn, __VA_ARGS__ )
+#else
+#define LTB_LOG_WARN( ... ) DETAIL_LTB_LOG_DISABLED( __VA_ARGS__ )
+#endif
+
+#if LTB_LOG_LEVEL <= LTB_LOG_LEVEL_ERROR
+#define LTB_LOG_ERROR( ... ) DETAIL_LTB_LOG( ::spdlog::level::err, __VA_ARGS__ )
+#else
+#define LTB_LOG_ERROR( ... ) DETAIL_LTB_LOG_DISABLED( __VA_ARGS__ )
+#endif
+
+#if LTB_LOG_LEVEL <= LTB_LOG_LEVEL_CRITICAL
+#define LTB_LOG_CRITICAL( ... ) DETAIL_LTB_LOG( ::spdlog::level::critical, __VA_ARGS__ )
+#else
+#define LTB_LOG_CRITICAL( ... ) DETAIL_LTB_LOG_DISABLED( __VA_ARGS__ )
+#endif
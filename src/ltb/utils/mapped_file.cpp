@@ -0,0 +1,209 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "mapped_file.hpp"
+
+// project
+#include "file_utils.hpp"
+#include "generic_guard.hpp"
+
+// standard
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define LTB_MAPPED_FILE_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ltb::utils
+{
+namespace
+{
+
+#ifdef LTB_MAPPED_FILE_HAS_MMAP
+
+auto to_advice( MappedFileAccess const access ) -> int
+{
+    switch ( access )
+    {
+        using enum MappedFileAccess;
+        case Normal:
+            return MADV_NORMAL;
+        case Sequential:
+            return MADV_SEQUENTIAL;
+        case Random:
+            return MADV_RANDOM;
+        case WillNeed:
+            return MADV_WILLNEED;
+    }
+    return MADV_NORMAL;
+}
+
+auto page_size( ) -> uint64
+{
+    static auto const size = static_cast< uint64 >( ::sysconf( _SC_PAGESIZE ) );
+    return size;
+}
+
+#endif
+
+} // namespace
+
+MappedFile::~MappedFile( )
+{
+#ifdef LTB_MAPPED_FILE_HAS_MMAP
+    if ( ( nullptr != data_ ) && fallback_.empty( ) )
+    {
+        ::munmap( const_cast< std::byte* >( data_ ), size_ );
+    }
+#endif
+}
+
+MappedFile::MappedFile( MappedFile&& other ) noexcept
+    : data_( std::exchange( other.data_, nullptr ) )
+    , size_( std::exchange( other.size_, 0U ) )
+    , fallback_( std::move( other.fallback_ ) )
+{
+}
+
+auto MappedFile::operator=( MappedFile&& other ) noexcept -> MappedFile&
+{
+    if ( this != &other )
+    {
+        auto discarded = std::move( *this );
+        data_          = std::exchange( other.data_, nullptr );
+        size_          = std::exchange( other.size_, 0U );
+        fallback_      = std::move( other.fallback_ );
+    }
+    return *this;
+}
+
+auto MappedFile::bytes( ) const -> std::span< std::byte const >
+{
+    return { data_, size_ };
+}
+
+auto MappedFile::size( ) const -> uint64
+{
+    return size_;
+}
+
+auto MappedFile::empty( ) const -> bool
+{
+    return 0U == size_;
+}
+
+auto MappedFile::advise(
+    MappedFileAccess const access,
+    uint64 const           offset,
+    uint64 const           size
+) const -> Result< void >
+{
+    LTB_CHECK_VALID( offset <= size_ );
+
+#ifdef LTB_MAPPED_FILE_HAS_MMAP
+    if ( empty( ) || !fallback_.empty( ) )
+    {
+        return success( );
+    }
+
+    // madvise needs a page aligned start, so round the range out to whole pages.
+    auto const begin = ( offset / page_size( ) ) * page_size( );
+    auto const end   = offset + std::min( size, size_ - offset );
+
+    auto* const start = const_cast< std::byte* >( data_ ) + begin;
+    if ( 0 != ::madvise( start, end - begin, to_advice( access ) ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "madvise failed: {}", std::strerror( errno ) );
+    }
+#else
+    utils::ignore( access, size );
+#endif
+
+    return success( );
+}
+
+auto map_file( std::filesystem::path const& file_path, MappedFileSettings const& settings )
+    -> Result< MappedFile >
+{
+    auto mapped = MappedFile{ };
+
+#ifdef LTB_MAPPED_FILE_HAS_MMAP
+    auto const file = ::open( file_path.c_str( ), O_RDONLY | O_CLOEXEC );
+    if ( file < 0 )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::Io,
+            "Failed to open file '{}': {}",
+            file_path.string( ),
+            std::strerror( errno )
+        );
+    }
+    // The mapping keeps the file alive, so the descriptor can be closed right away.
+    auto const close_file = make_guard( [] { }, [ file ] { ::close( file ); } );
+
+    struct stat status = { };
+    if ( 0 != ::fstat( file, &status ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::Io,
+            "Failed to stat file '{}': {}",
+            file_path.string( ),
+            std::strerror( errno )
+        );
+    }
+
+    auto const size = static_cast< uint64 >( status.st_size );
+    if ( 0U == size )
+    {
+        return mapped;
+    }
+
+    auto flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if ( settings.populate )
+    {
+        flags |= MAP_POPULATE;
+    }
+#endif
+
+    auto* const data = ::mmap( nullptr, size, PROT_READ, flags, file, 0 );
+    if ( MAP_FAILED == data )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::Io,
+            "Failed to map file '{}': {}",
+            file_path.string( ),
+            std::strerror( errno )
+        );
+    }
+
+    mapped.data_ = static_cast< std::byte const* >( data );
+    mapped.size_ = size;
+
+    // Hints are best effort, so failures are ignored.
+    utils::ignore( mapped.advise( settings.access ) );
+#ifdef MADV_HUGEPAGE
+    if ( settings.huge_pages )
+    {
+        utils::ignore( ::madvise( data, size, MADV_HUGEPAGE ) );
+    }
+#endif
+
+#else
+    LTB_CHECK( mapped.fallback_, get_binary_file_contents< std::byte >( file_path ) );
+    mapped.data_ = mapped.fallback_.data( );
+    mapped.size_ = mapped.fallback_.size( );
+    utils::ignore( settings );
+#endif
+
+    return mapped;
+}
+
+} // namespace ltb::utils
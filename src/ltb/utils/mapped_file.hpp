@@ -0,0 +1,110 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "result.hpp"
+#include "types.hpp"
+
+// standard
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace ltb::utils
+{
+
+/// \brief How a mapping will be read, passed to the kernel as an `madvise` hint.
+enum class MappedFileAccess : uint8
+{
+    Normal,
+
+    /// \brief Read ahead aggressively and drop pages soon after they are read.
+    Sequential,
+
+    /// \brief Don't read ahead.
+    Random,
+
+    /// \brief Start reading the whole range in the background now.
+    WillNeed,
+};
+
+struct MappedFileSettings
+{
+    MappedFileAccess access = MappedFileAccess::Sequential;
+
+    /// \brief Fault in every page while mapping (`MAP_POPULATE`), so later reads never
+    ///        block on disk. Linux only.
+    bool populate = false;
+
+    /// \brief Ask for transparent huge pages (`MADV_HUGEPAGE`) to cut TLB misses on large
+    ///        files. Only honored by filesystems with huge page support for files, such as
+    ///        tmpfs mounted with `huge=`. Linux only.
+    bool huge_pages = false;
+};
+
+/// \brief A read-only view of a whole file, mapped into memory.
+///
+/// Unlike `get_binary_file_contents` nothing is copied up front. Pages are read from the
+/// page cache on first access and can be handed straight to consumers like GPU uploads.
+/// Mapping costs a few system calls, so files smaller than about 64 KiB are cheaper to read
+/// with `get_binary_file_contents`. Platforms without `mmap` read the file into memory.
+class MappedFile
+{
+public:
+    /// \brief An empty mapping. Use `map_file` to map a file.
+    MappedFile( ) = default;
+    ~MappedFile( );
+
+    // No copy. Moving transfers ownership of the mapping.
+    MappedFile( MappedFile const& )                    = delete;
+    auto operator=( MappedFile const& ) -> MappedFile& = delete;
+    MappedFile( MappedFile&& other ) noexcept;
+    auto operator=( MappedFile&& other ) noexcept -> MappedFile&;
+
+    [[nodiscard( "Const getter" )]] auto bytes( ) const -> std::span< std::byte const >;
+    [[nodiscard( "Const getter" )]] auto size( ) const -> uint64;
+    [[nodiscard( "Const getter" )]] auto empty( ) const -> bool;
+
+    /// \brief The file as an array of `T`. Trailing bytes that don't fill a whole `T` are
+    ///        not included. Mappings are page aligned, but the copy made where `mmap` is
+    ///        unavailable is only aligned like any `new` allocation, so over-aligned types
+    ///        are rejected.
+    template < typename T >
+        requires std::is_trivially_copyable_v< T >
+              && ( alignof( T ) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ )
+    [[nodiscard( "Const getter" )]] auto as_span( ) const -> std::span< T const >
+    {
+        return { reinterpret_cast< T const* >( data_ ), size_ / sizeof( T ) };
+    }
+
+    /// \brief Changes the access hint for part of the mapping, for example `WillNeed` on
+    ///        the next region a streaming reader will touch.
+    auto advise(
+        MappedFileAccess access,
+        uint64           offset = 0U,
+        uint64           size   = std::numeric_limits< uint64 >::max( )
+    ) const -> Result< void >;
+
+private:
+    std::byte const* data_ = nullptr;
+    uint64           size_ = 0U;
+
+    /// \brief The file contents on platforms without `mmap`.
+    std::vector< std::byte > fallback_ = { };
+
+    friend auto map_file(
+        std::filesystem::path const& file_path,
+        MappedFileSettings const&    settings
+    ) -> Result< MappedFile >;
+};
+
+/// \brief Maps a whole file read-only. Empty files produce an empty mapping.
+auto map_file( std::filesystem::path const& file_path, MappedFileSettings const& settings = { } )
+    -> Result< MappedFile >;
+
+} // namespace ltb::utils
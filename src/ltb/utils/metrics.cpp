@@ -0,0 +1,535 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "metrics.hpp"
+
+// project
+#include "ignore.hpp"
+#include "type_traits.hpp"
+#include "variant_utils.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <utility>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define LTB_METRICS_HAS_UNIX_SOCKET
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace ltb::utils
+{
+namespace
+{
+
+constexpr auto socket_poll_interval = std::chrono::milliseconds( 100 );
+
+auto format_value( float64 const value ) -> std::string
+{
+    if ( std::isnan( value ) )
+    {
+        return "NaN";
+    }
+    if ( std::isinf( value ) )
+    {
+        return ( value > 0.0 ) ? "+Inf" : "-Inf";
+    }
+    return fmt::format( "{}", value );
+}
+
+auto escape( std::string const& text, bool const escape_quotes ) -> std::string
+{
+    auto escaped = std::string{ };
+    escaped.reserve( text.size( ) );
+    for ( auto const c : text )
+    {
+        switch ( c )
+        {
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            case '"':
+                escaped += escape_quotes ? "\\\"" : "\"";
+                break;
+            default:
+                escaped += c;
+                break;
+        }
+    }
+    return escaped;
+}
+
+/// \brief Renders `{key="value",...}`, or nothing when there are no labels.
+auto format_labels( MetricLabels const& labels, std::string const& extra = "" ) -> std::string
+{
+    if ( labels.empty( ) && extra.empty( ) )
+    {
+        return "";
+    }
+
+    auto text = std::string{ "{" };
+    for ( auto const& [ key, value ] : labels )
+    {
+        if ( text.size( ) > 1UZ )
+        {
+            text += ',';
+        }
+        text += fmt::format( "{}=\"{}\"", key, escape( value, true ) );
+    }
+    if ( !extra.empty( ) )
+    {
+        if ( text.size( ) > 1UZ )
+        {
+            text += ',';
+        }
+        text += extra;
+    }
+    return text + "}";
+}
+
+} // namespace
+
+auto Counter::add( uint64 const amount ) -> void
+{
+    value_.fetch_add( amount, std::memory_order_relaxed );
+}
+
+auto Counter::value( ) const -> uint64
+{
+    return value_.load( std::memory_order_relaxed );
+}
+
+auto Gauge::set( float64 const value ) -> void
+{
+    value_.store( value, std::memory_order_relaxed );
+}
+
+auto Gauge::add( float64 const amount ) -> void
+{
+    value_.fetch_add( amount, std::memory_order_relaxed );
+}
+
+auto Gauge::value( ) const -> float64
+{
+    return value_.load( std::memory_order_relaxed );
+}
+
+Histogram::Histogram( std::vector< float64 > upper_bounds )
+    : upper_bounds_( std::move( upper_bounds ) )
+    , counts_( std::make_unique< std::atomic< uint64 >[] >( upper_bounds_.size( ) + 1UZ ) )
+{
+    std::ranges::sort( upper_bounds_ );
+}
+
+auto Histogram::observe( float64 const value ) -> void
+{
+    auto const bucket = std::ranges::lower_bound( upper_bounds_, value ) - upper_bounds_.begin( );
+    counts_[ static_cast< std::size_t >( bucket ) ].fetch_add( 1U, std::memory_order_relaxed );
+    sum_.fetch_add( value, std::memory_order_relaxed );
+}
+
+auto Histogram::upper_bounds( ) const -> std::vector< float64 > const&
+{
+    return upper_bounds_;
+}
+
+auto Histogram::bucket_counts( ) const -> std::vector< uint64 >
+{
+    auto counts = std::vector< uint64 >( upper_bounds_.size( ) + 1UZ );
+    for ( auto i = 0UZ; i < counts.size( ); ++i )
+    {
+        counts[ i ] = counts_[ i ].load( std::memory_order_relaxed );
+    }
+    return counts;
+}
+
+auto Histogram::sum( ) const -> float64
+{
+    return sum_.load( std::memory_order_relaxed );
+}
+
+auto exponential_buckets( float64 const start, float64 const factor, uint32 const count )
+    -> std::vector< float64 >
+{
+    auto bounds = std::vector< float64 >{ };
+    bounds.reserve( count );
+
+    auto bound = start;
+    for ( auto i = 0U; i < count; ++i )
+    {
+        bounds.emplace_back( bound );
+        bound *= factor;
+    }
+    return bounds;
+}
+
+template < typename T, typename... Args >
+auto MetricsRegistry::get_or_create(
+    std::string const& name,
+    std::string const& help,
+    MetricLabels       labels,
+    Args&&... args
+) -> T&
+{
+    auto const lock = std::scoped_lock( mutex_ );
+
+    constexpr auto type = variant_index_v< T, Metric >;
+
+    auto& family = families_.try_emplace( name, Family{ .help = help, .type = type } )
+                       .first->second;
+    if ( family.type != type )
+    {
+        spdlog::error( "Metric '{}' was already registered with a different type", name );
+        return std::get< T >( *detached_.emplace_back(
+            std::make_unique< Metric >( std::in_place_type< T >, std::forward< Args >( args )... )
+        ) );
+    }
+
+    auto& metric = family.metrics[ std::move( labels ) ];
+    if ( nullptr == metric )
+    {
+        metric = std::make_unique< Metric >(
+            std::in_place_type< T >,
+            std::forward< Args >( args )...
+        );
+    }
+    return std::get< T >( *metric );
+}
+
+auto MetricsRegistry::counter(
+    std::string const& name,
+    std::string const& help,
+    MetricLabels       labels
+) -> Counter&
+{
+    return get_or_create< Counter >( name, help, std::move( labels ) );
+}
+
+auto MetricsRegistry::gauge( std::string const& name, std::string const& help, MetricLabels labels )
+    -> Gauge&
+{
+    return get_or_create< Gauge >( name, help, std::move( labels ) );
+}
+
+auto MetricsRegistry::histogram(
+    std::string const&     name,
+    std::string const&     help,
+    std::vector< float64 > upper_bounds,
+    MetricLabels           labels
+) -> Histogram&
+{
+    return get_or_create< Histogram >( name, help, std::move( labels ), std::move( upper_bounds ) );
+}
+
+auto MetricsRegistry::to_prometheus_text( ) const -> std::string
+{
+    auto const lock = std::scoped_lock( mutex_ );
+
+    auto text = std::string{ };
+    for ( auto const& [ name, family ] : families_ )
+    {
+        static constexpr auto type_names = std::array{ "counter", "gauge", "histogram" };
+
+        text += fmt::format( "# HELP {} {}\n", name, escape( family.help, false ) );
+        text += fmt::format( "# TYPE {} {}\n", name, type_names[ family.type ] );
+
+        for ( auto const& [ labels, metric ] : family.metrics )
+        {
+            utils::visit(
+                utils::Visitor{
+                    [ & ]( Counter const& counter )
+                    {
+                        text += fmt::format(
+                            "{}{} {}\n",
+                            name,
+                            format_labels( labels ),
+                            counter.value( )
+                        );
+                    },
+                    [ & ]( Gauge const& gauge )
+                    {
+                        text += fmt::format(
+                            "{}{} {}\n",
+                            name,
+                            format_labels( labels ),
+                            format_value( gauge.value( ) )
+                        );
+                    },
+                    [ & ]( Histogram const& histogram )
+                    {
+                        auto const& bounds     = histogram.upper_bounds( );
+                        auto const  counts     = histogram.bucket_counts( );
+                        auto        cumulative = uint64{ 0U };
+
+                        for ( auto i = 0UZ; i < counts.size( ); ++i )
+                        {
+                            cumulative += counts[ i ];
+
+                            auto const bound = ( i < bounds.size( ) )
+                                                 ? format_value( bounds[ i ] )
+                                                 : std::string{ "+Inf" };
+                            text += fmt::format(
+                                "{}_bucket{} {}\n",
+                                name,
+                                format_labels( labels, fmt::format( "le=\"{}\"", bound ) ),
+                                cumulative
+                            );
+                        }
+                        text += fmt::format(
+                            "{}_sum{} {}\n",
+                            name,
+                            format_labels( labels ),
+                            format_value( histogram.sum( ) )
+                        );
+                        text += fmt::format(
+                            "{}_count{} {}\n",
+                            name,
+                            format_labels( labels ),
+                            cumulative
+                        );
+                    },
+                },
+                *metric
+            );
+        }
+    }
+    return text;
+}
+
+auto MetricsRegistry::write_prometheus_file( std::filesystem::path const& file ) const
+    -> utils::Result< void >
+{
+    auto temporary_file = file;
+    temporary_file += ".tmp";
+
+    {
+        auto stream = std::ofstream( temporary_file, std::ios::trunc );
+        if ( !stream.is_open( ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Failed to open metrics file '{}'",
+                temporary_file.string( )
+            );
+        }
+        stream << to_prometheus_text( );
+    }
+
+    auto error = std::error_code{ };
+    std::filesystem::rename( temporary_file, file, error );
+    if ( error )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Failed to replace metrics file '{}': {}",
+            file.string( ),
+            error.message( )
+        );
+    }
+    return utils::success( );
+}
+
+auto metrics( ) -> MetricsRegistry&
+{
+    static auto registry = MetricsRegistry{ };
+    return registry;
+}
+
+MetricsExporter::MetricsExporter(
+    MetricsRegistry const&  registry,
+    MetricsExporterSettings settings
+)
+    : registry_( registry )
+    , settings_( std::move( settings ) )
+{
+}
+
+MetricsExporter::~MetricsExporter( )
+{
+    stop( );
+}
+
+auto MetricsExporter::start( ) -> utils::Result< void >
+{
+    if ( is_running( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::InvalidState,
+            "Metrics exporter is already running"
+        );
+    }
+
+    if ( !settings_.unix_socket.empty( ) )
+    {
+#ifdef LTB_METRICS_HAS_UNIX_SOCKET
+        auto address       = sockaddr_un{ };
+        address.sun_family = AF_UNIX;
+
+        auto const path = settings_.unix_socket.string( );
+        if ( path.size( ) >= sizeof( address.sun_path ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR( "Metrics socket path '{}' is too long", path );
+        }
+        std::ranges::copy( path, std::begin( address.sun_path ) );
+
+        socket_fd_ = ::socket( AF_UNIX, SOCK_STREAM, 0 );
+        if ( socket_fd_ < 0 )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR( "Failed to create metrics socket" );
+        }
+
+        // Remove a socket left behind by a previous run.
+        ::unlink( path.c_str( ) );
+
+        auto* const socket_address = reinterpret_cast< sockaddr* >( &address );
+        if ( ( 0 != ::bind( socket_fd_, socket_address, sizeof( address ) ) )
+             || ( 0 != ::listen( socket_fd_, 4 ) ) )
+        {
+            ::close( std::exchange( socket_fd_, -1 ) );
+            return LTB_MAKE_UNEXPECTED_ERROR( "Failed to listen on metrics socket '{}'", path );
+        }
+        spdlog::info( "Serving metrics on unix socket '{}'", path );
+#else
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            ErrorCode::Unsupported,
+            "Unix socket metrics export is not supported here"
+        );
+#endif
+    }
+
+    if ( settings_.file.empty( ) && ( socket_fd_ < 0 ) )
+    {
+        return utils::success( );
+    }
+
+    thread_ = std::jthread( [ this ]( std::stop_token const& stop_token ) { run( stop_token ); } );
+    return utils::success( );
+}
+
+auto MetricsExporter::stop( ) -> void
+{
+    if ( thread_.joinable( ) )
+    {
+        thread_.request_stop( );
+        thread_.join( );
+    }
+
+#ifdef LTB_METRICS_HAS_UNIX_SOCKET
+    if ( socket_fd_ >= 0 )
+    {
+        ::close( std::exchange( socket_fd_, -1 ) );
+        ::unlink( settings_.unix_socket.string( ).c_str( ) );
+    }
+#endif
+}
+
+auto MetricsExporter::is_running( ) const -> bool
+{
+    return thread_.joinable( );
+}
+
+auto MetricsExporter::run( std::stop_token const& stop_token ) -> void
+{
+    auto const write_file = [ this ]
+    {
+        if ( auto result = registry_.write_prometheus_file( settings_.file ); !result )
+        {
+            spdlog::error( "{}", result.error( ).error_message( ) );
+        }
+    };
+
+    auto next_write = std::chrono::steady_clock::now( );
+
+    while ( !stop_token.stop_requested( ) )
+    {
+        auto const now = std::chrono::steady_clock::now( );
+        if ( !settings_.file.empty( ) && ( now >= next_write ) )
+        {
+            write_file( );
+            next_write = now + settings_.interval;
+        }
+
+#ifdef LTB_METRICS_HAS_UNIX_SOCKET
+        if ( socket_fd_ >= 0 )
+        {
+            auto descriptor = pollfd{ .fd = socket_fd_, .events = POLLIN, .revents = 0 };
+            if ( ::poll( &descriptor, 1, socket_poll_interval.count( ) ) > 0 )
+            {
+                serve_socket_client( );
+            }
+            continue;
+        }
+#endif
+        std::this_thread::sleep_for(
+            std::min< Duration >( socket_poll_interval, next_write - now )
+        );
+    }
+
+    // Leave the final values behind for one last scrape.
+    if ( !settings_.file.empty( ) )
+    {
+        write_file( );
+    }
+}
+
+auto MetricsExporter::serve_socket_client( ) const -> void
+{
+#ifdef LTB_METRICS_HAS_UNIX_SOCKET
+    auto const client = ::accept( socket_fd_, nullptr, nullptr );
+    if ( client < 0 )
+    {
+        return;
+    }
+
+    // Drain (and ignore) the request so clients that send one see a clean response.
+    auto descriptor = pollfd{ .fd = client, .events = POLLIN, .revents = 0 };
+    if ( ::poll( &descriptor, 1, socket_poll_interval.count( ) ) > 0 )
+    {
+        auto request = std::array< char, 4096 >{ };
+        utils::ignore( ::recv( client, request.data( ), request.size( ), 0 ) );
+    }
+
+    auto const body     = registry_.to_prometheus_text( );
+    auto const response = fmt::format(
+        "HTTP/1.0 200 OK\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: {}\r\n"
+        "\r\n"
+        "{}",
+        body.size( ),
+        body
+    );
+
+#ifdef MSG_NOSIGNAL
+    constexpr auto send_flags = MSG_NOSIGNAL;
+#else
+    constexpr auto send_flags = 0;
+#endif
+
+    auto sent = 0UZ;
+    while ( sent < response.size( ) )
+    {
+        auto const result
+            = ::send( client, response.data( ) + sent, response.size( ) - sent, send_flags );
+        if ( result <= 0 )
+        {
+            break;
+        }
+        sent += static_cast< std::size_t >( result );
+    }
+    ::close( client );
+#endif
+}
+
+} // namespace ltb::utils
@@ -0,0 +1,199 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "duration.hpp"
+#include "result.hpp"
+#include "types.hpp"
+
+// standard
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace ltb::utils
+{
+
+using MetricLabels = std::map< std::string, std::string >;
+
+/// \brief A monotonically increasing count. Updates are a single relaxed atomic add.
+class Counter
+{
+public:
+    auto add( uint64 amount = 1U ) -> void;
+
+    [[nodiscard( "Const getter" )]]
+    auto value( ) const -> uint64;
+
+private:
+    std::atomic< uint64 > value_ = 0U;
+};
+
+/// \brief A value that can go up and down. Updates are single relaxed atomic operations.
+class Gauge
+{
+public:
+    auto set( float64 value ) -> void;
+    auto add( float64 amount ) -> void;
+
+    [[nodiscard( "Const getter" )]]
+    auto value( ) const -> float64;
+
+private:
+    std::atomic< float64 > value_ = 0.0;
+};
+
+/// \brief A Prometheus-style histogram with fixed, cumulative-on-export bucket bounds.
+///        Observing a value is a binary search plus relaxed atomic adds.
+class Histogram
+{
+public:
+    /// \brief `upper_bounds` are sorted; an implicit +Inf bucket is added after them.
+    explicit Histogram( std::vector< float64 > upper_bounds );
+
+    auto observe( float64 value ) -> void;
+
+    [[nodiscard( "Const getter" )]]
+    auto upper_bounds( ) const -> std::vector< float64 > const&;
+
+    /// \brief Non-cumulative count for each bound followed by the +Inf bucket.
+    [[nodiscard( "Const getter" )]]
+    auto bucket_counts( ) const -> std::vector< uint64 >;
+
+    [[nodiscard( "Const getter" )]]
+    auto sum( ) const -> float64;
+
+private:
+    std::vector< float64 >                     upper_bounds_;
+    std::unique_ptr< std::atomic< uint64 >[] > counts_;
+    std::atomic< float64 >                     sum_ = 0.0;
+};
+
+/// \brief `count` bounds starting at `start`, each `factor` times the previous.
+auto exponential_buckets( float64 start, float64 factor, uint32 count ) -> std::vector< float64 >;
+
+/// \brief Owns every metric in the process. Looking a metric up takes a lock, so callers
+///        should look metrics up once and keep the returned reference, which stays valid
+///        for the registry's lifetime. Updating a metric is lock-free.
+class MetricsRegistry
+{
+public:
+    MetricsRegistry( ) = default;
+
+    // No copy or move. Handed-out references must stay valid.
+    MetricsRegistry( MetricsRegistry const& )                        = delete;
+    MetricsRegistry( MetricsRegistry&& ) noexcept                    = delete;
+    auto operator=( MetricsRegistry const& ) -> MetricsRegistry&     = delete;
+    auto operator=( MetricsRegistry&& ) noexcept -> MetricsRegistry& = delete;
+
+    /// \brief Returns the metric called `name` with `labels`, creating it if needed. Names
+    ///        should follow Prometheus conventions (`snake_case`, unit suffix, `_total` for
+    ///        counters). A name registered with a different metric type is logged and a
+    ///        detached metric that is never exported is returned.
+    auto counter( std::string const& name, std::string const& help, MetricLabels labels = { } )
+        -> Counter&;
+
+    auto gauge( std::string const& name, std::string const& help, MetricLabels labels = { } )
+        -> Gauge&;
+
+    /// \brief `upper_bounds` are only used when the histogram is created.
+    auto histogram(
+        std::string const&     name,
+        std::string const&     help,
+        std::vector< float64 > upper_bounds,
+        MetricLabels           labels = { }
+    ) -> Histogram&;
+
+    /// \brief Renders every metric in the Prometheus text exposition format.
+    [[nodiscard( "Const getter" )]]
+    auto to_prometheus_text( ) const -> std::string;
+
+    /// \brief Writes `to_prometheus_text()` to a temporary file and renames it over
+    ///        `file`, so scrapers such as node_exporter's textfile collector never see a
+    ///        partial file.
+    auto write_prometheus_file( std::filesystem::path const& file ) const
+        -> utils::Result< void >;
+
+private:
+    using Metric = std::variant< Counter, Gauge, Histogram >;
+
+    struct Family
+    {
+        std::string help = "";
+
+        /// \brief The `Metric` variant index shared by every metric in the family.
+        std::size_t type = 0UZ;
+
+        std::map< MetricLabels, std::unique_ptr< Metric > > metrics = { };
+    };
+
+    mutable std::mutex                       mutex_;
+    std::map< std::string, Family >          families_;
+    std::vector< std::unique_ptr< Metric > > detached_;
+
+    template < typename T, typename... Args >
+    auto get_or_create(
+        std::string const& name,
+        std::string const& help,
+        MetricLabels       labels,
+        Args&&... args
+    ) -> T&;
+};
+
+/// \brief The process-wide registry.
+auto metrics( ) -> MetricsRegistry&;
+
+struct MetricsExporterSettings
+{
+    /// \brief How often the Prometheus text file is rewritten.
+    Duration interval = duration_seconds( 5 );
+
+    /// \brief When set, metrics are periodically written here in the Prometheus text format.
+    std::filesystem::path file = { };
+
+    /// \brief When set, a Unix domain socket is served here. Each connection receives a
+    ///        minimal HTTP response with the current metrics, so it can be scraped with
+    ///        `curl --unix-socket <path> http://localhost/metrics`. POSIX only.
+    std::filesystem::path unix_socket = { };
+};
+
+/// \brief Exports a registry from a background thread until destroyed.
+class MetricsExporter
+{
+public:
+    explicit MetricsExporter( MetricsRegistry const& registry, MetricsExporterSettings settings );
+    ~MetricsExporter( );
+
+    // No copy or move. The export thread refers to this object.
+    MetricsExporter( MetricsExporter const& )                        = delete;
+    MetricsExporter( MetricsExporter&& ) noexcept                    = delete;
+    auto operator=( MetricsExporter const& ) -> MetricsExporter&     = delete;
+    auto operator=( MetricsExporter&& ) noexcept -> MetricsExporter& = delete;
+
+    /// \brief Starts exporting. Does nothing when neither a file nor a socket is set.
+    auto start( ) -> utils::Result< void >;
+    auto stop( ) -> void;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_running( ) const -> bool;
+
+private:
+    MetricsRegistry const&  registry_;
+    MetricsExporterSettings settings_;
+
+    int          socket_fd_ = -1;
+    std::jthread thread_    = { };
+
+    auto run( std::stop_token const& stop_token ) -> void;
+    auto serve_socket_client( ) const -> void;
+};
+
+} // namespace ltb::utils
@@ -0,0 +1,291 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "profiler.hpp"
+
+#include "lock_free_list.hpp"
+#include "tsc_clock.hpp"
+
+// external
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+// standard
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ltb::utils
+{
+namespace
+{
+
+auto next_thread_id( ) -> uint64
+{
+    static auto next_id = std::atomic< uint64 >{ 1U };
+    return next_id.fetch_add( 1U, std::memory_order_relaxed );
+}
+
+/// \brief Written only by its owning thread and read only by the collector, so the
+///        indices are the only synchronization needed.
+struct ThreadBuffer
+{
+    std::array< ProfileRecord, profiler_records_per_thread > records = { };
+
+    std::atomic< uint64 > write_index = 0U;
+    std::atomic< uint64 > read_index  = 0U;
+    std::atomic< uint64 > dropped     = 0U;
+
+    uint64 thread_id = next_thread_id( );
+
+    // Only touched when naming threads and exporting.
+    std::mutex  name_mutex = { };
+    std::string name       = { };
+
+    ThreadBuffer* next = nullptr;
+};
+
+using ThreadBufferList = LockFreeList< ThreadBuffer >;
+
+struct CollectedRecord
+{
+    uint64        thread_id = 0U;
+    ProfileRecord record    = { };
+};
+
+struct Collector
+{
+    std::mutex                     mutex   = { };
+    std::vector< CollectedRecord > records = { };
+};
+
+/// \brief Zones can be a few hundred nanoseconds long, so the profiler reads the TSC
+///        rather than paying for a steady_clock call at both ends of every zone.
+auto epoch( ) -> TscClock::time_point
+{
+    static auto const start = TscClock::now( );
+    return start;
+}
+
+auto buffer_list( ) -> ThreadBufferList&
+{
+    static auto list = ThreadBufferList{ };
+    return list;
+}
+
+auto collector( ) -> Collector&
+{
+    static auto instance = Collector{ };
+    return instance;
+}
+
+auto local_buffer( ) -> ThreadBuffer&
+{
+    thread_local auto* const buffer = buffer_list( ).push( std::make_unique< ThreadBuffer >( ) );
+    return *buffer;
+}
+
+thread_local auto profile_depth = uint32{ 0U };
+
+auto write_record( ProfileRecord const& record ) -> void
+{
+    auto& buffer = local_buffer( );
+
+    auto const write = buffer.write_index.load( std::memory_order_relaxed );
+    if ( ( write - buffer.read_index.load( std::memory_order_acquire ) )
+         >= profiler_records_per_thread )
+    {
+        buffer.dropped.fetch_add( 1U, std::memory_order_relaxed );
+        return;
+    }
+
+    buffer.records[ write % profiler_records_per_thread ] = record;
+    buffer.write_index.store( write + 1U, std::memory_order_release );
+}
+
+/// \brief Chrome trace timestamps are in (fractional) microseconds.
+auto to_trace_micros( int64 const nanoseconds ) -> double
+{
+    return static_cast< double >( nanoseconds ) / 1000.0;
+}
+
+} // namespace
+
+auto profiler_now( ) -> int64
+{
+    return ( TscClock::now( ) - epoch( ) ).count( );
+}
+
+auto record_profile_zone(
+    ProfileZone const* const zone,
+    int64 const              begin_ns,
+    uint32 const             depth,
+    AllocationCounts const&  allocations
+) -> void
+{
+    write_record( {
+        .zone            = zone,
+        .begin_ns        = begin_ns,
+        .end_ns          = profiler_now( ),
+        .depth           = depth,
+        .type            = ProfileRecordType::Zone,
+        .allocations     = allocations.allocations,
+        .allocated_bytes = allocations.allocated_bytes,
+    } );
+}
+
+auto mark_profile_frame( ProfileZone const* const zone ) -> void
+{
+    auto const now = profiler_now( );
+    write_record( {
+        .zone     = zone,
+        .begin_ns = now,
+        .end_ns   = now,
+        .depth    = 0U,
+        .type     = ProfileRecordType::Frame,
+    } );
+}
+
+auto set_profiler_thread_name( std::string name ) -> void
+{
+    auto& buffer = local_buffer( );
+
+    auto const lock = std::scoped_lock( buffer.name_mutex );
+    buffer.name     = std::move( name );
+}
+
+auto collect_profile_records( ) -> void
+{
+    auto& storage = collector( );
+
+    auto const lock = std::scoped_lock( storage.mutex );
+    for ( auto* buffer = buffer_list( ).head( ); nullptr != buffer; buffer = buffer->next )
+    {
+        auto const read  = buffer->read_index.load( std::memory_order_relaxed );
+        auto const write = buffer->write_index.load( std::memory_order_acquire );
+
+        for ( auto index = read; index < write; ++index )
+        {
+            storage.records.emplace_back( CollectedRecord{
+                .thread_id = buffer->thread_id,
+                .record    = buffer->records[ index % profiler_records_per_thread ],
+            } );
+        }
+        buffer->read_index.store( write, std::memory_order_release );
+    }
+}
+
+auto write_chrome_trace( std::filesystem::path const& trace_file ) -> utils::Result< void >
+{
+    collect_profile_records( );
+
+    auto file = std::ofstream( trace_file );
+    if ( !file.is_open( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Failed to open trace file '{}'", trace_file.string( ) );
+    }
+
+    auto& storage = collector( );
+
+    auto const lock  = std::scoped_lock( storage.mutex );
+    auto       first = true;
+
+    auto const separator = [ &first ] { return std::exchange( first, false ) ? "\n" : ",\n"; };
+
+    file << R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+    for ( auto* buffer = buffer_list( ).head( ); nullptr != buffer; buffer = buffer->next )
+    {
+        auto const name_lock = std::scoped_lock( buffer->name_mutex );
+        if ( !buffer->name.empty( ) )
+        {
+            file << separator( )
+                 << fmt::format(
+                        R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},)"
+                        R"("args":{{"name":{}}}}})",
+                        buffer->thread_id,
+                        nlohmann::json( buffer->name ).dump( )
+                    );
+        }
+    }
+
+    for ( auto const& [ thread_id, record ] : storage.records )
+    {
+        auto const name = nlohmann::json( record.zone->name ).dump( );
+
+        if ( ProfileRecordType::Frame == record.type )
+        {
+            file << separator( )
+                 << fmt::format(
+                        R"({{"name":{},"ph":"i","s":"p","ts":{:.3f},"pid":1,"tid":{}}})",
+                        name,
+                        to_trace_micros( record.begin_ns ),
+                        thread_id
+                    );
+        }
+        else
+        {
+            file << separator( )
+                 << fmt::format(
+                        R"({{"name":{},"ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{})",
+                        name,
+                        to_trace_micros( record.begin_ns ),
+                        to_trace_micros( record.end_ns - record.begin_ns ),
+                        thread_id
+                    );
+            if ( record.allocations > 0U )
+            {
+                file << fmt::format(
+                    R"(,"args":{{"allocations":{},"allocated_bytes":{}}})",
+                    record.allocations,
+                    record.allocated_bytes
+                );
+            }
+            file << "}";
+        }
+    }
+
+    file << "\n]}\n";
+    storage.records.clear( );
+
+    if ( auto const dropped = dropped_profile_records( ); dropped > 0U )
+    {
+        spdlog::warn( "Profiler dropped {} records. Collect more often.", dropped );
+    }
+    return utils::success( );
+}
+
+auto dropped_profile_records( ) -> uint64
+{
+    auto total = uint64{ 0U };
+    for ( auto* buffer = buffer_list( ).head( ); nullptr != buffer; buffer = buffer->next )
+    {
+        total += buffer->dropped.load( std::memory_order_relaxed );
+    }
+    return total;
+}
+
+ProfileScope::ProfileScope( ProfileZone const* const zone )
+    : zone_( zone )
+    , begin_ns_( profiler_now( ) )
+    , depth_( profile_depth++ )
+    , begin_allocations_( thread_allocation_counts( ) )
+{
+}
+
+ProfileScope::~ProfileScope( )
+{
+    --profile_depth;
+    record_profile_zone(
+        zone_,
+        begin_ns_,
+        depth_,
+        thread_allocation_counts( ) - begin_allocations_
+    );
+}
+
+} // namespace ltb::utils
@@ -0,0 +1,134 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "allocation_tracker.hpp"
+#include "macro.hpp"
+#include "result.hpp"
+#include "types.hpp"
+
+// standard
+#include <filesystem>
+#include <string>
+
+namespace ltb::utils
+{
+
+/// \brief Describes a profiled scope. One is created statically per `LTB_PROFILE_SCOPE`.
+struct ProfileZone
+{
+    char const* name = "";
+    char const* file = "";
+    uint32      line = 0U;
+};
+
+enum class ProfileRecordType : uint8
+{
+    Zone,
+    Frame,
+};
+
+/// \brief A fixed-size record written by the thread that owns the buffer.
+struct ProfileRecord
+{
+    ProfileZone const* zone     = nullptr;
+    int64              begin_ns = 0;
+    int64              end_ns   = 0;
+    uint32             depth    = 0U;
+    ProfileRecordType  type     = ProfileRecordType::Zone;
+
+    /// \brief Allocations made on the thread while the zone was open, including nested
+    ///        zones. Always zero unless `LTB_TRACK_ALLOCATIONS` is enabled.
+    uint64 allocations     = 0U;
+    uint64 allocated_bytes = 0U;
+};
+
+/// \brief The number of records each thread can hold before they are collected.
+///        Records written to a full buffer are dropped and counted.
+constexpr auto profiler_records_per_thread = 1UZ << 15U;
+
+/// \brief Nanoseconds since the profiler's epoch.
+auto profiler_now( ) -> int64;
+
+/// \brief Records a completed zone in the calling thread's buffer. Lock-free and
+///        allocation-free except for the first call on each thread.
+auto record_profile_zone(
+    ProfileZone const*      zone,
+    int64                   begin_ns,
+    uint32                  depth,
+    AllocationCounts const& allocations = { }
+) -> void;
+
+/// \brief Marks the end of a frame on the calling thread.
+auto mark_profile_frame( ProfileZone const* zone ) -> void;
+
+/// \brief Names the calling thread in exported traces.
+auto set_profiler_thread_name( std::string name ) -> void;
+
+/// \brief Moves every thread's pending records into the exporter's storage.
+auto collect_profile_records( ) -> void;
+
+/// \brief Collects any pending records and writes every collected record as Chrome
+///        trace event JSON, which chrome://tracing and Perfetto can open. The written
+///        records are discarded so repeated calls produce consecutive segments.
+auto write_chrome_trace( std::filesystem::path const& trace_file ) -> utils::Result< void >;
+
+/// \brief The number of records dropped because a thread's buffer was full.
+auto dropped_profile_records( ) -> uint64;
+
+/// \brief Times its enclosing scope. Use `LTB_PROFILE_SCOPE` rather than this directly.
+class ProfileScope
+{
+public:
+    explicit ProfileScope( ProfileZone const* zone );
+    ~ProfileScope( );
+
+    ProfileScope( ProfileScope const& )                        = delete;
+    ProfileScope( ProfileScope&& ) noexcept                    = delete;
+    auto operator=( ProfileScope const& ) -> ProfileScope&     = delete;
+    auto operator=( ProfileScope&& ) noexcept -> ProfileScope& = delete;
+
+private:
+    ProfileZone const* zone_;
+    int64              begin_ns_;
+    uint32             depth_;
+    AllocationCounts   begin_allocations_;
+};
+
+} // namespace ltb::utils
+
+#ifdef LTB_ENABLE_PROFILER
+
+// Do not use this macro directly; use LTB_PROFILE_SCOPE instead.
+#define DETAIL_LTB_PROFILE_SCOPE( zone_name, scope_name, name )                                    \
+    static constexpr auto zone_name = ::ltb::utils::ProfileZone{ name, __FILE__, __LINE__ };       \
+    ::ltb::utils::ProfileScope const scope_name( &zone_name )
+
+/// \brief Records the time spent in the enclosing scope under `name`, a string literal.
+#define LTB_PROFILE_SCOPE( name )                                                                  \
+    DETAIL_LTB_PROFILE_SCOPE(                                                                      \
+        LTB_CONCAT( ltb_profile_zone_, __LINE__ ),                                                 \
+        LTB_CONCAT( ltb_profile_scope_, __LINE__ ),                                                \
+        name                                                                                       \
+    )
+
+/// \brief Marks the end of a frame named `name`, a string literal.
+#define LTB_PROFILE_FRAME( name )                                                                  \
+    do                                                                                             \
+    {                                                                                              \
+        static constexpr auto ltb_profile_frame_zone                                               \
+            = ::ltb::utils::ProfileZone{ name, __FILE__, __LINE__ };                               \
+        ::ltb::utils::mark_profile_frame( &ltb_profile_frame_zone );                               \
+    } while ( false )
+
+/// \brief Names the calling thread in exported traces.
+#define LTB_PROFILE_THREAD_NAME( name ) ::ltb::utils::set_profiler_thread_name( name )
+
+#else
+
+#define LTB_PROFILE_SCOPE( name ) static_cast< void >( 0 )
+#define LTB_PROFILE_FRAME( name ) static_cast< void >( 0 )
+#define LTB_PROFILE_THREAD_NAME( name ) static_cast< void >( 0 )
+
+#endif
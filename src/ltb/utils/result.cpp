@@ -1,14 +0,0 @@
-// ///////////////////////////////////////////////////////////////////////////////////////
-// A Logan Thomas Barnes project
-// ///////////////////////////////////////////////////////////////////////////////////////
-#include "result.hpp"
-
-namespace ltb::utils
-{
-
-auto success( ) -> Result< void >
-{
-    return { };
-}
-
-} // namespace ltb::utils
@@ -19,10 +19,15 @@ class [[nodiscard]] expected;
 // external
 #include <tl/expected.hpp>
 
+// standard
+#include <utility>
+
 // Macros to reduce typing when errors occur:
 
 #define LTB_MAKE_UNEXPECTED_ERROR( ... ) ::tl::make_unexpected( LTB_MAKE_ERROR( __VA_ARGS__ ) )
 #define LTB_MAKE_UNEXPECTED_WARNING( ... ) ::tl::make_unexpected( LTB_MAKE_WARNING( __VA_ARGS__ ) )
+#define LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE( code, ... )                                           \
+    ::tl::make_unexpected( LTB_MAKE_ERROR_WITH_CODE( code, __VA_ARGS__ ) )
 
 // Do not use this macro directly; use LTB_CHECK_VALID instead.
 #define DETAIL_LTB_CHECK_VALID1( var )                                                             \
@@ -78,13 +83,17 @@ class [[nodiscard]] expected;
         __VA_ARGS__                                                                                \
     ) )
 
+// Propagates the error of a failed result. Errors of temporaries are moved, while errors
+// of named results passed by the caller are copied so the caller's result is left intact.
+#define DETAIL_LTB_FORWARD_ERROR( result ) std::forward< decltype( result ) >( result ).error( )
+
 // Do not use this macro directly; use LTB_CHECK instead.
 #define DETAIL_LTB_CHECK1( unique_name, func )                                                     \
     do                                                                                             \
     {                                                                                              \
-        if ( auto unique_name = to_void( func ); /* check for error -> */ !unique_name )           \
+        if ( auto&& unique_name = ( func ); /* check for error -> */ !unique_name )                \
         {                                                                                          \
-            return tl::make_unexpected( unique_name.error( ) );                                    \
+            return ::tl::make_unexpected( DETAIL_LTB_FORWARD_ERROR( unique_name ) );               \
         }                                                                                          \
     } while ( false )
 
@@ -93,7 +102,7 @@ class [[nodiscard]] expected;
     auto&& unique_name = ( func );                                                                 \
     if ( !unique_name )                                                                            \
     {                                                                                              \
-        return tl::make_unexpected( unique_name.error( ) );                                        \
+        return ::tl::make_unexpected( DETAIL_LTB_FORWARD_ERROR( unique_name ) );                   \
     }                                                                                              \
     var = std::move( unique_name.value( ) )
 
@@ -109,9 +118,9 @@ class [[nodiscard]] expected;
 #define DETAIL_LTB_CHECK_OR1( unique_name, func, callback )                                        \
     do                                                                                             \
     {                                                                                              \
-        if ( auto unique_name = to_void( func ); /* check for error -> */ !unique_name )           \
+        if ( auto&& unique_name = ( func ); /* check for error -> */ !unique_name )                \
         {                                                                                          \
-            callback( unique_name.error( ) );                                                      \
+            callback( DETAIL_LTB_FORWARD_ERROR( unique_name ) );                                   \
         }                                                                                          \
     } while ( false )
 
@@ -120,7 +129,7 @@ class [[nodiscard]] expected;
     auto&& unique_name = ( func );                                                                 \
     if ( !unique_name )                                                                            \
     {                                                                                              \
-        callback( unique_name.error( ) );                                                          \
+        callback( DETAIL_LTB_FORWARD_ERROR( unique_name ) );                                       \
     }                                                                                              \
     var = std::move( unique_name.value( ) )
 
@@ -174,7 +183,11 @@ namespace ltb::utils
 template < typename T = void, typename E = ::ltb::utils::Error >
 using Result = tl::expected< T, E >;
 
-auto success( ) -> Result< void >;
+/// \brief Inline so returning success from a `Result< void >` function is just a store.
+inline auto success( ) -> Result< void >
+{
+    return { };
+}
 
 /// \brief A wrapper around `util::Result`s to show the result has
 ///        been handled and to suppress the related compiler warning.
@@ -190,11 +203,33 @@ auto to_void( utils::Result< void, E > const& result ) -> utils::Result< void >
     return result;
 }
 
+/// Convert a result to a void result, moving the error rather than copying it.
+template < typename E >
+auto to_void( utils::Result< void, E >&& result ) -> utils::Result< void >
+{
+    return std::move( result );
+}
+
 /// Convert a result to a void result
 template < typename T, typename E >
 auto to_void( utils::Result< T, E > const& result ) -> utils::Result< void >
 {
-    return result.map( []( auto const& ) {} );
+    if ( result )
+    {
+        return { };
+    }
+    return tl::make_unexpected( result.error( ) );
+}
+
+/// Convert a result to a void result, moving the error rather than copying it.
+template < typename T, typename E >
+auto to_void( utils::Result< T, E >&& result ) -> utils::Result< void >
+{
+    if ( result )
+    {
+        return { };
+    }
+    return tl::make_unexpected( std::move( result ).error( ) );
 }
 
 } // namespace ltb::utils
@@ -3,40 +3,12 @@
 // ///////////////////////////////////////////////////////////////////////////////////////
 #include "timers.hpp"
 
-// standard
-#include <iostream>
-
 namespace ltb::utils
 {
 
-Timer::Timer( )
-    : start_time_( std::chrono::steady_clock::now( ) )
-{
-}
-
-auto Timer::start( ) -> void
-{
-    start_time_ = std::chrono::steady_clock::now( );
-}
-
-auto Timer::duration_since_start( ) -> utils::Duration
-{
-    auto time_now = std::chrono::steady_clock::now( );
-    return time_now - start_time_;
-}
-
-ScopedTimer::ScopedTimer( Callback callback )
-    : callback_( std::move( callback ) )
-{
-    timer_.start( );
-}
-
-ScopedTimer::~ScopedTimer( )
-{
-    if ( callback_ )
-    {
-        callback_( timer_.duration_since_start( ) );
-    }
-}
+template class BasicTimer< std::chrono::steady_clock >;
+template class BasicTimer< TscClock >;
+template class BasicScopedTimer< std::chrono::steady_clock >;
+template class BasicScopedTimer< TscClock >;
 
 } // namespace ltb::utils
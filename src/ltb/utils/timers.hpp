@@ -5,6 +5,7 @@
 
 // project
 #include "duration.hpp"
+#include "tsc_clock.hpp"
 
 // external
 #include <spdlog/spdlog.h>
@@ -16,29 +17,67 @@
 namespace ltb::utils
 {
 
-class Timer
+/// \brief Measures elapsed time on `Clock`. Use `TscTimer` for very fine-grained timing.
+template < typename Clock = std::chrono::steady_clock >
+class BasicTimer
 {
 public:
-    Timer( );
+    BasicTimer( )
+        : start_time_( Clock::now( ) )
+    {
+    }
 
-    auto start( ) -> void;
-    auto duration_since_start( ) -> utils::Duration;
+    auto start( ) -> void { start_time_ = Clock::now( ); }
+
+    auto duration_since_start( ) -> utils::Duration
+    {
+        return std::chrono::duration_cast< utils::Duration >( Clock::now( ) - start_time_ );
+    }
 
 private:
-    std::chrono::time_point< std::chrono::steady_clock > start_time_;
+    typename Clock::time_point start_time_;
 };
 
-class ScopedTimer
+template < typename Clock = std::chrono::steady_clock >
+class BasicScopedTimer
 {
 public:
     using Callback = std::function< void( utils::Duration ) >;
 
-    explicit ScopedTimer( Callback callback );
-    ~ScopedTimer( );
+    explicit BasicScopedTimer( Callback callback )
+        : callback_( std::move( callback ) )
+    {
+        timer_.start( );
+    }
+
+    ~BasicScopedTimer( )
+    {
+        if ( callback_ )
+        {
+            callback_( timer_.duration_since_start( ) );
+        }
+    }
+
+    // No copy or move. The callback should run once, at the end of the original scope.
+    BasicScopedTimer( BasicScopedTimer const& )                        = delete;
+    BasicScopedTimer( BasicScopedTimer&& ) noexcept                    = delete;
+    auto operator=( BasicScopedTimer const& ) -> BasicScopedTimer&     = delete;
+    auto operator=( BasicScopedTimer&& ) noexcept -> BasicScopedTimer& = delete;
 
 private:
-    Timer    timer_;
-    Callback callback_;
+    BasicTimer< Clock > timer_;
+    Callback            callback_;
 };
 
+extern template class BasicTimer< std::chrono::steady_clock >;
+extern template class BasicTimer< TscClock >;
+extern template class BasicScopedTimer< std::chrono::steady_clock >;
+extern template class BasicScopedTimer< TscClock >;
+
+using Timer       = BasicTimer< >;
+using ScopedTimer = BasicScopedTimer< >;
+
+using TscTimer       = BasicTimer< TscClock >;
+using TscScopedTimer = BasicScopedTimer< TscClock >;
+
 } // namespace ltb::utils
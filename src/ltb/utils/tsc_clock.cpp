@@ -0,0 +1,147 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "tsc_clock.hpp"
+
+// standard
+#include <array>
+
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#define LTB_HAS_TSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace ltb::utils
+{
+namespace
+{
+
+/// \brief Long enough to measure the frequency to well under 0.1% on any host
+///        with a microsecond-resolution steady_clock.
+constexpr auto calibration_duration = std::chrono::milliseconds( 20 );
+
+auto steady_nanos( ) -> int64
+{
+    return std::chrono::duration_cast< std::chrono::nanoseconds >(
+               std::chrono::steady_clock::now( ).time_since_epoch( )
+    )
+        .count( );
+}
+
+#ifdef LTB_HAS_TSC
+
+/// \brief Returns {eax, ebx, ecx, edx} for `leaf`, or zeros when it isn't supported.
+auto cpuid( uint32 const leaf ) -> std::array< uint32, 4 >
+{
+    auto registers = std::array< uint32, 4 >{ };
+#ifdef _MSC_VER
+    auto values = std::array< int, 4 >{ };
+    ::__cpuid( values.data( ), static_cast< int >( leaf & 0x80000000U ) );
+    if ( static_cast< uint32 >( values[ 0 ] ) >= leaf )
+    {
+        ::__cpuid( values.data( ), static_cast< int >( leaf ) );
+        for ( auto i = 0UZ; i < registers.size( ); ++i )
+        {
+            registers[ i ] = static_cast< uint32 >( values[ i ] );
+        }
+    }
+#else
+    auto& [ eax, ebx, ecx, edx ] = registers;
+    if ( 0 == ::__get_cpuid( leaf, &eax, &ebx, &ecx, &edx ) )
+    {
+        registers = { };
+    }
+#endif
+    return registers;
+}
+
+auto read_tsc( bool const rdtscp ) -> uint64
+{
+    if ( rdtscp )
+    {
+        auto processor = 0U;
+        return ::__rdtscp( &processor );
+    }
+    return ::__rdtsc( );
+}
+
+#endif
+
+auto calibrate( ) -> TscCalibration
+{
+    auto calibration = TscCalibration{ };
+
+#ifdef LTB_HAS_TSC
+    constexpr auto invariant_tsc_bit = 1U << 8U;
+    constexpr auto rdtscp_bit        = 1U << 27U;
+
+    calibration.invariant = ( cpuid( 0x80000007U )[ 3 ] & invariant_tsc_bit ) != 0U;
+    calibration.rdtscp    = ( cpuid( 0x80000001U )[ 3 ] & rdtscp_bit ) != 0U;
+
+    if ( calibration.invariant )
+    {
+        auto const start_nanos = steady_nanos( );
+        auto const start_ticks = read_tsc( calibration.rdtscp );
+
+        auto end_nanos = start_nanos;
+        while ( ( end_nanos - start_nanos )
+                < std::chrono::nanoseconds( calibration_duration ).count( ) )
+        {
+            end_nanos = steady_nanos( );
+        }
+        auto const end_ticks = read_tsc( calibration.rdtscp );
+
+        auto const elapsed_ticks = static_cast< float64 >( end_ticks - start_ticks );
+        auto const elapsed_nanos = static_cast< float64 >( end_nanos - start_nanos );
+
+        calibration.ticks_per_second = elapsed_ticks * 1e9 / elapsed_nanos;
+        calibration.nanos_per_tick   = elapsed_nanos / elapsed_ticks;
+        calibration.base_ticks       = start_ticks;
+        calibration.base_nanos       = start_nanos;
+    }
+#endif
+
+    return calibration;
+}
+
+} // namespace
+
+auto tsc_calibration( ) -> TscCalibration const&
+{
+    static auto const calibration = calibrate( );
+    return calibration;
+}
+
+auto TscClock::now( ) noexcept -> time_point
+{
+#ifdef LTB_HAS_TSC
+    if ( auto const& calibration = tsc_calibration( ); calibration.invariant )
+    {
+        auto const ticks = read_tsc( calibration.rdtscp ) - calibration.base_ticks;
+        auto const nanos = static_cast< int64 >(
+            static_cast< float64 >( ticks ) * calibration.nanos_per_tick
+        );
+        return time_point( duration( calibration.base_nanos + nanos ) );
+    }
+#endif
+
+    return time_point( duration( steady_nanos( ) ) );
+}
+
+auto TscClock::ticks( ) noexcept -> uint64
+{
+#ifdef LTB_HAS_TSC
+    if ( auto const& calibration = tsc_calibration( ); calibration.invariant )
+    {
+        return read_tsc( calibration.rdtscp );
+    }
+#endif
+    return 0U;
+}
+
+} // namespace ltb::utils
@@ -0,0 +1,56 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "types.hpp"
+
+// standard
+#include <chrono>
+
+namespace ltb::utils
+{
+
+struct TscCalibration
+{
+    /// \brief False when the CPU has no invariant TSC (or isn't x86-64), in which case
+    ///        `TscClock` reads `std::chrono::steady_clock` instead.
+    bool invariant = false;
+
+    /// \brief Whether `rdtscp` is used, which waits for earlier instructions to finish.
+    bool rdtscp = false;
+
+    float64 ticks_per_second = 0.0;
+
+    /// \brief Converts ticks since `base_ticks` to nanoseconds.
+    float64 nanos_per_tick = 0.0;
+    uint64  base_ticks     = 0U;
+
+    /// \brief `steady_clock` nanoseconds at `base_ticks`, so both sources share an epoch.
+    int64 base_nanos = 0;
+};
+
+/// \brief Measures the TSC frequency against `steady_clock` over a short busy-wait.
+///        Runs once, on the first call to this or `TscClock::now( )`.
+auto tsc_calibration( ) -> TscCalibration const&;
+
+/// \brief A steady clock read from the CPU's time stamp counter, which avoids the
+///        vDSO call behind `steady_clock` for very fine-grained timing. Time points
+///        are comparable with `steady_clock` time points converted to nanoseconds.
+class TscClock
+{
+public:
+    using rep        = int64;
+    using period     = std::nano;
+    using duration   = std::chrono::duration< rep, period >;
+    using time_point = std::chrono::time_point< TscClock >;
+
+    static constexpr bool is_steady = true;
+
+    static auto now( ) noexcept -> time_point;
+
+    /// \brief The raw counter, or zero without an invariant TSC.
+    static auto ticks( ) noexcept -> uint64;
+};
+
+} // namespace ltb::utils
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <type_traits>
+#include <variant>
 
 namespace ltb::utils
 {
@@ -22,6 +23,14 @@ auto is_boolable( int ) -> decltype( !std::declval< T >( ), std::true_type{ } );
 template < typename >
 auto is_boolable( unsigned long ) -> std::false_type;
 
+template < typename T, typename... Ts >
+constexpr auto variant_index( ) -> std::size_t
+{
+    auto       index = 0UZ;
+    bool const found = ( ( std::is_same_v< T, Ts > ? true : ( ++index, false ) ) || ... );
+    return found ? index : std::variant_npos;
+}
+
 } // namespace detail
 
 template < typename T >
@@ -45,4 +54,17 @@ using is_optional = std::conjunction< is_dereferencable< T >, is_boolable< T > >
 template < typename T >
 constexpr auto is_optional_v = is_optional< T >::value;
 
+template < typename T, typename Variant >
+struct variant_index;
+
+/// \brief The index of `T` in `std::variant< Ts... >`, or `std::variant_npos`.
+template < typename T, typename... Ts >
+struct variant_index< T, std::variant< Ts... > >
+    : std::integral_constant< std::size_t, detail::variant_index< T, Ts... >( ) >
+{
+};
+
+template < typename T, typename Variant >
+constexpr auto variant_index_v = variant_index< T, Variant >::value;
+
 } // namespace ltb::utils
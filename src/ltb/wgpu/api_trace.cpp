@@ -0,0 +1,508 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/api_trace.hpp"
+
+// project
+#include "ltb/wgpu/string_view.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <type_traits>
+
+namespace ltb::wgpu
+{
+
+ApiTraceRecorder::ApiTraceRecorder( GpuMemoryTracker& memory_tracker )
+    : memory_tracker_( &memory_tracker )
+{
+}
+
+ApiTraceRecorder::~ApiTraceRecorder( )
+{
+    stop( );
+}
+
+auto ApiTraceRecorder::start( std::filesystem::path const& trace_file ) -> utils::Result< void >
+{
+    stop( );
+
+    file_ = std::ofstream( trace_file, std::ios::binary | std::ios::trunc );
+    if ( !file_.is_open( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Failed to open trace file '{}'", trace_file.string( ) );
+    }
+
+    object_ids_.clear( );
+    next_id_    = 1U;
+    incomplete_ = false;
+
+    file_.write( api_trace_magic.data( ), api_trace_magic.size( ) );
+    write( api_trace_version );
+
+    timer_.start( );
+    spdlog::info( "Recording WebGPU trace to '{}'", trace_file.string( ) );
+    return utils::success( );
+}
+
+auto ApiTraceRecorder::stop( ) -> void
+{
+    if ( !file_.is_open( ) )
+    {
+        return;
+    }
+    file_.close( );
+
+    if ( incomplete_ )
+    {
+        spdlog::warn( "WebGPU trace is incomplete and may not replay correctly" );
+    }
+}
+
+auto ApiTraceRecorder::is_recording( ) const -> bool
+{
+    return file_.is_open( );
+}
+
+auto ApiTraceRecorder::is_incomplete( ) const -> bool
+{
+    return incomplete_;
+}
+
+auto ApiTraceRecorder::create_buffer(
+    WGPUDevice const            device,
+    WGPUBufferDescriptor const& descriptor,
+    GpuMemoryCategory const     category
+) -> utils::Result< TrackedBuffer >
+{
+    LTB_CHECK( auto buffer, memory_tracker_->create_buffer( device, descriptor, category ) );
+    if ( is_recording( ) )
+    {
+        if ( descriptor.mappedAtCreation )
+        {
+            mark_incomplete( "buffers mapped at creation are not captured" );
+        }
+        begin_record( ApiTraceCommand::CreateBuffer );
+        write( add_object( buffer.get( ) ) );
+        write_string( descriptor.label );
+        write( static_cast< uint64 >( descriptor.usage ) );
+        write( descriptor.size );
+    }
+    return buffer;
+}
+
+auto ApiTraceRecorder::write_buffer(
+    WGPUQueue const   queue,
+    WGPUBuffer const  buffer,
+    uint64 const      offset,
+    void const* const data,
+    size_t const      size
+) -> void
+{
+    ::wgpuQueueWriteBuffer( queue, buffer, offset, data, size );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::WriteBuffer );
+        write( object_id( buffer ) );
+        write( offset );
+        write_bytes( data, size );
+    }
+}
+
+auto ApiTraceRecorder::create_shader_module(
+    WGPUDevice const                  device,
+    WGPUShaderModuleDescriptor const& descriptor
+) -> WGPUShaderModule
+{
+    auto* const shader = ::wgpuDeviceCreateShaderModule( device, &descriptor );
+    if ( is_recording( ) )
+    {
+        auto const* chain = descriptor.nextInChain;
+        while ( ( nullptr != chain ) && ( WGPUSType_ShaderSourceWGSL != chain->sType ) )
+        {
+            chain = chain->next;
+        }
+        if ( nullptr == chain )
+        {
+            mark_incomplete( "only WGSL shader modules are captured" );
+        }
+
+        begin_record( ApiTraceCommand::CreateShaderModule );
+        write( add_object( shader ) );
+        write_string( descriptor.label );
+        write_string(
+            ( nullptr == chain ) ? WGPUStringView{ }
+                                 : reinterpret_cast< WGPUShaderSourceWGSL const* >( chain )->code
+        );
+    }
+    return shader;
+}
+
+auto ApiTraceRecorder::create_bind_group_layout(
+    WGPUDevice const                     device,
+    WGPUBindGroupLayoutDescriptor const& descriptor
+) -> WGPUBindGroupLayout
+{
+    auto* const layout = ::wgpuDeviceCreateBindGroupLayout( device, &descriptor );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::CreateBindGroupLayout );
+        write( add_object( layout ) );
+        write_string( descriptor.label );
+        write( static_cast< uint64 >( descriptor.entryCount ) );
+
+        for ( auto const& entry : std::span( descriptor.entries, descriptor.entryCount ) )
+        {
+            if ( ( WGPUSamplerBindingType_BindingNotUsed != entry.sampler.type )
+                 || ( WGPUTextureSampleType_BindingNotUsed != entry.texture.sampleType )
+                 || ( WGPUStorageTextureAccess_BindingNotUsed != entry.storageTexture.access ) )
+            {
+                mark_incomplete( "only buffer bindings are captured" );
+            }
+            write( entry.binding );
+            write( static_cast< uint64 >( entry.visibility ) );
+            write( static_cast< uint32 >( entry.buffer.type ) );
+            write( static_cast< uint32 >( entry.buffer.hasDynamicOffset ) );
+            write( entry.buffer.minBindingSize );
+        }
+    }
+    return layout;
+}
+
+auto ApiTraceRecorder::create_pipeline_layout(
+    WGPUDevice const                    device,
+    WGPUPipelineLayoutDescriptor const& descriptor
+) -> WGPUPipelineLayout
+{
+    auto* const layout = ::wgpuDeviceCreatePipelineLayout( device, &descriptor );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::CreatePipelineLayout );
+        write( add_object( layout ) );
+        write_string( descriptor.label );
+        write( static_cast< uint64 >( descriptor.bindGroupLayoutCount ) );
+
+        for ( auto* const group_layout :
+              std::span( descriptor.bindGroupLayouts, descriptor.bindGroupLayoutCount ) )
+        {
+            write( object_id( group_layout ) );
+        }
+    }
+    return layout;
+}
+
+auto ApiTraceRecorder::create_compute_pipeline(
+    WGPUDevice const                     device,
+    WGPUComputePipelineDescriptor const& descriptor
+) -> WGPUComputePipeline
+{
+    auto* const pipeline = ::wgpuDeviceCreateComputePipeline( device, &descriptor );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::CreateComputePipeline );
+        write( add_object( pipeline ) );
+        write_string( descriptor.label );
+
+        // A null layout is recorded as zero, which replays as an automatic layout.
+        write( ( nullptr == descriptor.layout ) ? 0U : object_id( descriptor.layout ) );
+        write( object_id( descriptor.compute.module ) );
+        write_string( descriptor.compute.entryPoint );
+        write( static_cast< uint64 >( descriptor.compute.constantCount ) );
+
+        for ( auto const& constant :
+              std::span( descriptor.compute.constants, descriptor.compute.constantCount ) )
+        {
+            write_string( constant.key );
+            write( constant.value );
+        }
+    }
+    return pipeline;
+}
+
+auto ApiTraceRecorder::get_bind_group_layout(
+    WGPUComputePipeline const pipeline,
+    uint32 const              group_index
+) -> WGPUBindGroupLayout
+{
+    auto* const layout = ::wgpuComputePipelineGetBindGroupLayout( pipeline, group_index );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::GetBindGroupLayout );
+        write( add_object( layout ) );
+        write( object_id( pipeline ) );
+        write( group_index );
+    }
+    return layout;
+}
+
+auto ApiTraceRecorder::create_bind_group(
+    WGPUDevice const               device,
+    WGPUBindGroupDescriptor const& descriptor
+) -> WGPUBindGroup
+{
+    auto* const group = ::wgpuDeviceCreateBindGroup( device, &descriptor );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::CreateBindGroup );
+        write( add_object( group ) );
+        write_string( descriptor.label );
+        write( object_id( descriptor.layout ) );
+        write( static_cast< uint64 >( descriptor.entryCount ) );
+
+        for ( auto const& entry : std::span( descriptor.entries, descriptor.entryCount ) )
+        {
+            if ( nullptr == entry.buffer )
+            {
+                mark_incomplete( "only buffer bindings are captured" );
+            }
+            write( entry.binding );
+            write( ( nullptr == entry.buffer ) ? 0U : object_id( entry.buffer ) );
+            write( entry.offset );
+            write( entry.size );
+        }
+    }
+    return group;
+}
+
+auto ApiTraceRecorder::create_command_encoder( WGPUDevice const device ) -> WGPUCommandEncoder
+{
+    constexpr auto descriptor = WGPUCommandEncoderDescriptor{ };
+
+    auto* const encoder = ::wgpuDeviceCreateCommandEncoder( device, &descriptor );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::CreateCommandEncoder );
+        write( add_object( encoder ) );
+    }
+    return encoder;
+}
+
+auto ApiTraceRecorder::begin_compute_pass( WGPUCommandEncoder const encoder )
+    -> WGPUComputePassEncoder
+{
+    constexpr auto descriptor = WGPUComputePassDescriptor{ };
+
+    auto* const pass = ::wgpuCommandEncoderBeginComputePass( encoder, &descriptor );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::BeginComputePass );
+        write( add_object( pass ) );
+        write( object_id( encoder ) );
+    }
+    return pass;
+}
+
+auto ApiTraceRecorder::set_pipeline(
+    WGPUComputePassEncoder const pass,
+    WGPUComputePipeline const    pipeline
+) -> void
+{
+    ::wgpuComputePassEncoderSetPipeline( pass, pipeline );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::SetComputePipeline );
+        write( object_id( pass ) );
+        write( object_id( pipeline ) );
+    }
+}
+
+auto ApiTraceRecorder::set_bind_group(
+    WGPUComputePassEncoder const    pass,
+    uint32 const                    group_index,
+    WGPUBindGroup const             group,
+    std::span< uint32 const > const dynamic_offsets
+) -> void
+{
+    ::wgpuComputePassEncoderSetBindGroup(
+        pass,
+        group_index,
+        group,
+        dynamic_offsets.size( ),
+        dynamic_offsets.data( )
+    );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::SetComputeBindGroup );
+        write( object_id( pass ) );
+        write( group_index );
+        write( object_id( group ) );
+        write_bytes( dynamic_offsets.data( ), dynamic_offsets.size_bytes( ) );
+    }
+}
+
+auto ApiTraceRecorder::dispatch_workgroups(
+    WGPUComputePassEncoder const pass,
+    uint32 const                 x,
+    uint32 const                 y,
+    uint32 const                 z
+) -> void
+{
+    ::wgpuComputePassEncoderDispatchWorkgroups( pass, x, y, z );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::DispatchWorkgroups );
+        write( object_id( pass ) );
+        write( x );
+        write( y );
+        write( z );
+    }
+}
+
+auto ApiTraceRecorder::dispatch_workgroups_indirect(
+    WGPUComputePassEncoder const pass,
+    WGPUBuffer const             indirect_buffer,
+    uint64 const                 indirect_offset
+) -> void
+{
+    ::wgpuComputePassEncoderDispatchWorkgroupsIndirect( pass, indirect_buffer, indirect_offset );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::DispatchWorkgroupsIndirect );
+        write( object_id( pass ) );
+        write( object_id( indirect_buffer ) );
+        write( indirect_offset );
+    }
+}
+
+auto ApiTraceRecorder::end_pass( WGPUComputePassEncoder const pass ) -> void
+{
+    ::wgpuComputePassEncoderEnd( pass );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::EndComputePass );
+        write( object_id( pass ) );
+    }
+}
+
+auto ApiTraceRecorder::copy_buffer_to_buffer(
+    WGPUCommandEncoder const encoder,
+    WGPUBuffer const         source,
+    uint64 const             source_offset,
+    WGPUBuffer const         destination,
+    uint64 const             destination_offset,
+    uint64 const             size
+) -> void
+{
+    ::wgpuCommandEncoderCopyBufferToBuffer(
+        encoder,
+        source,
+        source_offset,
+        destination,
+        destination_offset,
+        size
+    );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::CopyBufferToBuffer );
+        write( object_id( encoder ) );
+        write( object_id( source ) );
+        write( source_offset );
+        write( object_id( destination ) );
+        write( destination_offset );
+        write( size );
+    }
+}
+
+auto ApiTraceRecorder::clear_buffer(
+    WGPUCommandEncoder const encoder,
+    WGPUBuffer const         buffer,
+    uint64 const             offset,
+    uint64 const             size
+) -> void
+{
+    ::wgpuCommandEncoderClearBuffer( encoder, buffer, offset, size );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::ClearBuffer );
+        write( object_id( encoder ) );
+        write( object_id( buffer ) );
+        write( offset );
+        write( size );
+    }
+}
+
+auto ApiTraceRecorder::finish( WGPUCommandEncoder const encoder ) -> WGPUCommandBuffer
+{
+    constexpr auto descriptor = WGPUCommandBufferDescriptor{ };
+
+    auto* const commands = ::wgpuCommandEncoderFinish( encoder, &descriptor );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::FinishCommandEncoder );
+        write( add_object( commands ) );
+        write( object_id( encoder ) );
+    }
+    return commands;
+}
+
+auto ApiTraceRecorder::submit(
+    WGPUQueue const                            queue,
+    std::span< WGPUCommandBuffer const > const commands
+) -> void
+{
+    ::wgpuQueueSubmit( queue, commands.size( ), commands.data( ) );
+    if ( is_recording( ) )
+    {
+        begin_record( ApiTraceCommand::QueueSubmit );
+        write( static_cast< uint64 >( commands.size( ) ) );
+        for ( auto* const command_buffer : commands )
+        {
+            write( object_id( command_buffer ) );
+        }
+    }
+}
+
+auto ApiTraceRecorder::add_object( void const* const object ) -> ApiTraceObjectId
+{
+    auto const id          = next_id_++;
+    object_ids_[ object ] = id;
+    return id;
+}
+
+auto ApiTraceRecorder::object_id( void const* const object ) -> ApiTraceObjectId
+{
+    if ( auto iter = object_ids_.find( object ); iter != object_ids_.end( ) )
+    {
+        return iter->second;
+    }
+    mark_incomplete( "an object was created outside of the recorder" );
+    return 0U;
+}
+
+auto ApiTraceRecorder::begin_record( ApiTraceCommand const command ) -> void
+{
+    write( command );
+    write( utils::to_nanos< uint64 >( timer_.duration_since_start( ) ) );
+}
+
+auto ApiTraceRecorder::mark_incomplete( std::string_view const reason ) -> void
+{
+    if ( !incomplete_ )
+    {
+        spdlog::warn( "WebGPU trace incomplete: {}", reason );
+    }
+    incomplete_ = true;
+}
+
+template < typename T >
+auto ApiTraceRecorder::write( T const& value ) -> void
+{
+    static_assert( std::is_trivially_copyable_v< T > );
+    file_.write( reinterpret_cast< char const* >( &value ), sizeof( T ) );
+}
+
+auto ApiTraceRecorder::write_bytes( void const* const data, uint64 const size ) -> void
+{
+    write( size );
+    file_.write( static_cast< char const* >( data ), static_cast< std::streamsize >( size ) );
+}
+
+auto ApiTraceRecorder::write_string( WGPUStringView const string ) -> void
+{
+    auto const view = to_string_view( string );
+    write_bytes( view.data( ), view.size( ) );
+}
+
+} // namespace ltb::wgpu
@@ -0,0 +1,196 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/timers.hpp"
+#include "ltb/utils/types.hpp"
+#include "ltb/wgpu/gpu_memory_tracker.hpp"
+
+// external
+#include <webgpu/webgpu.h>
+
+// standard
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+namespace ltb::wgpu
+{
+
+constexpr auto api_trace_magic   = std::array{ 'L', 'T', 'B', 'T', 'R', 'A', 'C', 'E' };
+constexpr auto api_trace_version = uint32{ 1U };
+
+/// \brief Objects are referred to by these IDs in a trace. Zero means "no object".
+using ApiTraceObjectId = uint32;
+
+/// \brief The record types of a trace. Each record starts with the command and a
+///        nanosecond timestamp relative to the start of the recording.
+enum class ApiTraceCommand : uint8
+{
+    CreateBuffer,
+    WriteBuffer,
+    CreateShaderModule,
+    CreateBindGroupLayout,
+    CreatePipelineLayout,
+    CreateComputePipeline,
+    GetBindGroupLayout,
+    CreateBindGroup,
+    CreateCommandEncoder,
+    BeginComputePass,
+    SetComputePipeline,
+    SetComputeBindGroup,
+    DispatchWorkgroups,
+    DispatchWorkgroupsIndirect,
+    EndComputePass,
+    CopyBufferToBuffer,
+    ClearBuffer,
+    FinishCommandEncoder,
+    QueueSubmit,
+};
+
+/// \brief Forwards compute and transfer calls to WebGPU and, while recording, writes them
+///        with any buffer contents to a compact binary trace that `replay_api_trace` runs.
+///
+/// Render passes and textures are not captured. Resources created outside of the
+/// recorder are recorded as missing (ID zero) and the trace is flagged as incomplete.
+/// Buffers are created through the memory tracker so they count against its budget.
+///
+/// \code
+/// auto& trace = app.api_trace( );
+/// LTB_CHECK( trace.start( "frame.ltbtrace" ) );
+///
+/// LTB_CHECK( auto data, trace.create_buffer( device, descriptor, GpuMemoryCategory::Storage ) );
+/// auto* const encoder = trace.create_command_encoder( device );
+/// auto* const pass    = trace.begin_compute_pass( encoder );
+/// trace.set_pipeline( pass, pipeline );
+/// trace.dispatch_workgroups( pass, 64U, 1U, 1U );
+/// \endcode
+class ApiTraceRecorder
+{
+public:
+    explicit ApiTraceRecorder( GpuMemoryTracker& memory_tracker );
+    ~ApiTraceRecorder( );
+
+    // No copy or move. Objects are identified by their address.
+    ApiTraceRecorder( ApiTraceRecorder const& )                        = delete;
+    ApiTraceRecorder( ApiTraceRecorder&& ) noexcept                    = delete;
+    auto operator=( ApiTraceRecorder const& ) -> ApiTraceRecorder&     = delete;
+    auto operator=( ApiTraceRecorder&& ) noexcept -> ApiTraceRecorder& = delete;
+
+    auto start( std::filesystem::path const& trace_file ) -> utils::Result< void >;
+    auto stop( ) -> void;
+
+    [[nodiscard( "Const getter" )]] auto is_recording( ) const -> bool;
+
+    /// \brief True if a call used an object or feature the trace cannot represent.
+    [[nodiscard( "Const getter" )]] auto is_incomplete( ) const -> bool;
+
+    auto create_buffer(
+        WGPUDevice                  device,
+        WGPUBufferDescriptor const& descriptor,
+        GpuMemoryCategory           category
+    ) -> utils::Result< TrackedBuffer >;
+
+    auto write_buffer(
+        WGPUQueue   queue,
+        WGPUBuffer  buffer,
+        uint64      offset,
+        void const* data,
+        size_t      size
+    ) -> void;
+
+    /// \brief Only WGSL sources are captured.
+    auto create_shader_module( WGPUDevice device, WGPUShaderModuleDescriptor const& descriptor )
+        -> WGPUShaderModule;
+
+    /// \brief Only buffer bindings are captured.
+    auto create_bind_group_layout(
+        WGPUDevice                           device,
+        WGPUBindGroupLayoutDescriptor const& descriptor
+    ) -> WGPUBindGroupLayout;
+
+    auto create_pipeline_layout(
+        WGPUDevice                          device,
+        WGPUPipelineLayoutDescriptor const& descriptor
+    ) -> WGPUPipelineLayout;
+
+    auto create_compute_pipeline(
+        WGPUDevice                           device,
+        WGPUComputePipelineDescriptor const& descriptor
+    ) -> WGPUComputePipeline;
+
+    /// \brief Records layouts taken from pipelines created with an automatic layout.
+    auto get_bind_group_layout( WGPUComputePipeline pipeline, uint32 group_index )
+        -> WGPUBindGroupLayout;
+
+    auto create_bind_group( WGPUDevice device, WGPUBindGroupDescriptor const& descriptor )
+        -> WGPUBindGroup;
+
+    auto create_command_encoder( WGPUDevice device ) -> WGPUCommandEncoder;
+
+    auto begin_compute_pass( WGPUCommandEncoder encoder ) -> WGPUComputePassEncoder;
+
+    auto set_pipeline( WGPUComputePassEncoder pass, WGPUComputePipeline pipeline ) -> void;
+
+    auto set_bind_group(
+        WGPUComputePassEncoder    pass,
+        uint32                    group_index,
+        WGPUBindGroup             group,
+        std::span< uint32 const > dynamic_offsets = { }
+    ) -> void;
+
+    auto dispatch_workgroups( WGPUComputePassEncoder pass, uint32 x, uint32 y, uint32 z )
+        -> void;
+
+    auto dispatch_workgroups_indirect(
+        WGPUComputePassEncoder pass,
+        WGPUBuffer             indirect_buffer,
+        uint64                 indirect_offset
+    ) -> void;
+
+    auto end_pass( WGPUComputePassEncoder pass ) -> void;
+
+    auto copy_buffer_to_buffer(
+        WGPUCommandEncoder encoder,
+        WGPUBuffer         source,
+        uint64             source_offset,
+        WGPUBuffer         destination,
+        uint64             destination_offset,
+        uint64             size
+    ) -> void;
+
+    auto clear_buffer( WGPUCommandEncoder encoder, WGPUBuffer buffer, uint64 offset, uint64 size )
+        -> void;
+
+    auto finish( WGPUCommandEncoder encoder ) -> WGPUCommandBuffer;
+
+    auto submit( WGPUQueue queue, std::span< WGPUCommandBuffer const > commands ) -> void;
+
+private:
+    GpuMemoryTracker*                                   memory_tracker_;
+    std::ofstream                                       file_       = { };
+    utils::Timer                                        timer_      = { };
+    std::unordered_map< void const*, ApiTraceObjectId > object_ids_ = { };
+    ApiTraceObjectId                                    next_id_    = 1U;
+    bool                                                incomplete_ = false;
+
+    /// \brief Assigns a new ID. Addresses can be reused once an object is released.
+    auto add_object( void const* object ) -> ApiTraceObjectId;
+    auto object_id( void const* object ) -> ApiTraceObjectId;
+
+    auto begin_record( ApiTraceCommand command ) -> void;
+    auto mark_incomplete( std::string_view reason ) -> void;
+
+    template < typename T >
+    auto write( T const& value ) -> void;
+    auto write_bytes( void const* data, uint64 size ) -> void;
+    auto write_string( WGPUStringView string ) -> void;
+};
+
+} // namespace ltb::wgpu
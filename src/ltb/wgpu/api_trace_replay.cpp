@@ -0,0 +1,639 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/api_trace_replay.hpp"
+
+// project
+#include "ltb/utils/mapped_file.hpp"
+#include "ltb/utils/timers.hpp"
+#include "ltb/wgpu/api_trace.hpp"
+#include "ltb/wgpu/gpu_memory_tracker.hpp"
+#include "ltb/wgpu/handle.hpp"
+#include "ltb/wgpu/queue_utils.hpp"
+#include "ltb/wgpu/string_view.hpp"
+
+// standard
+#include <cstring>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ltb::wgpu
+{
+namespace
+{
+
+class TraceReader
+{
+public:
+    explicit TraceReader( std::span< char const > data )
+        : data_( data )
+    {
+    }
+
+    [[nodiscard]] auto at_end( ) const -> bool { return offset_ >= data_.size( ); }
+
+    template < typename T >
+    auto read( ) -> utils::Result< T >
+    {
+        static_assert( std::is_trivially_copyable_v< T > );
+        LTB_CHECK( auto const bytes, take( sizeof( T ) ) );
+
+        auto value = T{ };
+        std::memcpy( &value, bytes.data( ), sizeof( T ) );
+        return value;
+    }
+
+    auto read_bytes( ) -> utils::Result< std::span< char const > >
+    {
+        LTB_CHECK( auto const size, read< uint64 >( ) );
+        return take( size );
+    }
+
+    auto read_string( ) -> utils::Result< std::string_view >
+    {
+        LTB_CHECK( auto const bytes, read_bytes( ) );
+        return std::string_view( bytes.data( ), bytes.size( ) );
+    }
+
+private:
+    std::span< char const > data_;
+    size_t                  offset_ = 0UZ;
+
+    auto take( uint64 const size ) -> utils::Result< std::span< char const > >
+    {
+        if ( size > ( data_.size( ) - offset_ ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+                utils::ErrorCode::InvalidData,
+                "Trace truncated at byte {}",
+                offset_
+            );
+        }
+        auto const bytes  = data_.subspan( offset_, size );
+        offset_          += size;
+        return bytes;
+    }
+};
+
+template < typename Impl >
+using ObjectMap = std::unordered_map< ApiTraceObjectId, Handle< Impl > >;
+
+/// \brief Buffers are tracked so replays count against the memory budget.
+using BufferMap = std::unordered_map< ApiTraceObjectId, TrackedBuffer >;
+
+template < typename Object >
+auto find_object(
+    std::unordered_map< ApiTraceObjectId, Object > const& objects,
+    ApiTraceObjectId const                                id
+) -> utils::Result< decltype( objects.begin( )->second.get( ) ) >
+{
+    if ( auto iter = objects.find( id ); iter != objects.end( ) )
+    {
+        return iter->second.get( );
+    }
+    return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+        utils::ErrorCode::InvalidData,
+        "Trace references unknown object {}",
+        id
+    );
+}
+
+class Replayer
+{
+public:
+    Replayer(
+        GpuMemoryTracker&             memory_tracker,
+        WGPUDevice const              device,
+        WGPUQueue const               queue,
+        std::span< char const > const data
+    )
+        : memory_tracker_( memory_tracker )
+        , device_( device )
+        , queue_( queue )
+        , reader_( data )
+    {
+    }
+
+    auto replay( ApiTraceReplaySettings const& settings, ApiTraceReplayStats& stats )
+        -> utils::Result< void >
+    {
+        auto timer = utils::Timer{ };
+
+        while ( !reader_.at_end( ) )
+        {
+            LTB_CHECK( auto const command, reader_.read< ApiTraceCommand >( ) );
+            LTB_CHECK( auto const timestamp, reader_.read< uint64 >( ) );
+
+            auto const recorded_time = utils::duration_nanos( timestamp );
+            if ( ApiTraceReplayTiming::Original == settings.timing )
+            {
+                if ( auto const now = timer.duration_since_start( ); now < recorded_time )
+                {
+                    std::this_thread::sleep_for( recorded_time - now );
+                }
+            }
+
+            LTB_CHECK( replay_command( command, stats ) );
+
+            ++stats.command_count;
+            stats.recorded_duration = recorded_time;
+        }
+
+        return utils::success( );
+    }
+
+private:
+    GpuMemoryTracker& memory_tracker_;
+    WGPUDevice        device_;
+    WGPUQueue         queue_;
+    TraceReader       reader_;
+
+    BufferMap                               buffers_            = { };
+    ObjectMap< WGPUShaderModuleImpl >       shader_modules_     = { };
+    ObjectMap< WGPUBindGroupLayoutImpl >    bind_group_layouts_ = { };
+    ObjectMap< WGPUPipelineLayoutImpl >     pipeline_layouts_   = { };
+    ObjectMap< WGPUComputePipelineImpl >    compute_pipelines_  = { };
+    ObjectMap< WGPUBindGroupImpl >          bind_groups_        = { };
+    ObjectMap< WGPUCommandEncoderImpl >     command_encoders_   = { };
+    ObjectMap< WGPUComputePassEncoderImpl > compute_passes_     = { };
+    ObjectMap< WGPUCommandBufferImpl >      command_buffers_    = { };
+
+    auto replay_command( ApiTraceCommand const command, ApiTraceReplayStats& stats )
+        -> utils::Result< void >
+    {
+        switch ( command )
+        {
+            case ApiTraceCommand::CreateBuffer:
+                return create_buffer( );
+            case ApiTraceCommand::WriteBuffer:
+                return write_buffer( stats );
+            case ApiTraceCommand::CreateShaderModule:
+                return create_shader_module( );
+            case ApiTraceCommand::CreateBindGroupLayout:
+                return create_bind_group_layout( );
+            case ApiTraceCommand::CreatePipelineLayout:
+                return create_pipeline_layout( );
+            case ApiTraceCommand::CreateComputePipeline:
+                return create_compute_pipeline( );
+            case ApiTraceCommand::GetBindGroupLayout:
+                return get_bind_group_layout( );
+            case ApiTraceCommand::CreateBindGroup:
+                return create_bind_group( );
+            case ApiTraceCommand::CreateCommandEncoder:
+                return create_command_encoder( );
+            case ApiTraceCommand::BeginComputePass:
+                return begin_compute_pass( );
+            case ApiTraceCommand::SetComputePipeline:
+                return set_pipeline( );
+            case ApiTraceCommand::SetComputeBindGroup:
+                return set_bind_group( );
+            case ApiTraceCommand::DispatchWorkgroups:
+                return dispatch_workgroups( );
+            case ApiTraceCommand::DispatchWorkgroupsIndirect:
+                return dispatch_workgroups_indirect( );
+            case ApiTraceCommand::EndComputePass:
+                return end_pass( );
+            case ApiTraceCommand::CopyBufferToBuffer:
+                return copy_buffer_to_buffer( );
+            case ApiTraceCommand::ClearBuffer:
+                return clear_buffer( );
+            case ApiTraceCommand::FinishCommandEncoder:
+                return finish( );
+            case ApiTraceCommand::QueueSubmit:
+                ++stats.submit_count;
+                return submit( );
+        }
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            utils::ErrorCode::InvalidData,
+            "Unknown trace command {}",
+            static_cast< uint32 >( std::to_underlying( command ) )
+        );
+    }
+
+    auto create_buffer( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const label, reader_.read_string( ) );
+        LTB_CHECK( auto const usage, reader_.read< uint64 >( ) );
+        LTB_CHECK( auto const size, reader_.read< uint64 >( ) );
+
+        auto const descriptor = WGPUBufferDescriptor{
+            .nextInChain      = nullptr,
+            .label            = to_wgpu_string_view( label ),
+            .usage            = static_cast< WGPUBufferUsage >( usage ),
+            .size             = size,
+            .mappedAtCreation = false,
+        };
+        auto const category = buffer_category( descriptor.usage );
+        LTB_CHECK( buffers_[ id ], memory_tracker_.create_buffer( device_, descriptor, category ) );
+        return utils::success( );
+    }
+
+    auto write_buffer( ApiTraceReplayStats& stats ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const offset, reader_.read< uint64 >( ) );
+        LTB_CHECK( auto const bytes, reader_.read_bytes( ) );
+        LTB_CHECK( auto* const buffer, find_object( buffers_, id ) );
+
+        ::wgpuQueueWriteBuffer( queue_, buffer, offset, bytes.data( ), bytes.size( ) );
+        stats.bytes_written += bytes.size( );
+        return utils::success( );
+    }
+
+    auto create_shader_module( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const label, reader_.read_string( ) );
+        LTB_CHECK( auto const code, reader_.read_string( ) );
+
+        auto const wgsl = WGPUShaderSourceWGSL{
+            .chain = { .next = nullptr, .sType = WGPUSType_ShaderSourceWGSL },
+            .code  = to_wgpu_string_view( code ),
+        };
+        auto const descriptor = WGPUShaderModuleDescriptor{
+            .nextInChain = &wgsl.chain,
+            .label       = to_wgpu_string_view( label ),
+        };
+        shader_modules_[ id ].reset( ::wgpuDeviceCreateShaderModule( device_, &descriptor ) );
+        return utils::success( );
+    }
+
+    auto create_bind_group_layout( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const label, reader_.read_string( ) );
+        LTB_CHECK( auto const entry_count, reader_.read< uint64 >( ) );
+
+        auto entries = std::vector< WGPUBindGroupLayoutEntry >{ };
+        for ( auto i = 0UZ; i < entry_count; ++i )
+        {
+            LTB_CHECK( auto const binding, reader_.read< uint32 >( ) );
+            LTB_CHECK( auto const visibility, reader_.read< uint64 >( ) );
+            LTB_CHECK( auto const type, reader_.read< uint32 >( ) );
+            LTB_CHECK( auto const has_dynamic_offset, reader_.read< uint32 >( ) );
+            LTB_CHECK( auto const min_binding_size, reader_.read< uint64 >( ) );
+
+            entries.emplace_back( WGPUBindGroupLayoutEntry{
+                .nextInChain = nullptr,
+                .binding     = binding,
+                .visibility  = static_cast< WGPUShaderStage >( visibility ),
+                .buffer      = {
+                    .nextInChain      = nullptr,
+                    .type             = static_cast< WGPUBufferBindingType >( type ),
+                    .hasDynamicOffset = static_cast< WGPUBool >( has_dynamic_offset ),
+                    .minBindingSize   = min_binding_size,
+                },
+            } );
+        }
+
+        auto const descriptor = WGPUBindGroupLayoutDescriptor{
+            .nextInChain = nullptr,
+            .label       = to_wgpu_string_view( label ),
+            .entryCount  = entries.size( ),
+            .entries     = entries.data( ),
+        };
+        bind_group_layouts_[ id ].reset(
+            ::wgpuDeviceCreateBindGroupLayout( device_, &descriptor )
+        );
+        return utils::success( );
+    }
+
+    auto create_pipeline_layout( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const label, reader_.read_string( ) );
+        LTB_CHECK( auto const layout_count, reader_.read< uint64 >( ) );
+
+        auto layouts = std::vector< WGPUBindGroupLayout >{ };
+        for ( auto i = 0UZ; i < layout_count; ++i )
+        {
+            LTB_CHECK( auto const layout_id, reader_.read< ApiTraceObjectId >( ) );
+            LTB_CHECK( auto* const layout, find_object( bind_group_layouts_, layout_id ) );
+            layouts.emplace_back( layout );
+        }
+
+        auto const descriptor = WGPUPipelineLayoutDescriptor{
+            .nextInChain          = nullptr,
+            .label                = to_wgpu_string_view( label ),
+            .bindGroupLayoutCount = layouts.size( ),
+            .bindGroupLayouts     = layouts.data( ),
+        };
+        pipeline_layouts_[ id ].reset( ::wgpuDeviceCreatePipelineLayout( device_, &descriptor ) );
+        return utils::success( );
+    }
+
+    auto create_compute_pipeline( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const label, reader_.read_string( ) );
+        LTB_CHECK( auto const layout_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const module_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const entry_point, reader_.read_string( ) );
+        LTB_CHECK( auto const constant_count, reader_.read< uint64 >( ) );
+
+        auto constants = std::vector< WGPUConstantEntry >{ };
+        for ( auto i = 0UZ; i < constant_count; ++i )
+        {
+            LTB_CHECK( auto const key, reader_.read_string( ) );
+            LTB_CHECK( auto const value, reader_.read< double >( ) );
+            constants.emplace_back( WGPUConstantEntry{
+                .nextInChain = nullptr,
+                .key         = to_wgpu_string_view( key ),
+                .value       = value,
+            } );
+        }
+
+        auto layout = WGPUPipelineLayout{ nullptr };
+        if ( 0U != layout_id )
+        {
+            LTB_CHECK( layout, find_object( pipeline_layouts_, layout_id ) );
+        }
+        LTB_CHECK( auto* const module, find_object( shader_modules_, module_id ) );
+
+        auto const descriptor = WGPUComputePipelineDescriptor{
+            .nextInChain = nullptr,
+            .label       = to_wgpu_string_view( label ),
+            .layout      = layout,
+            .compute     = {
+                .nextInChain   = nullptr,
+                .module        = module,
+                .entryPoint    = to_wgpu_string_view( entry_point ),
+                .constantCount = constants.size( ),
+                .constants     = constants.data( ),
+            },
+        };
+        compute_pipelines_[ id ].reset( ::wgpuDeviceCreateComputePipeline( device_, &descriptor ) );
+        return utils::success( );
+    }
+
+    auto get_bind_group_layout( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const pipeline_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const group_index, reader_.read< uint32 >( ) );
+        LTB_CHECK( auto* const pipeline, find_object( compute_pipelines_, pipeline_id ) );
+
+        bind_group_layouts_[ id ].reset(
+            ::wgpuComputePipelineGetBindGroupLayout( pipeline, group_index )
+        );
+        return utils::success( );
+    }
+
+    auto create_bind_group( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const label, reader_.read_string( ) );
+        LTB_CHECK( auto const layout_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const entry_count, reader_.read< uint64 >( ) );
+        LTB_CHECK( auto* const layout, find_object( bind_group_layouts_, layout_id ) );
+
+        auto entries = std::vector< WGPUBindGroupEntry >{ };
+        for ( auto i = 0UZ; i < entry_count; ++i )
+        {
+            LTB_CHECK( auto const binding, reader_.read< uint32 >( ) );
+            LTB_CHECK( auto const buffer_id, reader_.read< ApiTraceObjectId >( ) );
+            LTB_CHECK( auto const offset, reader_.read< uint64 >( ) );
+            LTB_CHECK( auto const size, reader_.read< uint64 >( ) );
+            LTB_CHECK( auto* const buffer, find_object( buffers_, buffer_id ) );
+
+            entries.emplace_back( WGPUBindGroupEntry{
+                .nextInChain = nullptr,
+                .binding     = binding,
+                .buffer      = buffer,
+                .offset      = offset,
+                .size        = size,
+                .sampler     = nullptr,
+                .textureView = nullptr,
+            } );
+        }
+
+        auto const descriptor = WGPUBindGroupDescriptor{
+            .nextInChain = nullptr,
+            .label       = to_wgpu_string_view( label ),
+            .layout      = layout,
+            .entryCount  = entries.size( ),
+            .entries     = entries.data( ),
+        };
+        bind_groups_[ id ].reset( ::wgpuDeviceCreateBindGroup( device_, &descriptor ) );
+        return utils::success( );
+    }
+
+    auto create_command_encoder( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+
+        constexpr auto descriptor = WGPUCommandEncoderDescriptor{ };
+        command_encoders_[ id ].reset( ::wgpuDeviceCreateCommandEncoder( device_, &descriptor ) );
+        return utils::success( );
+    }
+
+    auto begin_compute_pass( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const encoder_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto* const encoder, find_object( command_encoders_, encoder_id ) );
+
+        constexpr auto descriptor = WGPUComputePassDescriptor{ };
+        compute_passes_[ id ].reset( ::wgpuCommandEncoderBeginComputePass( encoder, &descriptor ) );
+        return utils::success( );
+    }
+
+    auto set_pipeline( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const pass_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const pipeline_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto* const pass, find_object( compute_passes_, pass_id ) );
+        LTB_CHECK( auto* const pipeline, find_object( compute_pipelines_, pipeline_id ) );
+
+        ::wgpuComputePassEncoderSetPipeline( pass, pipeline );
+        return utils::success( );
+    }
+
+    auto set_bind_group( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const pass_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const group_index, reader_.read< uint32 >( ) );
+        LTB_CHECK( auto const group_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const offset_bytes, reader_.read_bytes( ) );
+        LTB_CHECK( auto* const pass, find_object( compute_passes_, pass_id ) );
+        LTB_CHECK( auto* const group, find_object( bind_groups_, group_id ) );
+
+        // Copied since the trace data has no alignment guarantees.
+        auto offsets = std::vector< uint32 >( offset_bytes.size( ) / sizeof( uint32 ) );
+        std::memcpy( offsets.data( ), offset_bytes.data( ), offsets.size( ) * sizeof( uint32 ) );
+
+        ::wgpuComputePassEncoderSetBindGroup(
+            pass,
+            group_index,
+            group,
+            offsets.size( ),
+            offsets.data( )
+        );
+        return utils::success( );
+    }
+
+    auto dispatch_workgroups( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const pass_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const x, reader_.read< uint32 >( ) );
+        LTB_CHECK( auto const y, reader_.read< uint32 >( ) );
+        LTB_CHECK( auto const z, reader_.read< uint32 >( ) );
+        LTB_CHECK( auto* const pass, find_object( compute_passes_, pass_id ) );
+
+        ::wgpuComputePassEncoderDispatchWorkgroups( pass, x, y, z );
+        return utils::success( );
+    }
+
+    auto dispatch_workgroups_indirect( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const pass_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const buffer_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const offset, reader_.read< uint64 >( ) );
+        LTB_CHECK( auto* const pass, find_object( compute_passes_, pass_id ) );
+        LTB_CHECK( auto* const buffer, find_object( buffers_, buffer_id ) );
+
+        ::wgpuComputePassEncoderDispatchWorkgroupsIndirect( pass, buffer, offset );
+        return utils::success( );
+    }
+
+    auto end_pass( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const pass_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto* const pass, find_object( compute_passes_, pass_id ) );
+
+        ::wgpuComputePassEncoderEnd( pass );
+        compute_passes_.erase( pass_id );
+        return utils::success( );
+    }
+
+    auto copy_buffer_to_buffer( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const encoder_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const source_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const source_offset, reader_.read< uint64 >( ) );
+        LTB_CHECK( auto const destination_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const destination_offset, reader_.read< uint64 >( ) );
+        LTB_CHECK( auto const size, reader_.read< uint64 >( ) );
+        LTB_CHECK( auto* const encoder, find_object( command_encoders_, encoder_id ) );
+        LTB_CHECK( auto* const source, find_object( buffers_, source_id ) );
+        LTB_CHECK( auto* const destination, find_object( buffers_, destination_id ) );
+
+        ::wgpuCommandEncoderCopyBufferToBuffer(
+            encoder,
+            source,
+            source_offset,
+            destination,
+            destination_offset,
+            size
+        );
+        return utils::success( );
+    }
+
+    auto clear_buffer( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const encoder_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const buffer_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const offset, reader_.read< uint64 >( ) );
+        LTB_CHECK( auto const size, reader_.read< uint64 >( ) );
+        LTB_CHECK( auto* const encoder, find_object( command_encoders_, encoder_id ) );
+        LTB_CHECK( auto* const buffer, find_object( buffers_, buffer_id ) );
+
+        ::wgpuCommandEncoderClearBuffer( encoder, buffer, offset, size );
+        return utils::success( );
+    }
+
+    auto finish( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto const encoder_id, reader_.read< ApiTraceObjectId >( ) );
+        LTB_CHECK( auto* const encoder, find_object( command_encoders_, encoder_id ) );
+
+        constexpr auto descriptor = WGPUCommandBufferDescriptor{ };
+        command_buffers_[ id ].reset( ::wgpuCommandEncoderFinish( encoder, &descriptor ) );
+        command_encoders_.erase( encoder_id );
+        return utils::success( );
+    }
+
+    auto submit( ) -> utils::Result< void >
+    {
+        LTB_CHECK( auto const count, reader_.read< uint64 >( ) );
+
+        auto ids      = std::vector< ApiTraceObjectId >{ };
+        auto commands = std::vector< WGPUCommandBuffer >{ };
+        for ( auto i = 0UZ; i < count; ++i )
+        {
+            LTB_CHECK( auto const id, reader_.read< ApiTraceObjectId >( ) );
+            LTB_CHECK( auto* const command_buffer, find_object( command_buffers_, id ) );
+            ids.emplace_back( id );
+            commands.emplace_back( command_buffer );
+        }
+
+        ::wgpuQueueSubmit( queue_, commands.size( ), commands.data( ) );
+
+        // Command buffers can only be submitted once.
+        for ( auto const id : ids )
+        {
+            command_buffers_.erase( id );
+        }
+        return utils::success( );
+    }
+};
+
+} // namespace
+
+auto replay_api_trace(
+    std::filesystem::path const&  trace_file,
+    WGPUInstance const            instance,
+    WGPUDevice const              device,
+    WGPUQueue const               queue,
+    GpuMemoryTracker&             memory_tracker,
+    ApiTraceReplaySettings const& settings
+) -> utils::Result< ApiTraceReplayStats >
+{
+    LTB_CHECK_VALID( device );
+    LTB_CHECK_VALID( queue );
+
+    // Commands are replayed straight from the mapping, so the trace is never copied.
+    LTB_CHECK(
+        auto const mapping,
+        utils::map_file( trace_file, { .access = utils::MappedFileAccess::Sequential } )
+    );
+    auto const data = mapping.as_span< char >( );
+
+    auto header = TraceReader{ data };
+    for ( auto const expected : api_trace_magic )
+    {
+        LTB_CHECK( auto const actual, header.read< char >( ) );
+        LTB_CHECK_VALID( expected == actual, "Not an LTB WebGPU trace" );
+    }
+    LTB_CHECK( auto const version, header.read< uint32 >( ) );
+    if ( api_trace_version != version )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            utils::ErrorCode::Unsupported,
+            "Unsupported trace version {} (expected {})",
+            version,
+            api_trace_version
+        );
+    }
+
+    auto const header_size = api_trace_magic.size( ) + sizeof( uint32 );
+    auto       replayer    = Replayer{ memory_tracker, device, queue, data.subspan( header_size ) };
+    auto       stats       = ApiTraceReplayStats{ };
+
+    auto timer = utils::Timer{ };
+    LTB_CHECK( replayer.replay( settings, stats ) );
+    stats.cpu_duration = timer.duration_since_start( );
+
+    LTB_CHECK( wait_for_queue( instance, queue ) );
+    stats.total_duration = timer.duration_since_start( );
+
+    return stats;
+}
+
+} // namespace ltb::wgpu
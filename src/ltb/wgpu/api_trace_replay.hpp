@@ -0,0 +1,62 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/duration.hpp"
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+#include "ltb/wgpu/gpu_memory_tracker.hpp"
+
+// external
+#include <webgpu/webgpu.h>
+
+// standard
+#include <filesystem>
+
+namespace ltb::wgpu
+{
+
+enum class ApiTraceReplayTiming
+{
+    /// \brief Issue every call back-to-back to measure the CPU cost of the workload.
+    AsFastAsPossible,
+
+    /// \brief Wait until each call's recorded timestamp before issuing it.
+    Original,
+};
+
+struct ApiTraceReplaySettings
+{
+    ApiTraceReplayTiming timing = ApiTraceReplayTiming::AsFastAsPossible;
+};
+
+struct ApiTraceReplayStats
+{
+    uint64 command_count = 0U;
+    uint64 submit_count  = 0U;
+    uint64 bytes_written = 0U;
+
+    /// \brief The time spent issuing calls, excluding the final wait for the GPU.
+    utils::Duration cpu_duration = { };
+
+    /// \brief The time until all submitted work finished on the GPU.
+    utils::Duration total_duration = { };
+
+    /// \brief The timestamp of the last recorded call.
+    utils::Duration recorded_duration = { };
+};
+
+/// \brief Re-executes a trace written by ApiTraceRecorder on the given device. Buffers are
+///        created through `memory_tracker` and released when the replay finishes.
+auto replay_api_trace(
+    std::filesystem::path const&  trace_file,
+    WGPUInstance                  instance,
+    WGPUDevice                    device,
+    WGPUQueue                     queue,
+    GpuMemoryTracker&             memory_tracker,
+    ApiTraceReplaySettings const& settings
+) -> utils::Result< ApiTraceReplayStats >;
+
+} // namespace ltb::wgpu
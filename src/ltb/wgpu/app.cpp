@@ -4,13 +4,18 @@
 #include "ltb/wgpu/app.hpp"
 
 // project
+#include "ltb/utils/logging.hpp"
+#include "ltb/utils/profiler.hpp"
 #include "ltb/wgpu/enum_strings.hpp"
+#include "ltb/wgpu/string_view.hpp"
+#include "ltb/wgpu/wgpu_metrics.hpp"
 
 // external
 #include <magic_enum.hpp>
 
 // standard
 #include <algorithm>
+#include <vector>
 
 namespace ltb::wgpu
 {
@@ -28,7 +33,9 @@ auto device_lost_callback(
     utils::ignore( userdata1 );
     utils::ignore( userdata2 );
 
-    spdlog::warn(
+    add_to( wgpu_metrics( ).device_losses, reason );
+
+    LTB_LOG_WARN(
         "WebGPU device ({}) lost ({}): {}",
         fmt::ptr( device ),
         magic_enum::enum_name( reason ),
@@ -44,76 +51,15 @@ auto error_callback(
     void* const             userdata2
 ) -> void
 {
-    utils::ignore( userdata1 );
+    utils::ignore( device );
     utils::ignore( userdata2 );
 
-    spdlog::error(
-        "WebGPU device ({}) uncaught error ({}): {}",
-        fmt::ptr( device ),
-        magic_enum::enum_name( type ),
-        message.data
-    );
-}
-
-struct DestroyInstance
-{
-    auto operator( )( WGPUInstanceImpl* const instance ) const -> void
-    {
-        if ( instance )
-        {
-            spdlog::info( "Destroying WGPU instance: {}", fmt::ptr( instance ) );
-            ::wgpuInstanceRelease( instance );
-        }
-    }
-};
-
-struct DestroySurface
-{
-    auto operator( )( WGPUSurfaceImpl* const surface ) const -> void
-    {
-        if ( surface )
-        {
-            spdlog::info( "Destroying WGPU surface: {}", fmt::ptr( surface ) );
-            ::wgpuSurfaceRelease( surface );
-        }
-    }
-};
-
-struct DestroyAdapter
-{
-    auto operator( )( WGPUAdapterImpl* const adapter ) const -> void
-    {
-        if ( adapter )
-        {
-            spdlog::info( "Destroying WGPU adapter: {}", fmt::ptr( adapter ) );
-            ::wgpuAdapterRelease( adapter );
-        }
-    }
-};
-
-struct DestroyDevice
-{
-    auto operator( )( WGPUDeviceImpl* const device ) const -> void
-    {
-        if ( device )
-        {
-            spdlog::info( "Destroying WGPU device: {}", fmt::ptr( device ) );
-            ::wgpuDeviceRelease( device );
-        }
-    }
-};
+    add_to( wgpu_metrics( ).uncaptured_errors, type );
 
-struct DestroyQueue
-{
-    auto operator( )( WGPUQueueImpl* const queue ) const -> void
-    {
-        if ( queue )
-        {
-            spdlog::info( "Destroying WGPU queue: {}", fmt::ptr( queue ) );
-            ::wgpuQueueRelease( queue );
-        }
-    }
-};
+    // Errors raised every frame are only logged once, then summarized.
+    auto* reporter = static_cast< ErrorReporter* >( userdata1 );
+    reporter->report( uncaptured_error_source, type, to_string_view( message ) );
+}
 
 } // namespace
 
@@ -124,23 +70,34 @@ App::App( )
 
 App::App( AppSettings app_settings )
     : app_callback_( std::move( app_settings.callback ) )
+    , performance_profile_( app_settings.performance_profile )
+    , memory_tracker_( { .budget_bytes = app_settings.gpu_memory_budget_bytes } )
+    , force_fallback_adapter_( app_settings.force_fallback_adapter )
+    , api_trace_file_( std::move( app_settings.api_trace_file ) )
+    , api_trace_( memory_tracker_ )
+    , metrics_exporter_( utils::metrics( ), std::move( app_settings.metrics_export ) )
+    , error_reporter_( std::move( app_settings.error_reporting ) )
     , window_( app_settings.window )
 {
 }
 
 auto App::run( ) -> void
 {
+    if ( auto result = metrics_exporter_.start( ); !result )
+    {
+        LTB_LOG_ERROR( "{}", result.error( ).error_message( ) );
+    }
 
     constexpr auto descriptor = WGPUInstanceDescriptor{ };
 
     if ( auto* instance = ::wgpuCreateInstance( &descriptor ) )
     {
-        spdlog::info( "WGPU instance: {}", fmt::ptr( instance ) );
-        instance_ = std::shared_ptr< WGPUInstanceImpl >( instance, DestroyInstance{ } );
+        LTB_LOG_INFO( "WGPU instance: {}", fmt::ptr( instance ) );
+        instance_ = InstanceHandle{ instance };
     }
     else
     {
-        spdlog::error( "Could not initialize WebGPU!" );
+        LTB_LOG_ERROR( "Could not initialize WebGPU!" );
         return;
     }
 
@@ -148,22 +105,22 @@ auto App::run( ) -> void
     {
         if ( auto result = window_->initialize( ) )
         {
-            spdlog::info( "OsWindow: {}", fmt::ptr( window_ ) );
+            LTB_LOG_INFO( "OsWindow: {}", fmt::ptr( window_ ) );
         }
         else
         {
-            spdlog::error( "Failed to initialize window: {}", result.error( ).error_message( ) );
+            LTB_LOG_ERROR( "Failed to initialize window: {}", result.error( ).error_message( ) );
             return;
         }
 
         if ( auto* surface = window_->get_surface( instance_.get( ) ) )
         {
-            spdlog::info( "WGPU surface: {}", fmt::ptr( surface ) );
-            surface_ = std::shared_ptr< WGPUSurfaceImpl >( surface, DestroySurface{ } );
+            LTB_LOG_INFO( "WGPU surface: {}", fmt::ptr( surface ) );
+            surface_ = SurfaceHandle{ surface };
         }
         else
         {
-            spdlog::error( "Failed to get surface from window" );
+            LTB_LOG_ERROR( "Failed to get surface from window" );
             return;
         }
     }
@@ -172,7 +129,7 @@ auto App::run( ) -> void
         .nextInChain          = nullptr,
         .featureLevel         = WGPUFeatureLevel_Undefined,
         .powerPreference      = WGPUPowerPreference_Undefined,
-        .forceFallbackAdapter = false,
+        .forceFallbackAdapter = force_fallback_adapter_,
         .backendType          = WGPUBackendType_Undefined,
         .compatibleSurface    = surface_.get( ),
     };
@@ -193,10 +150,47 @@ auto App::run( ) -> void
 
 auto App::process( ) -> void
 {
+    LTB_PROFILE_SCOPE( "App::process" );
     if ( instance_ )
     {
         ::wgpuInstanceProcessEvents( instance_.get( ) );
     }
+    error_reporter_.summarize_if_due( );
+}
+
+auto App::instance( ) const -> WGPUInstance
+{
+    return instance_.get( );
+}
+
+auto App::adapter( ) const -> WGPUAdapter
+{
+    return adapter_.get( );
+}
+
+auto App::device( ) const -> WGPUDevice
+{
+    return device_.get( );
+}
+
+auto App::queue( ) const -> WGPUQueue
+{
+    return queue_.get( );
+}
+
+auto App::memory_tracker( ) -> GpuMemoryTracker&
+{
+    return memory_tracker_;
+}
+
+auto App::api_trace( ) -> ApiTraceRecorder&
+{
+    return api_trace_;
+}
+
+auto App::error_reporter( ) -> ErrorReporter&
+{
+    return error_reporter_;
 }
 
 auto App::handle_adapter(
@@ -211,21 +205,21 @@ auto App::handle_adapter(
 
     if ( WGPURequestAdapterStatus_Success != status )
     {
-        spdlog::error( "Could not get WebGPU adapter: {}", message.data );
+        LTB_LOG_ERROR( "Could not get WebGPU adapter: {}", message.data );
         return;
     }
 
     // Manipulate user data
     auto* app = static_cast< App* >( userdata1 );
 
-    spdlog::info( "WebGPU adapter: {}", fmt::ptr( adapter ) );
-    app->adapter_ = std::shared_ptr< WGPUAdapterImpl >( adapter, DestroyAdapter{ } );
+    LTB_LOG_INFO( "WebGPU adapter: {}", fmt::ptr( adapter ) );
+    app->adapter_ = AdapterHandle{ adapter };
 
     auto limits = WGPULimits{ };
 
     if ( WGPUStatus_Success == ::wgpuAdapterGetLimits( adapter, &limits ) )
     {
-        spdlog::info(
+        LTB_LOG_INFO(
             "Adapter limits:\n"
             " - maxTextureDimensions1D: {}\n"
             " - maxTextureDimensions2D: {}\n"
@@ -241,18 +235,18 @@ auto App::handle_adapter(
     auto features = WGPUSupportedFeatures{ };
     ::wgpuAdapterGetFeatures( adapter, &features );
 
-    spdlog::info( "Adapter features ({}):", features.featureCount );
+    LTB_LOG_INFO( "Adapter features ({}):", features.featureCount );
     for ( auto i = 0UL; i < features.featureCount; ++i )
     {
         auto const& feature = features.features[ i ];
-        spdlog::info( " - {} ({:x})", to_string( feature ), std::to_underlying( feature ) );
+        LTB_LOG_INFO( " - {} ({:x})", to_string( feature ), std::to_underlying( feature ) );
     }
     ::wgpuSupportedFeaturesFreeMembers( features );
 
     auto info = WGPUAdapterInfo{ };
     if ( WGPUStatus_Success == ::wgpuAdapterGetInfo( adapter, &info ) )
     {
-        spdlog::info(
+        LTB_LOG_INFO(
             "Adapter info:\n"
             " - vendorID: {}\n"
             " - vendor: {}\n"
@@ -269,14 +263,57 @@ auto App::handle_adapter(
             magic_enum::enum_name( info.adapterType ),
             magic_enum::enum_name( info.backendType )
         );
+
+        // The info pattern: a constant gauge whose labels carry the values.
+        utils::metrics( )
+            .gauge(
+                "ltb_wgpu_adapter_info",
+                "The WebGPU adapter in use",
+                {
+                    { "vendor", std::string( to_string_view( info.vendor ) ) },
+                    { "architecture", std::string( to_string_view( info.architecture ) ) },
+                    { "description", std::string( to_string_view( info.description ) ) },
+                    { "adapter_type", std::string( magic_enum::enum_name( info.adapterType ) ) },
+                    { "backend_type", std::string( magic_enum::enum_name( info.backendType ) ) },
+                }
+            )
+            .set( 1.0 );
     }
     ::wgpuAdapterInfoFreeMembers( info );
 
-    constexpr auto descriptor = WGPUDeviceDescriptor{
-        .nextInChain          = nullptr,
+    // Optional features used by rendering paths when the adapter supports them.
+    auto required_features = std::vector< WGPUFeatureName >{ };
+    if ( ::wgpuAdapterHasFeature( adapter, WGPUFeatureName_IndirectFirstInstance ) )
+    {
+        required_features.emplace_back( WGPUFeatureName_IndirectFirstInstance );
+    }
+
+    auto const toggles = device_toggles( app->performance_profile_ );
+
+    LTB_LOG_INFO( "Performance profile: {}", magic_enum::enum_name( app->performance_profile_ ) );
+    for ( auto const* toggle : toggles.enabled )
+    {
+        LTB_LOG_INFO( " - enabled toggle: {}", toggle );
+    }
+    for ( auto const* toggle : toggles.disabled )
+    {
+        LTB_LOG_INFO( " - disabled toggle: {}", toggle );
+    }
+
+    auto toggles_descriptor = WGPUDawnTogglesDescriptor{
+        .chain               = { .next = nullptr, .sType = WGPUSType_DawnTogglesDescriptor },
+        .enabledToggleCount  = toggles.enabled.size( ),
+        .enabledToggles      = toggles.enabled.data( ),
+        .disabledToggleCount = toggles.disabled.size( ),
+        .disabledToggles     = toggles.disabled.data( ),
+    };
+    auto const has_toggles = !toggles.enabled.empty( ) || !toggles.disabled.empty( );
+
+    auto const descriptor = WGPUDeviceDescriptor{
+        .nextInChain          = has_toggles ? &toggles_descriptor.chain : nullptr,
         .label                = { },
-        .requiredFeatureCount = 0UZ,
-        .requiredFeatures     = nullptr,
+        .requiredFeatureCount = required_features.size( ),
+        .requiredFeatures     = required_features.data( ),
         .requiredLimits       = nullptr,
         .defaultQueue         = { },
         .deviceLostCallbackInfo
@@ -288,7 +325,7 @@ auto App::handle_adapter(
         .uncapturedErrorCallbackInfo
         = { .nextInChain = nullptr,
             .callback    = error_callback,
-            .userdata1   = nullptr,
+            .userdata1   = &app->error_reporter_,
             .userdata2   = nullptr },
     };
     utils::ignore(
@@ -318,20 +355,20 @@ auto App::handle_device(
 
     if ( WGPURequestDeviceStatus_Success != status )
     {
-        spdlog::error( "Could not get WebGPU device: {}", message.data );
+        LTB_LOG_ERROR( "Could not get WebGPU device: {}", message.data );
         return;
     }
 
     // Manipulate user data
     auto* app = static_cast< App* >( userdata1 );
 
-    spdlog::info( "WebGPU device: {}", fmt::ptr( device ) );
-    app->device_ = std::shared_ptr< WGPUDeviceImpl >( device, DestroyDevice{ } );
+    LTB_LOG_INFO( "WebGPU device: {}", fmt::ptr( device ) );
+    app->device_ = DeviceHandle{ device };
 
     auto limits = WGPULimits{ };
     if ( WGPUStatus_Success == ::wgpuDeviceGetLimits( device, &limits ) )
     {
-        spdlog::info(
+        LTB_LOG_INFO(
             "Device limits:\n"
             " - maxTextureDimensions1D: {}\n"
             " - maxTextureDimensions2D: {}\n"
@@ -342,51 +379,88 @@ auto App::handle_device(
             limits.maxTextureDimension3D,
             limits.maxTextureArrayLayers
         );
+
+        auto const set_limit = []( char const* const limit, auto const value )
+        {
+            utils::metrics( )
+                .gauge( "ltb_wgpu_device_limit", "WebGPU device limits", { { "limit", limit } } )
+                .set( static_cast< float64 >( value ) );
+        };
+        set_limit( "maxTextureDimension2D", limits.maxTextureDimension2D );
+        set_limit( "maxBufferSize", limits.maxBufferSize );
+        set_limit( "maxStorageBufferBindingSize", limits.maxStorageBufferBindingSize );
+        set_limit( "maxComputeWorkgroupsPerDimension", limits.maxComputeWorkgroupsPerDimension );
     }
 
     if ( auto* queue = ::wgpuDeviceGetQueue( device ) )
     {
-        spdlog::info( "WebGPU queue: {}", fmt::ptr( queue ) );
-        app->queue_ = std::shared_ptr< WGPUQueueImpl >( queue, DestroyQueue{ } );
+        LTB_LOG_INFO( "WebGPU queue: {}", fmt::ptr( queue ) );
+        app->queue_ = QueueHandle{ queue };
     }
     else
     {
-        spdlog::error( "Could not get WebGPU queue" );
+        LTB_LOG_ERROR( "Could not get WebGPU queue" );
         return;
     }
 
-    auto capabilities = WGPUSurfaceCapabilities{ };
-    if ( WGPUStatus_Success
-         == ::wgpuSurfaceGetCapabilities(
-             app->surface_.get( ),
-             app->adapter_.get( ),
-             &capabilities
-         ) )
+    if ( !app->api_trace_file_.empty( ) )
     {
-        spdlog::info( "Surface formats" );
-        for ( auto i = 0UZ; i < capabilities.formatCount; ++i )
+        if ( auto result = app->api_trace_.start( app->api_trace_file_ ); !result )
         {
-            spdlog::info( " - {}", to_string( capabilities.formats[ i ] ) );
+            LTB_LOG_ERROR( "{}", result.error( ).error_message( ) );
         }
     }
-    else
+
+    if ( app->surface_ )
     {
-        spdlog::error( "Could not get WebGPU surface capabilities" );
-        return;
+        if ( auto result = app->configure_surface( ); !result )
+        {
+            LTB_LOG_ERROR( "{}", result.error( ).error_message( ) );
+            return;
+        }
+    }
+
+    if ( app->app_callback_ )
+    {
+        // Attributes validation errors from the resources and work the callback creates.
+        auto const scope = ErrorScope( app->error_reporter_, device, "app_callback" );
+        app->app_callback_( *app );
+    }
+}
+
+auto App::configure_surface( ) -> utils::Result< void >
+{
+    auto capabilities = WGPUSurfaceCapabilities{ };
+    if ( WGPUStatus_Success
+         != ::wgpuSurfaceGetCapabilities( surface_.get( ), adapter_.get( ), &capabilities ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Could not get WebGPU surface capabilities" );
+    }
+
+    LTB_LOG_INFO( "Surface formats" );
+    for ( auto i = 0UZ; i < capabilities.formatCount; ++i )
+    {
+        LTB_LOG_INFO( " - {}", to_string( capabilities.formats[ i ] ) );
     }
 
     constexpr auto    preferred_format = WGPUTextureFormat_BGRA8UnormSrgb;
     auto const* const formats_end      = capabilities.formats + capabilities.formatCount;
-    if ( std::find( capabilities.formats, formats_end, preferred_format ) == formats_end )
+    auto const        supported
+        = ( std::find( capabilities.formats, formats_end, preferred_format ) != formats_end );
+    ::wgpuSurfaceCapabilitiesFreeMembers( capabilities );
+
+    if ( !supported )
     {
-        spdlog::error( "Surface does not support {}", to_string( preferred_format ) );
-        return;
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            utils::ErrorCode::Unsupported,
+            "Surface does not support {}",
+            to_string( preferred_format )
+        );
     }
-    ::wgpuSurfaceCapabilitiesFreeMembers( capabilities );
 
     auto configuration = WGPUSurfaceConfiguration{
         .nextInChain     = nullptr,
-        .device          = app->device_.get( ),
+        .device          = device_.get( ),
         .format          = preferred_format,
         .usage           = WGPUTextureUsage_RenderAttachment,
         .width           = default_size.x,
@@ -396,12 +470,10 @@ auto App::handle_device(
         .alphaMode       = WGPUCompositeAlphaMode_Auto,
         .presentMode     = WGPUPresentMode_Mailbox,
     };
-    ::wgpuSurfaceConfigure( app->surface_.get( ), &configuration );
+    auto const scope = ErrorScope( error_reporter_, device_.get( ), "configure_surface" );
+    ::wgpuSurfaceConfigure( surface_.get( ), &configuration );
 
-    if ( app->app_callback_ )
-    {
-        app->app_callback_( *app );
-    }
+    return utils::success( );
 }
 
 } // namespace ltb::wgpu
@@ -4,13 +4,22 @@
 #pragma once
 
 // project
+#include "ltb/utils/metrics.hpp"
 #include "ltb/utils/result.hpp"
+#include "ltb/wgpu/api_trace.hpp"
+#include "ltb/wgpu/error_reporter.hpp"
+#include "ltb/wgpu/gpu_memory_tracker.hpp"
+#include "ltb/wgpu/handle.hpp"
+#include "ltb/wgpu/performance_profile.hpp"
 #include "ltb/window/os_window.hpp"
 
 // external
 #include <spdlog/spdlog.h>
 #include <webgpu/webgpu.h>
 
+// standard
+#include <filesystem>
+
 namespace ltb::wgpu
 {
 
@@ -20,8 +29,24 @@ using AppCallback = std::function< void( App& ) >;
 
 struct AppSettings
 {
-    AppCallback       callback = nullptr;
-    window::OsWindow* window   = nullptr;
+    AppCallback        callback            = nullptr;
+    window::OsWindow*  window              = nullptr;
+    PerformanceProfile performance_profile = PerformanceProfile::Default;
+
+    /// \brief Zero means GPU memory is tracked without a budget.
+    uint64 gpu_memory_budget_bytes = 0U;
+
+    /// \brief Use the software adapter, for example to replay or benchmark headlessly.
+    bool force_fallback_adapter = false;
+
+    /// \brief When set, calls made through `App::api_trace()` are recorded to this file.
+    std::filesystem::path api_trace_file = { };
+
+    /// \brief Where `utils::metrics()` is exported. Nothing is exported by default.
+    utils::MetricsExporterSettings metrics_export = { };
+
+    /// \brief How uncaptured and scoped WebGPU errors are deduplicated and summarized.
+    ErrorReporterSettings error_reporting = { };
 };
 
 class App
@@ -34,18 +59,39 @@ public:
 
     auto process( ) -> void;
 
-    static constexpr glm::uvec2 default_size = { 1280U, 720U };
+    [[nodiscard( "Const getter" )]] auto instance( ) const -> WGPUInstance;
+    [[nodiscard( "Const getter" )]] auto adapter( ) const -> WGPUAdapter;
+    [[nodiscard( "Const getter" )]] auto device( ) const -> WGPUDevice;
+    [[nodiscard( "Const getter" )]] auto queue( ) const -> WGPUQueue;
 
-private:
-    AppCallback app_callback_;
+    /// \brief Buffers and textures should be created through this to count against the budget.
+    [[nodiscard]] auto memory_tracker( ) -> GpuMemoryTracker&;
+
+    /// \brief Compute and transfer calls made through this can be recorded and replayed.
+    [[nodiscard]] auto api_trace( ) -> ApiTraceRecorder&;
 
-    window::OsWindow*                   window_   = nullptr;
-    std::shared_ptr< WGPUInstanceImpl > instance_ = nullptr;
-    std::shared_ptr< WGPUSurfaceImpl >  surface_  = nullptr;
+    /// \brief Receives uncaptured device errors. Use with `ErrorScope` to attribute errors.
+    [[nodiscard]] auto error_reporter( ) -> ErrorReporter&;
 
-    std::shared_ptr< WGPUAdapterImpl > adapter_ = nullptr;
-    std::shared_ptr< WGPUDeviceImpl >  device_  = nullptr;
-    std::shared_ptr< WGPUQueueImpl >   queue_   = nullptr;
+    static constexpr glm::uvec2 default_size = { 1280U, 720U };
+
+private:
+    AppCallback            app_callback_;
+    PerformanceProfile     performance_profile_;
+    GpuMemoryTracker       memory_tracker_;
+    bool                   force_fallback_adapter_ = false;
+    std::filesystem::path  api_trace_file_;
+    ApiTraceRecorder       api_trace_;
+    utils::MetricsExporter metrics_exporter_;
+    ErrorReporter          error_reporter_;
+
+    window::OsWindow* window_   = nullptr;
+    InstanceHandle    instance_ = nullptr;
+    SurfaceHandle     surface_  = nullptr;
+
+    AdapterHandle adapter_ = nullptr;
+    DeviceHandle  device_  = nullptr;
+    QueueHandle   queue_   = nullptr;
 
     static auto handle_adapter(
         WGPURequestAdapterStatus status,
@@ -63,7 +109,7 @@ private:
         void*                   userdata2
     ) -> void;
 
-    static auto configure_surface( ) -> void;
+    auto configure_surface( ) -> utils::Result< void >;
 };
 
 } // namespace ltb::wgpu
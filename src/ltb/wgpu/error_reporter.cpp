@@ -0,0 +1,195 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/error_reporter.hpp"
+
+// project
+#include "ltb/utils/hash_utils.hpp"
+#include "ltb/utils/ignore.hpp"
+#include "ltb/utils/logging.hpp"
+#include "ltb/wgpu/string_view.hpp"
+
+// external
+#include <magic_enum.hpp>
+
+namespace ltb::wgpu
+{
+namespace
+{
+
+auto error_key(
+    std::string_view const source,
+    WGPUErrorType const    type,
+    std::string_view const message
+) -> uint64
+{
+    auto seed = std::hash< std::string_view >{ }( source );
+    seed      = utils::hash_combine( seed, std::to_underlying( type ) );
+    seed      = utils::hash_combine( seed, message );
+    return seed;
+}
+
+auto on_error_scope_popped(
+    WGPUPopErrorScopeStatus const status,
+    WGPUErrorType const           type,
+    WGPUStringView const          message,
+    void* const                   userdata1,
+    void* const                   userdata2
+) -> void
+{
+    // The reporter may already be gone when the callback is cancelled at shutdown.
+    if ( ( WGPUPopErrorScopeStatus_Success != status ) || ( WGPUErrorType_NoError == type ) )
+    {
+        return;
+    }
+
+    auto* const reporter = static_cast< ErrorReporter* >( userdata1 );
+    auto const* label    = static_cast< char const* >( userdata2 );
+    reporter->report( label, type, to_string_view( message ) );
+}
+
+} // namespace
+
+ErrorReporter::ErrorReporter( ErrorReporterSettings settings )
+    : settings_( std::move( settings ) )
+{
+}
+
+auto ErrorReporter::report(
+    std::string_view const source,
+    WGPUErrorType const    type,
+    std::string_view const message
+) -> void
+{
+    auto const key = error_key( source, type, message );
+
+    auto lock = std::unique_lock( mutex_ );
+
+    if ( auto iter = entries_.find( key ); iter != entries_.end( ) )
+    {
+        auto& error = iter->second.error;
+        if ( ( error.source == source ) && ( error.type == type ) && ( error.message == message ) )
+        {
+            ++error.count;
+        }
+        else
+        {
+            ++untracked_count_;
+        }
+        return;
+    }
+
+    if ( entries_.size( ) >= settings_.max_distinct_errors )
+    {
+        ++untracked_count_;
+        return;
+    }
+
+    entries_.emplace(
+        key,
+        Entry{
+            .error = {
+                .source  = std::string( source ),
+                .type    = type,
+                .message = std::string( message ),
+                .count   = 1U,
+            },
+            .summarized_at = 1U,
+        }
+    );
+    lock.unlock( );
+
+    LTB_LOG_ERROR( "WebGPU {} error in '{}': {}", magic_enum::enum_name( type ), source, message );
+}
+
+auto ErrorReporter::summarize_if_due( ) -> void
+{
+    if ( summary_timer_.duration_since_start( ) >= settings_.summary_interval )
+    {
+        summarize( );
+    }
+}
+
+auto ErrorReporter::summarize( ) -> void
+{
+    summary_timer_.start( );
+
+    auto const lock = std::scoped_lock( mutex_ );
+
+    for ( auto& [ key, entry ] : entries_ )
+    {
+        utils::ignore( key );
+
+        auto const& error = entry.error;
+        if ( error.count == entry.summarized_at )
+        {
+            continue;
+        }
+
+        LTB_LOG_WARN(
+            "WebGPU {} error in '{}' repeated {} times ({} total): {}",
+            magic_enum::enum_name( error.type ),
+            error.source,
+            error.count - entry.summarized_at,
+            error.count,
+            error.message
+        );
+        entry.summarized_at = error.count;
+    }
+
+    if ( untracked_count_ > 0U )
+    {
+        LTB_LOG_WARN(
+            "{} WebGPU errors were not tracked ({} distinct errors already tracked)",
+            untracked_count_,
+            entries_.size( )
+        );
+        untracked_count_ = 0U;
+    }
+}
+
+auto ErrorReporter::errors( ) const -> std::vector< ReportedError >
+{
+    auto const lock = std::scoped_lock( mutex_ );
+
+    auto errors = std::vector< ReportedError >{ };
+    errors.reserve( entries_.size( ) );
+    for ( auto const& [ key, entry ] : entries_ )
+    {
+        utils::ignore( key );
+        errors.emplace_back( entry.error );
+    }
+    return errors;
+}
+
+auto ErrorReporter::untracked_count( ) const -> uint64
+{
+    auto const lock = std::scoped_lock( mutex_ );
+    return untracked_count_;
+}
+
+ErrorScope::ErrorScope( ErrorReporter& reporter, WGPUDevice const device, char const* const label )
+    : reporter_( &reporter )
+    , device_( device )
+    , label_( label )
+{
+    ::wgpuDevicePushErrorScope( device_, WGPUErrorFilter_Validation );
+}
+
+ErrorScope::~ErrorScope( )
+{
+    utils::ignore(
+        ::wgpuDevicePopErrorScope(
+            device_,
+            WGPUPopErrorScopeCallbackInfo{
+                .nextInChain = nullptr,
+                .mode        = WGPUCallbackMode_AllowProcessEvents,
+                .callback    = &on_error_scope_popped,
+                .userdata1   = reporter_,
+                .userdata2   = const_cast< char* >( label_ ),
+            }
+        )
+    );
+}
+
+} // namespace ltb::wgpu
@@ -0,0 +1,108 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/duration.hpp"
+#include "ltb/utils/timers.hpp"
+#include "ltb/utils/types.hpp"
+
+// external
+#include <webgpu/webgpu.h>
+
+// standard
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ltb::wgpu
+{
+
+struct ErrorReporterSettings
+{
+    /// \brief How often repeated errors are summarized by `summarize_if_due`.
+    utils::Duration summary_interval = utils::duration_seconds( 5 );
+
+    /// \brief Distinct errors tracked before new ones are only counted.
+    uint32 max_distinct_errors = 256U;
+};
+
+/// \brief The source reported for errors that no error scope caught.
+constexpr auto uncaptured_error_source = "uncaptured";
+
+struct ReportedError
+{
+    std::string   source  = "";
+    WGPUErrorType type    = WGPUErrorType_NoError;
+    std::string   message = "";
+
+    /// \brief Every report of this error, including the first one that was logged.
+    uint64 count = 0U;
+};
+
+/// \brief Deduplicates WebGPU errors by source, type and message. The first occurrence of
+///        each error is logged; repeats are counted and logged as periodic summaries, so an
+///        error raised every frame costs a hash and a map lookup rather than a log write.
+class ErrorReporter
+{
+public:
+    explicit ErrorReporter( ErrorReporterSettings settings = { } );
+
+    /// \brief Thread-safe. `source` names the error scope that caught the error.
+    auto report( std::string_view source, WGPUErrorType type, std::string_view message ) -> void;
+
+    /// \brief Logs a summary of errors repeated since the last summary, if
+    ///        `summary_interval` has passed. Intended to be called once per frame.
+    auto summarize_if_due( ) -> void;
+
+    /// \brief Logs a summary of errors repeated since the last summary.
+    auto summarize( ) -> void;
+
+    /// \brief A copy of every distinct error seen so far.
+    [[nodiscard( "Const getter" )]] auto errors( ) const -> std::vector< ReportedError >;
+
+    /// \brief Reports dropped since the last summary because `max_distinct_errors` was reached.
+    [[nodiscard( "Const getter" )]] auto untracked_count( ) const -> uint64;
+
+private:
+    struct Entry
+    {
+        ReportedError error         = { };
+        uint64        summarized_at = 0U;
+    };
+
+    ErrorReporterSettings settings_;
+
+    mutable std::mutex                  mutex_           = { };
+    std::unordered_map< uint64, Entry > entries_         = { };
+    uint64                              untracked_count_ = 0U;
+    utils::Timer                        summary_timer_   = { };
+};
+
+/// \brief Pushes a validation error scope on construction and pops it on destruction,
+///        reporting any error it caught under `label`. Wrap batches of encoding and
+///        submission to attribute errors to the pass that caused them.
+class ErrorScope
+{
+public:
+    /// \brief `label` is not copied and must stay alive until the asynchronous pop is
+    ///        delivered by processing instance events. String literals are always safe.
+    ErrorScope( ErrorReporter& reporter, WGPUDevice device, char const* label );
+    ~ErrorScope( );
+
+    // No copy or move. Scopes must be popped in the reverse order they were pushed.
+    ErrorScope( ErrorScope const& )                        = delete;
+    ErrorScope( ErrorScope&& ) noexcept                    = delete;
+    auto operator=( ErrorScope const& ) -> ErrorScope&     = delete;
+    auto operator=( ErrorScope&& ) noexcept -> ErrorScope& = delete;
+
+private:
+    ErrorReporter* reporter_;
+    WGPUDevice     device_;
+    char const*    label_;
+};
+
+} // namespace ltb::wgpu
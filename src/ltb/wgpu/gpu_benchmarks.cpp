@@ -0,0 +1,662 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/gpu_benchmarks.hpp"
+
+// project
+#include "ltb/utils/timers.hpp"
+#include "ltb/wgpu/handle.hpp"
+#include "ltb/wgpu/queue_utils.hpp"
+#include "ltb/wgpu/string_view.hpp"
+
+// external
+#include <magic_enum.hpp>
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace ltb::wgpu
+{
+namespace
+{
+
+constexpr auto empty_compute_source = "@compute @workgroup_size(1) fn main() {}";
+
+constexpr auto empty_draw_source = R"(
+@vertex fn vs() -> @builtin(position) vec4f {
+    return vec4f(0.0, 0.0, 0.0, 1.0);
+}
+
+@fragment fn fs() -> @location(0) vec4f {
+    return vec4f(seed);
+}
+)";
+
+constexpr auto unique_compute_source = R"(
+@group(0) @binding(0) var<storage, read_write> data: array<u32>;
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) id: vec3u) {{
+    data[id.x] = data[id.x] * {}u + 1u;
+}}
+)";
+
+constexpr auto draw_target_format = WGPUTextureFormat_RGBA8Unorm;
+constexpr auto draw_target_size   = 64U;
+
+/// \brief Runs the benchmarked work, waiting for anything it submits.
+using BenchmarkRun = std::function< utils::Result< void >( ) >;
+
+struct MapData
+{
+    bool               done    = false;
+    WGPUMapAsyncStatus status  = WGPUMapAsyncStatus_Success;
+    std::string        message = "";
+};
+
+auto on_buffer_mapped(
+    WGPUMapAsyncStatus const status,
+    WGPUStringView const     message,
+    void* const              userdata1,
+    void* const              userdata2
+) -> void
+{
+    utils::ignore( userdata2 );
+
+    auto* data    = static_cast< MapData* >( userdata1 );
+    data->status  = status;
+    data->message = to_string_view( message );
+    data->done    = true;
+}
+
+auto map_for_writing( WGPUInstance const instance, WGPUBuffer const buffer, uint64 const bytes )
+    -> utils::Result< void >
+{
+    auto data = MapData{ };
+    utils::ignore(
+        ::wgpuBufferMapAsync(
+            buffer,
+            WGPUMapMode_Write,
+            0UZ,
+            bytes,
+            WGPUBufferMapCallbackInfo{
+                .nextInChain = nullptr,
+                .mode        = WGPUCallbackMode_AllowProcessEvents,
+                .callback    = &on_buffer_mapped,
+                .userdata1   = &data,
+                .userdata2   = nullptr,
+            }
+        )
+    );
+
+    while ( !data.done )
+    {
+        ::wgpuInstanceProcessEvents( instance );
+    }
+
+    if ( WGPUMapAsyncStatus_Success != data.status )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Buffer map failed ({}): {}",
+            magic_enum::enum_name( data.status ),
+            data.message
+        );
+    }
+    return utils::success( );
+}
+
+auto create_buffer(
+    GpuBenchmarkContext const& context,
+    std::string_view const     label,
+    WGPUBufferUsage const      usage,
+    uint64 const               bytes
+) -> utils::Result< TrackedBuffer >
+{
+    auto const descriptor = WGPUBufferDescriptor{
+        .nextInChain      = nullptr,
+        .label            = to_wgpu_string_view( label ),
+        .usage            = usage,
+        .size             = bytes,
+        .mappedAtCreation = false,
+    };
+    return context.api_trace->create_buffer( context.device, descriptor, buffer_category( usage ) );
+}
+
+auto create_shader( GpuBenchmarkContext const& context, std::string const& source )
+    -> utils::Result< ShaderModuleHandle >
+{
+    auto wgsl = WGPUShaderSourceWGSL{
+        .chain = { .next = nullptr, .sType = WGPUSType_ShaderSourceWGSL },
+        .code  = to_wgpu_string_view( source ),
+    };
+    auto const descriptor = WGPUShaderModuleDescriptor{
+        .nextInChain = &wgsl.chain,
+        .label       = to_wgpu_string_view( "GPU benchmark shader" ),
+    };
+    auto shader = ShaderModuleHandle{
+        context.api_trace->create_shader_module( context.device, descriptor ),
+    };
+    LTB_CHECK_VALID( shader );
+    return shader;
+}
+
+auto create_compute_pipeline( GpuBenchmarkContext const& context, std::string const& source )
+    -> utils::Result< ComputePipelineHandle >
+{
+    LTB_CHECK( auto const shader, create_shader( context, source ) );
+
+    auto const descriptor = WGPUComputePipelineDescriptor{
+        .nextInChain = nullptr,
+        .label       = to_wgpu_string_view( "GPU benchmark compute pipeline" ),
+        .layout      = nullptr,
+        .compute     = {
+            .nextInChain   = nullptr,
+            .module        = shader.get( ),
+            .entryPoint    = to_wgpu_string_view( "main" ),
+            .constantCount = 0UZ,
+            .constants     = nullptr,
+        },
+    };
+    auto pipeline = ComputePipelineHandle{
+        context.api_trace->create_compute_pipeline( context.device, descriptor ),
+    };
+    LTB_CHECK_VALID( pipeline );
+    return pipeline;
+}
+
+/// \brief A pipeline whose fragment output is `seed`, so each seed compiles a new shader.
+auto create_render_pipeline( GpuBenchmarkContext const& context, uint32 const seed )
+    -> utils::Result< RenderPipelineHandle >
+{
+    LTB_CHECK(
+        auto const shader,
+        create_shader(
+            context,
+            fmt::format( "const seed = {}.0;\n{}", seed, empty_draw_source )
+        )
+    );
+
+    auto const target = WGPUColorTargetState{
+        .nextInChain = nullptr,
+        .format      = draw_target_format,
+        .blend       = nullptr,
+        .writeMask   = WGPUColorWriteMask_All,
+    };
+    auto const fragment = WGPUFragmentState{
+        .nextInChain   = nullptr,
+        .module        = shader.get( ),
+        .entryPoint    = to_wgpu_string_view( "fs" ),
+        .constantCount = 0UZ,
+        .constants     = nullptr,
+        .targetCount   = 1UZ,
+        .targets       = &target,
+    };
+    auto const descriptor = WGPURenderPipelineDescriptor{
+        .nextInChain = nullptr,
+        .label       = to_wgpu_string_view( "GPU benchmark render pipeline" ),
+        .layout      = nullptr,
+        .vertex      = {
+            .nextInChain   = nullptr,
+            .module        = shader.get( ),
+            .entryPoint    = to_wgpu_string_view( "vs" ),
+            .constantCount = 0UZ,
+            .constants     = nullptr,
+            .bufferCount   = 0UZ,
+            .buffers       = nullptr,
+        },
+        .primitive = {
+            .nextInChain      = nullptr,
+            .topology         = WGPUPrimitiveTopology_TriangleList,
+            .stripIndexFormat = WGPUIndexFormat_Undefined,
+            .frontFace        = WGPUFrontFace_CCW,
+            .cullMode         = WGPUCullMode_None,
+            .unclippedDepth   = false,
+        },
+        .depthStencil = nullptr,
+        .multisample  = {
+            .nextInChain            = nullptr,
+            .count                  = 1U,
+            .mask                   = ~0U,
+            .alphaToCoverageEnabled = false,
+        },
+        .fragment = &fragment,
+    };
+    // Render pipelines are not captured by the trace.
+    auto pipeline = RenderPipelineHandle{
+        ::wgpuDeviceCreateRenderPipeline( context.device, &descriptor ),
+    };
+    LTB_CHECK_VALID( pipeline );
+    return pipeline;
+}
+
+/// \brief `submit_and_wait` through the context's trace.
+auto submit( GpuBenchmarkContext const& context, EncodeCallback const& encode )
+    -> utils::Result< void >
+{
+    LTB_CHECK(
+        submit_and_wait(
+            context.instance,
+            context.device,
+            context.queue,
+            encode,
+            context.api_trace
+        )
+    );
+    return utils::success( );
+}
+
+/// \brief Runs `run` inside an error scope when the context has a reporter. The scope is
+///        popped before the caller's final wait for the queue, which delivers its callback
+///        while `label` is still alive.
+auto scoped_run(
+    GpuBenchmarkContext const& context,
+    char const* const          label,
+    BenchmarkRun const&        run
+) -> utils::Result< void >
+{
+    if ( nullptr == context.error_reporter )
+    {
+        return run( );
+    }
+    auto const scope = ErrorScope( *context.error_reporter, context.device, label );
+    return run( );
+}
+
+/// \brief Times `run`, which waits for the GPU itself, over every iteration. The queue is
+///        drained untimed after each run to deliver its error scope.
+auto time_runs(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings,
+    GpuBenchmarkResult          result,
+    BenchmarkRun const&         run
+) -> utils::Result< GpuBenchmarkResult >
+{
+    LTB_CHECK_VALID( settings.iterations > 0U );
+
+    auto const* const label = result.name.c_str( );
+
+    for ( auto i = 0U; i < settings.warmup_iterations; ++i )
+    {
+        LTB_CHECK( scoped_run( context, label, run ) );
+        LTB_CHECK( wait_for_queue( context.instance, context.queue ) );
+    }
+
+    auto samples = std::vector< utils::Duration >{ };
+    samples.reserve( settings.iterations );
+
+    for ( auto i = 0U; i < settings.iterations; ++i )
+    {
+        auto timer = utils::Timer{ };
+        LTB_CHECK( scoped_run( context, label, run ) );
+        samples.emplace_back( timer.duration_since_start( ) );
+        LTB_CHECK( wait_for_queue( context.instance, context.queue ) );
+    }
+
+    std::ranges::sort( samples );
+
+    result.iterations = settings.iterations;
+    result.min        = samples.front( );
+    result.median     = samples[ samples.size( ) / 2UZ ];
+    result.max        = samples.back( );
+
+    spdlog::debug(
+        "{} ({} bytes): median {}us",
+        result.name,
+        result.bytes,
+        utils::to_micros( result.median )
+    );
+    return result;
+}
+
+} // namespace
+
+auto to_json( nlohmann::json& json, GpuBenchmarkResult const& result ) -> void
+{
+    auto const median_seconds = utils::to_seconds< float64 >( result.median );
+
+    json = nlohmann::json{
+        { "name", result.name },
+        { "bytes", result.bytes },
+        { "operations", result.operations },
+        { "iterations", result.iterations },
+        { "min_ns", utils::to_nanos< int64 >( result.min ) },
+        { "median_ns", utils::to_nanos< int64 >( result.median ) },
+        { "max_ns", utils::to_nanos< int64 >( result.max ) },
+        { "ns_per_operation",
+          utils::to_nanos< float64 >( result.median )
+              / static_cast< float64 >( std::max( result.operations, uint64{ 1U } ) ) },
+    };
+    if ( ( result.bytes > 0U ) && ( median_seconds > 0.0 ) )
+    {
+        json[ "bytes_per_second" ] = static_cast< float64 >( result.bytes ) / median_seconds;
+    }
+}
+
+auto benchmark_write_buffer(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings,
+    uint64 const                bytes
+) -> utils::Result< GpuBenchmarkResult >
+{
+    LTB_CHECK(
+        auto const destination,
+        create_buffer(
+            context,
+            "Write buffer destination",
+            WGPUBufferUsage_CopyDst | WGPUBufferUsage_Storage,
+            bytes
+        )
+    );
+    auto const source = std::vector< std::byte >( bytes, std::byte{ 0x5A } );
+
+    return time_runs(
+        context,
+        settings,
+        { .name = "write_buffer", .bytes = bytes },
+        [ & ]( ) -> utils::Result< void >
+        {
+            context.api_trace
+                ->write_buffer( context.queue, destination.get( ), 0U, source.data( ), bytes );
+            // An empty submit flushes the write so the wait covers it.
+            return submit( context, []( WGPUCommandEncoder ) {} );
+        }
+    );
+}
+
+auto benchmark_mapped_upload(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings,
+    uint64 const                bytes
+) -> utils::Result< GpuBenchmarkResult >
+{
+    LTB_CHECK(
+        auto const staging,
+        create_buffer(
+            context,
+            "Mapped upload staging",
+            WGPUBufferUsage_MapWrite | WGPUBufferUsage_CopySrc,
+            bytes
+        )
+    );
+    LTB_CHECK(
+        auto const destination,
+        create_buffer(
+            context,
+            "Mapped upload destination",
+            WGPUBufferUsage_CopyDst | WGPUBufferUsage_Storage,
+            bytes
+        )
+    );
+    auto const source = std::vector< std::byte >( bytes, std::byte{ 0x5A } );
+
+    return time_runs(
+        context,
+        settings,
+        { .name = "mapped_upload", .bytes = bytes },
+        [ & ]( ) -> utils::Result< void >
+        {
+            LTB_CHECK( map_for_writing( context.instance, staging.get( ), bytes ) );
+
+            auto* const mapped = ::wgpuBufferGetMappedRange( staging.get( ), 0UZ, bytes );
+            LTB_CHECK_VALID( mapped );
+            std::memcpy( mapped, source.data( ), bytes );
+            ::wgpuBufferUnmap( staging.get( ) );
+
+            return submit(
+                context,
+                [ & ]( WGPUCommandEncoder const encoder )
+                {
+                    context.api_trace->copy_buffer_to_buffer(
+                        encoder,
+                        staging.get( ),
+                        0U,
+                        destination.get( ),
+                        0U,
+                        bytes
+                    );
+                }
+            );
+        }
+    );
+}
+
+auto benchmark_buffer_copy(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings,
+    uint64 const                bytes
+) -> utils::Result< GpuBenchmarkResult >
+{
+    LTB_CHECK(
+        auto const source,
+        create_buffer(
+            context,
+            "Copy source",
+            WGPUBufferUsage_CopySrc | WGPUBufferUsage_Storage,
+            bytes
+        )
+    );
+    LTB_CHECK(
+        auto const destination,
+        create_buffer(
+            context,
+            "Copy destination",
+            WGPUBufferUsage_CopyDst | WGPUBufferUsage_Storage,
+            bytes
+        )
+    );
+
+    return time_runs(
+        context,
+        settings,
+        { .name = "buffer_copy", .bytes = bytes },
+        [ & ]
+        {
+            return submit(
+                context,
+                [ & ]( WGPUCommandEncoder const encoder )
+                {
+                    context.api_trace->copy_buffer_to_buffer(
+                        encoder,
+                        source.get( ),
+                        0U,
+                        destination.get( ),
+                        0U,
+                        bytes
+                    );
+                }
+            );
+        }
+    );
+}
+
+auto benchmark_empty_dispatch(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings
+) -> utils::Result< GpuBenchmarkResult >
+{
+    LTB_CHECK(
+        auto const pipeline,
+        create_compute_pipeline( context, empty_compute_source )
+    );
+
+    return time_runs(
+        context,
+        settings,
+        { .name = "empty_dispatch", .operations = settings.commands_per_iteration },
+        [ & ]
+        {
+            return submit(
+                context,
+                [ & ]( WGPUCommandEncoder const encoder )
+                {
+                    auto& trace = *context.api_trace;
+
+                    auto const pass
+                        = ComputePassEncoderHandle{ trace.begin_compute_pass( encoder ) };
+                    trace.set_pipeline( pass.get( ), pipeline.get( ) );
+                    for ( auto i = 0U; i < settings.commands_per_iteration; ++i )
+                    {
+                        trace.dispatch_workgroups( pass.get( ), 1U, 1U, 1U );
+                    }
+                    trace.end_pass( pass.get( ) );
+                }
+            );
+        }
+    );
+}
+
+auto benchmark_empty_draw(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings
+) -> utils::Result< GpuBenchmarkResult >
+{
+    LTB_CHECK( auto const pipeline, create_render_pipeline( context, 0U ) );
+
+    auto const texture_descriptor = WGPUTextureDescriptor{
+        .nextInChain   = nullptr,
+        .label         = to_wgpu_string_view( "GPU benchmark draw target" ),
+        .usage         = WGPUTextureUsage_RenderAttachment,
+        .dimension     = WGPUTextureDimension_2D,
+        .size          = { draw_target_size, draw_target_size, 1U },
+        .format        = draw_target_format,
+        .mipLevelCount = 1U,
+        .sampleCount   = 1U,
+    };
+    LTB_CHECK(
+        auto const texture,
+        context.memory_tracker->create_texture(
+            context.device,
+            texture_descriptor,
+            GpuMemoryCategory::RenderTarget
+        )
+    );
+
+    auto const view = TextureViewHandle{ ::wgpuTextureCreateView( texture.get( ), nullptr ) };
+    LTB_CHECK_VALID( view );
+
+    return time_runs(
+        context,
+        settings,
+        { .name = "empty_draw", .operations = settings.commands_per_iteration },
+        [ & ]
+        {
+            return submit(
+                context,
+                [ & ]( WGPUCommandEncoder const encoder )
+                {
+                    auto const color_attachment = WGPURenderPassColorAttachment{
+                        .nextInChain   = nullptr,
+                        .view          = view.get( ),
+                        .depthSlice    = WGPU_DEPTH_SLICE_UNDEFINED,
+                        .resolveTarget = nullptr,
+                        .loadOp        = WGPULoadOp_Clear,
+                        .storeOp       = WGPUStoreOp_Store,
+                        .clearValue    = { 0.0, 0.0, 0.0, 1.0 },
+                    };
+                    auto const pass_descriptor = WGPURenderPassDescriptor{
+                        .nextInChain          = nullptr,
+                        .label                = to_wgpu_string_view( "GPU benchmark draw pass" ),
+                        .colorAttachmentCount = 1UZ,
+                        .colorAttachments     = &color_attachment,
+                    };
+                    auto const pass = RenderPassEncoderHandle{
+                        ::wgpuCommandEncoderBeginRenderPass( encoder, &pass_descriptor ),
+                    };
+                    ::wgpuRenderPassEncoderSetPipeline( pass.get( ), pipeline.get( ) );
+                    for ( auto i = 0U; i < settings.commands_per_iteration; ++i )
+                    {
+                        ::wgpuRenderPassEncoderDraw( pass.get( ), 3U, 1U, 0U, 0U );
+                    }
+                    ::wgpuRenderPassEncoderEnd( pass.get( ) );
+                }
+            );
+        }
+    );
+}
+
+auto benchmark_compute_pipeline_creation(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings
+) -> utils::Result< GpuBenchmarkResult >
+{
+    auto seed = 0U;
+
+    return time_runs(
+        context,
+        settings,
+        { .name = "compute_pipeline_creation" },
+        [ & ]( ) -> utils::Result< void >
+        {
+            LTB_CHECK(
+                auto const pipeline,
+                create_compute_pipeline(
+                    context,
+                    fmt::format( unique_compute_source, ++seed )
+                )
+            );
+            return utils::success( );
+        }
+    );
+}
+
+auto benchmark_render_pipeline_creation(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings
+) -> utils::Result< GpuBenchmarkResult >
+{
+    auto seed = 0U;
+
+    return time_runs(
+        context,
+        settings,
+        { .name = "render_pipeline_creation" },
+        [ & ]( ) -> utils::Result< void >
+        {
+            LTB_CHECK( auto const pipeline, create_render_pipeline( context, ++seed ) );
+            return utils::success( );
+        }
+    );
+}
+
+auto run_gpu_benchmarks( GpuBenchmarkContext const& context, GpuBenchmarkSettings const& settings )
+    -> utils::Result< std::vector< GpuBenchmarkResult > >
+{
+    LTB_CHECK_VALID( context.instance );
+    LTB_CHECK_VALID( context.device );
+    LTB_CHECK_VALID( context.queue );
+    LTB_CHECK_VALID( context.api_trace );
+    LTB_CHECK_VALID( context.memory_tracker );
+
+    auto results = std::vector< GpuBenchmarkResult >{ };
+
+    for ( auto const bytes : settings.transfer_sizes )
+    {
+        LTB_CHECK( auto write, benchmark_write_buffer( context, settings, bytes ) );
+        results.emplace_back( std::move( write ) );
+
+        LTB_CHECK( auto mapped, benchmark_mapped_upload( context, settings, bytes ) );
+        results.emplace_back( std::move( mapped ) );
+
+        LTB_CHECK( auto copy, benchmark_buffer_copy( context, settings, bytes ) );
+        results.emplace_back( std::move( copy ) );
+    }
+
+    LTB_CHECK( auto dispatch, benchmark_empty_dispatch( context, settings ) );
+    results.emplace_back( std::move( dispatch ) );
+
+    LTB_CHECK( auto draw, benchmark_empty_draw( context, settings ) );
+    results.emplace_back( std::move( draw ) );
+
+    LTB_CHECK( auto compute_pipeline, benchmark_compute_pipeline_creation( context, settings ) );
+    results.emplace_back( std::move( compute_pipeline ) );
+
+    LTB_CHECK( auto render_pipeline, benchmark_render_pipeline_creation( context, settings ) );
+    results.emplace_back( std::move( render_pipeline ) );
+
+    return results;
+}
+
+} // namespace ltb::wgpu
@@ -0,0 +1,127 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/duration.hpp"
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+#include "ltb/wgpu/api_trace.hpp"
+#include "ltb/wgpu/error_reporter.hpp"
+#include "ltb/wgpu/gpu_memory_tracker.hpp"
+
+// external
+#include <nlohmann/json.hpp>
+#include <webgpu/webgpu.h>
+
+// standard
+#include <string>
+#include <vector>
+
+namespace ltb::wgpu
+{
+
+struct GpuBenchmarkSettings
+{
+    /// \brief Buffer sizes used by the upload and copy benchmarks.
+    std::vector< uint64 > transfer_sizes = { 64UZ << 10U, 1UZ << 20U, 16UZ << 20U };
+
+    /// \brief Timed runs per benchmark. Every run waits for the GPU to go idle.
+    uint32 iterations = 20U;
+
+    /// \brief Untimed runs before timing starts.
+    uint32 warmup_iterations = 2U;
+
+    /// \brief Dispatches or draws encoded per run of the overhead benchmarks.
+    uint32 commands_per_iteration = 1000U;
+};
+
+struct GpuBenchmarkResult
+{
+    std::string name = "";
+
+    /// \brief Bytes moved per run. Zero for benchmarks that don't move data.
+    uint64 bytes = 0U;
+
+    /// \brief Operations (dispatches, draws, pipelines) per run.
+    uint64 operations = 1U;
+
+    uint32 iterations = 0U;
+
+    utils::Duration min    = { };
+    utils::Duration median = { };
+    utils::Duration max    = { };
+};
+
+/// \brief Serializes a result with derived bytes/second and nanoseconds/operation.
+auto to_json( nlohmann::json& json, GpuBenchmarkResult const& result ) -> void;
+
+struct GpuBenchmarkContext
+{
+    WGPUInstance instance = nullptr;
+    WGPUDevice   device   = nullptr;
+    WGPUQueue    queue    = nullptr;
+
+    /// \brief Required. Buffers, compute work, writes and submits go through this, so a
+    ///        recording trace captures them and buffers count against the memory budget.
+    ApiTraceRecorder* api_trace = nullptr;
+
+    /// \brief Required. Textures are created through this to count against the budget.
+    GpuMemoryTracker* memory_tracker = nullptr;
+
+    /// \brief When set, each run is wrapped in an error scope labelled with the benchmark.
+    ErrorReporter* error_reporter = nullptr;
+};
+
+/// \brief `wgpuQueueWriteBuffer` of `bytes` into a GPU buffer, including the wait for the GPU.
+auto benchmark_write_buffer(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings,
+    uint64                      bytes
+) -> utils::Result< GpuBenchmarkResult >;
+
+/// \brief Maps a reusable staging buffer, fills it, unmaps it and copies it into a GPU buffer.
+auto benchmark_mapped_upload(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings,
+    uint64                      bytes
+) -> utils::Result< GpuBenchmarkResult >;
+
+/// \brief A single `wgpuCommandEncoderCopyBufferToBuffer` of `bytes`.
+auto benchmark_buffer_copy(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings,
+    uint64                      bytes
+) -> utils::Result< GpuBenchmarkResult >;
+
+/// \brief `commands_per_iteration` single-workgroup dispatches of an empty compute shader.
+auto benchmark_empty_dispatch(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings
+) -> utils::Result< GpuBenchmarkResult >;
+
+/// \brief `commands_per_iteration` degenerate-triangle draws into a small offscreen target.
+auto benchmark_empty_draw(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings
+) -> utils::Result< GpuBenchmarkResult >;
+
+/// \brief Creates a shader module and compute pipeline from source unique to each run,
+///        so nothing is served from Dawn's caches.
+auto benchmark_compute_pipeline_creation(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings
+) -> utils::Result< GpuBenchmarkResult >;
+
+/// \brief Like `benchmark_compute_pipeline_creation` for a minimal render pipeline.
+auto benchmark_render_pipeline_creation(
+    GpuBenchmarkContext const&  context,
+    GpuBenchmarkSettings const& settings
+) -> utils::Result< GpuBenchmarkResult >;
+
+/// \brief Runs every benchmark above, once per transfer size where applicable.
+auto run_gpu_benchmarks( GpuBenchmarkContext const& context, GpuBenchmarkSettings const& settings )
+    -> utils::Result< std::vector< GpuBenchmarkResult > >;
+
+} // namespace ltb::wgpu
@@ -0,0 +1,697 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/gpu_driven_renderer.hpp"
+
+// project
+#include "ltb/wgpu/string_view.hpp"
+#include "ltb/wgpu/wgpu_metrics.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+
+namespace ltb::wgpu
+{
+namespace
+{
+
+constexpr auto cull_shader_source = R"(
+struct Instance {
+    transform: mat4x4f,
+    bounding_sphere: vec4f,
+    mesh: u32,
+}
+
+struct Mesh {
+    lod_distances: vec4f,
+    first_slot: u32,
+    lod_count: u32,
+}
+
+struct DrawArgs {
+    index_count: u32,
+    instance_count: atomic<u32>,
+    first_index: u32,
+    base_vertex: i32,
+    first_instance: u32,
+}
+
+struct Culling {
+    planes: array<vec4f, 6>,
+    camera_position: vec4f,
+    instance_count: u32,
+}
+
+@group(0) @binding(0) var<uniform> culling: Culling;
+@group(0) @binding(1) var<storage, read> instances: array<Instance>;
+@group(0) @binding(2) var<storage, read> meshes: array<Mesh>;
+@group(0) @binding(3) var<storage, read> slot_offsets: array<u32>;
+@group(0) @binding(4) var<storage, read_write> draw_args: array<DrawArgs>;
+@group(0) @binding(5) var<storage, read_write> visible: array<u32>;
+
+override workgroup_size: u32 = 64;
+
+@compute @workgroup_size(workgroup_size)
+fn cull(@builtin(global_invocation_id) id: vec3u) {
+    let index = id.x;
+    if (index >= culling.instance_count) {
+        return;
+    }
+
+    let instance = instances[index];
+    let center = (instance.transform * vec4f(instance.bounding_sphere.xyz, 1.0)).xyz;
+    let scale = max(
+        length(instance.transform[0].xyz),
+        max(length(instance.transform[1].xyz), length(instance.transform[2].xyz))
+    );
+    let radius = instance.bounding_sphere.w * scale;
+
+    for (var i = 0u; i < 6u; i++) {
+        let plane = culling.planes[i];
+        if (dot(plane.xyz, center) + plane.w < -radius) {
+            return;
+        }
+    }
+
+    let mesh = meshes[instance.mesh];
+    let view_distance = max(length(center - culling.camera_position.xyz) - radius, 0.0);
+
+    var lod = 0u;
+    loop {
+        if (lod >= mesh.lod_count) {
+            // Further than the last LOD's max distance.
+            return;
+        }
+        if (view_distance < mesh.lod_distances[lod]) {
+            break;
+        }
+        lod += 1u;
+    }
+
+    let slot = mesh.first_slot + lod;
+    let position = atomicAdd(&draw_args[slot].instance_count, 1u);
+    visible[slot_offsets[slot] + position] = index;
+}
+)";
+
+/// \brief Matches the WGSL `Mesh` struct.
+struct MeshInfo
+{
+    glm::vec4               lod_distances = { };
+    uint32                  first_slot    = 0U;
+    uint32                  lod_count     = 0U;
+    std::array< uint32, 2 > padding       = { };
+};
+
+static_assert( sizeof( MeshInfo ) == 32UZ );
+
+/// \brief Matches the WGSL `Culling` struct.
+struct CullingUniforms
+{
+    std::array< glm::vec4, 6 > planes          = { };
+    glm::vec4                  camera_position = { };
+    uint32                     instance_count  = 0U;
+    std::array< uint32, 3 >    padding         = { };
+};
+
+static_assert( sizeof( CullingUniforms ) == 128UZ );
+
+auto create_buffer(
+    GpuMemoryTracker&       tracker,
+    WGPUDevice const        device,
+    std::string_view const  label,
+    WGPUBufferUsage const   usage,
+    uint64 const            size,
+    GpuMemoryCategory const category
+) -> utils::Result< TrackedBuffer >
+{
+    auto const descriptor = WGPUBufferDescriptor{
+        .nextInChain      = nullptr,
+        .label            = to_wgpu_string_view( label ),
+        .usage            = usage,
+        .size             = size,
+        .mappedAtCreation = false,
+    };
+    return tracker.create_buffer( device, descriptor, category );
+}
+
+auto round_up( uint64 const value, uint64 const alignment ) -> uint64
+{
+    return ( ( value + alignment - 1UZ ) / alignment ) * alignment;
+}
+
+/// \brief Extracts normalized frustum planes (Gribb-Hartmann) for a [0, 1] depth range.
+auto extract_frustum_planes( glm::mat4 const& view_projection ) -> std::array< glm::vec4, 6 >
+{
+    auto const row = [ &view_projection ]( auto const i ) {
+        return glm::vec4{
+            view_projection[ 0 ][ i ],
+            view_projection[ 1 ][ i ],
+            view_projection[ 2 ][ i ],
+            view_projection[ 3 ][ i ],
+        };
+    };
+
+    auto planes = std::array< glm::vec4, 6 >{
+        row( 3 ) + row( 0 ), // left
+        row( 3 ) - row( 0 ), // right
+        row( 3 ) + row( 1 ), // bottom
+        row( 3 ) - row( 1 ), // top
+        row( 2 ), // near
+        row( 3 ) - row( 2 ), // far
+    };
+
+    for ( auto& plane : planes )
+    {
+        plane /= glm::length( glm::vec3( plane ) );
+    }
+    return planes;
+}
+
+} // namespace
+
+GpuDrivenRenderer::GpuDrivenRenderer( GpuDrivenRendererSettings settings )
+    : settings_( settings )
+{
+}
+
+GpuDrivenRenderer::~GpuDrivenRenderer( ) = default;
+
+auto GpuDrivenRenderer::initialize(
+    WGPUDevice const  device,
+    WGPUQueue const   queue,
+    GpuMemoryTracker& memory_tracker
+) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( device );
+    LTB_CHECK_VALID( queue );
+    LTB_CHECK_VALID( nullptr == cull_pipeline_, "Already initialized" );
+    LTB_CHECK_VALID( settings_.cull_workgroup_size > 0U );
+
+    device_         = device;
+    queue_          = queue;
+    memory_tracker_ = &memory_tracker;
+    first_instance_ = ::wgpuDeviceHasFeature( device_, WGPUFeatureName_IndirectFirstInstance );
+
+    auto limits = WGPULimits{ };
+    if ( WGPUStatus_Success != ::wgpuDeviceGetLimits( device_, &limits ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Could not get WebGPU device limits" );
+    }
+    storage_alignment_ = limits.minStorageBufferOffsetAlignment;
+    max_workgroups_    = limits.maxComputeWorkgroupsPerDimension;
+
+    spdlog::info(
+        "GPU-driven renderer: IndirectFirstInstance {}",
+        first_instance_ ? "enabled" : "unavailable, using dynamic offsets"
+    );
+
+    auto wgsl = WGPUShaderSourceWGSL{
+        .chain = { .next = nullptr, .sType = WGPUSType_ShaderSourceWGSL },
+        .code  = to_wgpu_string_view( cull_shader_source ),
+    };
+    auto const shader_descriptor = WGPUShaderModuleDescriptor{
+        .nextInChain = &wgsl.chain,
+        .label       = to_wgpu_string_view( "GPU-driven cull shader" ),
+    };
+    auto const shader
+        = ShaderModuleHandle{ ::wgpuDeviceCreateShaderModule( device_, &shader_descriptor ) };
+    LTB_CHECK_VALID( shader );
+
+    auto const storage_entry = []( uint32 const binding, WGPUBufferBindingType const type ) {
+        return WGPUBindGroupLayoutEntry{
+            .nextInChain = nullptr,
+            .binding     = binding,
+            .visibility  = WGPUShaderStage_Compute,
+            .buffer      = { .nextInChain = nullptr, .type = type },
+        };
+    };
+
+    auto const cull_entries = std::array{
+        storage_entry( 0U, WGPUBufferBindingType_Uniform ),
+        storage_entry( 1U, WGPUBufferBindingType_ReadOnlyStorage ),
+        storage_entry( 2U, WGPUBufferBindingType_ReadOnlyStorage ),
+        storage_entry( 3U, WGPUBufferBindingType_ReadOnlyStorage ),
+        storage_entry( 4U, WGPUBufferBindingType_Storage ),
+        storage_entry( 5U, WGPUBufferBindingType_Storage ),
+    };
+    auto const cull_layout_descriptor = WGPUBindGroupLayoutDescriptor{
+        .nextInChain = nullptr,
+        .label       = to_wgpu_string_view( "GPU-driven cull layout" ),
+        .entryCount  = cull_entries.size( ),
+        .entries     = cull_entries.data( ),
+    };
+    cull_bind_group_layout_.reset(
+        ::wgpuDeviceCreateBindGroupLayout( device_, &cull_layout_descriptor )
+    );
+    LTB_CHECK_VALID( cull_bind_group_layout_ );
+
+    auto const render_entries = std::array{
+        WGPUBindGroupLayoutEntry{
+            .nextInChain = nullptr,
+            .binding     = 0U,
+            .visibility  = WGPUShaderStage_Vertex,
+            .buffer      = {
+                .nextInChain = nullptr,
+                .type        = WGPUBufferBindingType_ReadOnlyStorage,
+            },
+        },
+        WGPUBindGroupLayoutEntry{
+            .nextInChain = nullptr,
+            .binding     = 1U,
+            .visibility  = WGPUShaderStage_Vertex,
+            .buffer      = {
+                .nextInChain      = nullptr,
+                .type             = WGPUBufferBindingType_ReadOnlyStorage,
+                .hasDynamicOffset = !first_instance_,
+            },
+        },
+    };
+    auto const render_layout_descriptor = WGPUBindGroupLayoutDescriptor{
+        .nextInChain = nullptr,
+        .label       = to_wgpu_string_view( "GPU-driven render layout" ),
+        .entryCount  = render_entries.size( ),
+        .entries     = render_entries.data( ),
+    };
+    render_bind_group_layout_.reset(
+        ::wgpuDeviceCreateBindGroupLayout( device_, &render_layout_descriptor )
+    );
+    LTB_CHECK_VALID( render_bind_group_layout_ );
+
+    auto* const cull_layout                = cull_bind_group_layout_.get( );
+    auto const  pipeline_layout_descriptor = WGPUPipelineLayoutDescriptor{
+        .nextInChain          = nullptr,
+        .label                = to_wgpu_string_view( "GPU-driven cull pipeline layout" ),
+        .bindGroupLayoutCount = 1UZ,
+        .bindGroupLayouts     = &cull_layout,
+    };
+    cull_pipeline_layout_.reset(
+        ::wgpuDeviceCreatePipelineLayout( device_, &pipeline_layout_descriptor )
+    );
+    LTB_CHECK_VALID( cull_pipeline_layout_ );
+
+    auto const constants = std::array{
+        WGPUConstantEntry{
+            .nextInChain = nullptr,
+            .key         = to_wgpu_string_view( "workgroup_size" ),
+            .value       = static_cast< double >( settings_.cull_workgroup_size ),
+        },
+    };
+    auto const pipeline_descriptor = WGPUComputePipelineDescriptor{
+        .nextInChain = nullptr,
+        .label       = to_wgpu_string_view( "GPU-driven cull pipeline" ),
+        .layout      = cull_pipeline_layout_.get( ),
+        .compute     = {
+            .nextInChain   = nullptr,
+            .module        = shader.get( ),
+            .entryPoint    = to_wgpu_string_view( "cull" ),
+            .constantCount = constants.size( ),
+            .constants     = constants.data( ),
+        },
+    };
+    cull_pipeline_.reset( ::wgpuDeviceCreateComputePipeline( device_, &pipeline_descriptor ) );
+    LTB_CHECK_VALID( cull_pipeline_ );
+
+    LTB_CHECK(
+        culling_buffer_,
+        create_buffer(
+            *memory_tracker_,
+            device_,
+            "GPU-driven culling uniforms",
+            WGPUBufferUsage_Uniform | WGPUBufferUsage_CopyDst,
+            sizeof( CullingUniforms ),
+            GpuMemoryCategory::Uniform
+        )
+    );
+
+    return utils::success( );
+}
+
+auto GpuDrivenRenderer::set_meshes( std::vector< GpuMesh > meshes ) -> utils::Result< void >
+{
+    for ( auto const& mesh : meshes )
+    {
+        if ( mesh.lods.empty( ) || ( mesh.lods.size( ) > max_lod_count ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Meshes require between 1 and {} LODs, got {}",
+                max_lod_count,
+                mesh.lods.size( )
+            );
+        }
+    }
+
+    meshes_ = std::move( meshes );
+
+    // Slots are assigned per instance set, so the old instances are no longer valid.
+    release_buffers( );
+    return utils::success( );
+}
+
+auto GpuDrivenRenderer::set_instances( std::span< GpuInstance const > const instances )
+    -> utils::Result< void >
+{
+    LTB_CHECK_VALID( device_, "GpuDrivenRenderer not initialized" );
+
+    for ( auto const& instance : instances )
+    {
+        if ( instance.mesh >= meshes_.size( ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Instance references mesh {} but only {} meshes are set",
+                instance.mesh,
+                meshes_.size( )
+            );
+        }
+    }
+
+    auto const workgroup_count = round_up( instances.size( ), settings_.cull_workgroup_size )
+                               / settings_.cull_workgroup_size;
+    if ( workgroup_count > max_workgroups_ )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "{} instances require {} culling workgroups but the device allows {}",
+            instances.size( ),
+            workgroup_count,
+            max_workgroups_
+        );
+    }
+
+    release_buffers( );
+    return rebuild_buffers( instances );
+}
+
+auto GpuDrivenRenderer::encode_culling(
+    WGPUCommandEncoder const encoder,
+    glm::mat4 const&         view_projection,
+    glm::vec3 const&         camera_position
+) -> void
+{
+    if ( 0U == instance_count_ )
+    {
+        return;
+    }
+
+    // Reset the instance counts. Queue writes are ordered before the next submit.
+    ::wgpuQueueWriteBuffer(
+        queue_,
+        draw_args_buffer_.get( ),
+        0U,
+        initial_args_.data( ),
+        initial_args_.size( ) * sizeof( DrawArgs )
+    );
+
+    auto const uniforms = CullingUniforms{
+        .planes          = extract_frustum_planes( view_projection ),
+        .camera_position = glm::vec4( camera_position, 1.0F ),
+        .instance_count  = instance_count_,
+    };
+    ::wgpuQueueWriteBuffer( queue_, culling_buffer_.get( ), 0U, &uniforms, sizeof( uniforms ) );
+
+    wgpu_metrics( ).bytes_uploaded.add(
+        ( initial_args_.size( ) * sizeof( DrawArgs ) ) + sizeof( uniforms )
+    );
+
+    auto const pass_descriptor = WGPUComputePassDescriptor{
+        .nextInChain     = nullptr,
+        .label           = to_wgpu_string_view( "GPU-driven cull pass" ),
+        .timestampWrites = nullptr,
+    };
+    auto const pass = ComputePassEncoderHandle{
+        ::wgpuCommandEncoderBeginComputePass( encoder, &pass_descriptor ),
+    };
+    ::wgpuComputePassEncoderSetPipeline( pass.get( ), cull_pipeline_.get( ) );
+    ::wgpuComputePassEncoderSetBindGroup( pass.get( ), 0U, cull_bind_group_.get( ), 0UZ, nullptr );
+    ::wgpuComputePassEncoderDispatchWorkgroups(
+        pass.get( ),
+        ( instance_count_ + settings_.cull_workgroup_size - 1U ) / settings_.cull_workgroup_size,
+        1U,
+        1U
+    );
+    ::wgpuComputePassEncoderEnd( pass.get( ) );
+}
+
+auto GpuDrivenRenderer::draw( WGPURenderPassEncoder const pass ) const -> void
+{
+    if ( 0U == instance_count_ )
+    {
+        return;
+    }
+
+    auto const group = settings_.render_bind_group_index;
+
+    if ( first_instance_ )
+    {
+        ::wgpuRenderPassEncoderSetBindGroup( pass, group, render_bind_group_.get( ), 0UZ, nullptr );
+    }
+
+    for ( auto slot = 0UZ; slot < initial_args_.size( ); ++slot )
+    {
+        if ( !first_instance_ )
+        {
+            auto const offset = slot_offsets_[ slot ] * static_cast< uint32 >( sizeof( uint32 ) );
+            ::wgpuRenderPassEncoderSetBindGroup(
+                pass,
+                group,
+                render_bind_group_.get( ),
+                1UZ,
+                &offset
+            );
+        }
+        ::wgpuRenderPassEncoderDrawIndexedIndirect(
+            pass,
+            draw_args_buffer_.get( ),
+            slot * sizeof( DrawArgs )
+        );
+    }
+
+    wgpu_metrics( ).indirect_draws.add( initial_args_.size( ) );
+}
+
+auto GpuDrivenRenderer::render_bind_group_layout( ) const -> WGPUBindGroupLayout
+{
+    return render_bind_group_layout_.get( );
+}
+
+auto GpuDrivenRenderer::uses_first_instance( ) const -> bool
+{
+    return first_instance_;
+}
+
+auto GpuDrivenRenderer::draw_count( ) const -> uint32
+{
+    return ( 0U == instance_count_ ) ? 0U : static_cast< uint32 >( initial_args_.size( ) );
+}
+
+auto GpuDrivenRenderer::rebuild_buffers( std::span< GpuInstance const > const instances )
+    -> utils::Result< void >
+{
+    if ( instances.empty( ) )
+    {
+        return utils::success( );
+    }
+
+    auto mesh_instance_counts = std::vector< uint32 >( meshes_.size( ), 0U );
+    for ( auto const& instance : instances )
+    {
+        ++mesh_instance_counts[ instance.mesh ];
+    }
+
+    // Each (mesh, LOD) slot gets a region of the visible list large enough to hold
+    // every instance of the mesh. Regions are aligned so they can be bound with
+    // dynamic offsets when IndirectFirstInstance is unavailable.
+    auto const alignment_elements = std::max( storage_alignment_ / 4U, 1U );
+
+    auto mesh_infos    = std::vector< MeshInfo >{ };
+    auto visible_count = uint64{ 0U };
+
+    for ( auto mesh_index = 0UZ; mesh_index < meshes_.size( ); ++mesh_index )
+    {
+        auto const& lods        = meshes_[ mesh_index ].lods;
+        auto const  region_size
+            = round_up( mesh_instance_counts[ mesh_index ], alignment_elements );
+
+        auto info = MeshInfo{
+            .first_slot = static_cast< uint32 >( initial_args_.size( ) ),
+            .lod_count  = static_cast< uint32 >( lods.size( ) ),
+        };
+
+        for ( auto lod = 0UZ; lod < lods.size( ); ++lod )
+        {
+            info.lod_distances[ static_cast< glm::length_t >( lod ) ] = lods[ lod ].max_distance;
+
+            auto const offset = static_cast< uint32 >( visible_count );
+            initial_args_.emplace_back( DrawArgs{
+                .index_count    = lods[ lod ].index_count,
+                .instance_count = 0U,
+                .first_index    = lods[ lod ].first_index,
+                .base_vertex    = lods[ lod ].base_vertex,
+                .first_instance = first_instance_ ? offset : 0U,
+            } );
+            slot_offsets_.emplace_back( offset );
+            visible_count += region_size;
+        }
+
+        largest_slot_bytes_ = std::max( largest_slot_bytes_, region_size * sizeof( uint32 ) );
+        mesh_infos.emplace_back( info );
+    }
+
+    // Dynamic offsets bind `largest_slot_bytes_` starting at
+    // each region, so leave room past the end of the last one.
+    auto const visible_bytes = ( visible_count * sizeof( uint32 ) ) + largest_slot_bytes_;
+
+    LTB_CHECK(
+        instances_buffer_,
+        create_buffer(
+            *memory_tracker_,
+            device_,
+            "GPU-driven instances",
+            WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst,
+            instances.size_bytes( ),
+            GpuMemoryCategory::Storage
+        )
+    );
+    LTB_CHECK(
+        meshes_buffer_,
+        create_buffer(
+            *memory_tracker_,
+            device_,
+            "GPU-driven meshes",
+            WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst,
+            mesh_infos.size( ) * sizeof( MeshInfo ),
+            GpuMemoryCategory::Storage
+        )
+    );
+    LTB_CHECK(
+        slot_offsets_buffer_,
+        create_buffer(
+            *memory_tracker_,
+            device_,
+            "GPU-driven slot offsets",
+            WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst,
+            slot_offsets_.size( ) * sizeof( uint32 ),
+            GpuMemoryCategory::Storage
+        )
+    );
+    LTB_CHECK(
+        draw_args_buffer_,
+        create_buffer(
+            *memory_tracker_,
+            device_,
+            "GPU-driven draw arguments",
+            WGPUBufferUsage_Storage | WGPUBufferUsage_Indirect | WGPUBufferUsage_CopyDst,
+            initial_args_.size( ) * sizeof( DrawArgs ),
+            GpuMemoryCategory::Indirect
+        )
+    );
+    LTB_CHECK(
+        visible_buffer_,
+        create_buffer(
+            *memory_tracker_,
+            device_,
+            "GPU-driven visible instances",
+            WGPUBufferUsage_Storage,
+            visible_bytes,
+            GpuMemoryCategory::Storage
+        )
+    );
+
+    ::wgpuQueueWriteBuffer(
+        queue_,
+        instances_buffer_.get( ),
+        0U,
+        instances.data( ),
+        instances.size_bytes( )
+    );
+    ::wgpuQueueWriteBuffer(
+        queue_,
+        meshes_buffer_.get( ),
+        0U,
+        mesh_infos.data( ),
+        mesh_infos.size( ) * sizeof( MeshInfo )
+    );
+    ::wgpuQueueWriteBuffer(
+        queue_,
+        slot_offsets_buffer_.get( ),
+        0U,
+        slot_offsets_.data( ),
+        slot_offsets_.size( ) * sizeof( uint32 )
+    );
+
+    wgpu_metrics( ).bytes_uploaded.add(
+        instances.size_bytes( ) + ( mesh_infos.size( ) * sizeof( MeshInfo ) )
+        + ( slot_offsets_.size( ) * sizeof( uint32 ) )
+    );
+
+    auto const buffer_entry = []( uint32 const     binding,
+                                  WGPUBuffer const buffer,
+                                  uint64 const     size ) {
+        return WGPUBindGroupEntry{
+            .nextInChain = nullptr,
+            .binding     = binding,
+            .buffer      = buffer,
+            .offset      = 0U,
+            .size        = size,
+        };
+    };
+
+    auto const cull_entries = std::array{
+        buffer_entry( 0U, culling_buffer_.get( ), WGPU_WHOLE_SIZE ),
+        buffer_entry( 1U, instances_buffer_.get( ), WGPU_WHOLE_SIZE ),
+        buffer_entry( 2U, meshes_buffer_.get( ), WGPU_WHOLE_SIZE ),
+        buffer_entry( 3U, slot_offsets_buffer_.get( ), WGPU_WHOLE_SIZE ),
+        buffer_entry( 4U, draw_args_buffer_.get( ), WGPU_WHOLE_SIZE ),
+        buffer_entry( 5U, visible_buffer_.get( ), WGPU_WHOLE_SIZE ),
+    };
+    auto const cull_descriptor = WGPUBindGroupDescriptor{
+        .nextInChain = nullptr,
+        .label       = to_wgpu_string_view( "GPU-driven cull bind group" ),
+        .layout      = cull_bind_group_layout_.get( ),
+        .entryCount  = cull_entries.size( ),
+        .entries     = cull_entries.data( ),
+    };
+    cull_bind_group_.reset( ::wgpuDeviceCreateBindGroup( device_, &cull_descriptor ) );
+    LTB_CHECK_VALID( cull_bind_group_ );
+
+    auto const render_entries = std::array{
+        buffer_entry( 0U, instances_buffer_.get( ), WGPU_WHOLE_SIZE ),
+        buffer_entry(
+            1U,
+            visible_buffer_.get( ),
+            first_instance_ ? WGPU_WHOLE_SIZE : largest_slot_bytes_
+        ),
+    };
+    auto const render_descriptor = WGPUBindGroupDescriptor{
+        .nextInChain = nullptr,
+        .label       = to_wgpu_string_view( "GPU-driven render bind group" ),
+        .layout      = render_bind_group_layout_.get( ),
+        .entryCount  = render_entries.size( ),
+        .entries     = render_entries.data( ),
+    };
+    render_bind_group_.reset( ::wgpuDeviceCreateBindGroup( device_, &render_descriptor ) );
+    LTB_CHECK_VALID( render_bind_group_ );
+
+    instance_count_ = static_cast< uint32 >( instances.size( ) );
+    return utils::success( );
+}
+
+auto GpuDrivenRenderer::release_buffers( ) -> void
+{
+    instance_count_     = 0U;
+    largest_slot_bytes_ = 0U;
+    initial_args_.clear( );
+    slot_offsets_.clear( );
+
+    render_bind_group_.reset( );
+    cull_bind_group_.reset( );
+    visible_buffer_.reset( );
+    draw_args_buffer_.reset( );
+    slot_offsets_buffer_.reset( );
+    meshes_buffer_.reset( );
+    instances_buffer_.reset( );
+}
+
+} // namespace ltb::wgpu
@@ -0,0 +1,187 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+#include "ltb/wgpu/gpu_memory_tracker.hpp"
+#include "ltb/wgpu/handle.hpp"
+
+// external
+#include <glm/glm.hpp>
+#include <webgpu/webgpu.h>
+
+// standard
+#include <array>
+#include <span>
+#include <vector>
+
+namespace ltb::wgpu
+{
+
+/// \brief Per-instance data read by the culling pass and the vertex shader.
+///
+/// Matches the WGSL struct:
+/// \code
+/// struct Instance {
+///     transform: mat4x4f,
+///     bounding_sphere: vec4f,
+///     mesh: u32,
+/// }
+/// \endcode
+struct GpuInstance
+{
+    glm::mat4 transform = glm::mat4( 1.0F );
+
+    /// \brief Object-space bounding sphere (xyz = center, w = radius).
+    glm::vec4 bounding_sphere = { 0.0F, 0.0F, 0.0F, 1.0F };
+
+    /// \brief Index of the GpuMesh (see `GpuDrivenRenderer::set_meshes`) used by this instance.
+    uint32 mesh = 0U;
+
+    std::array< uint32, 3 > padding = { };
+};
+
+static_assert( sizeof( GpuInstance ) == 96UZ );
+
+/// \brief A range of the shared index buffer used to draw one level of detail.
+struct GpuMeshLod
+{
+    uint32 index_count = 0U;
+    uint32 first_index = 0U;
+    int32  base_vertex = 0;
+
+    /// \brief Instances closer than this distance (and further than
+    ///        the previous LOD) are drawn with this LOD.
+    float32 max_distance = 0.0F;
+};
+
+/// \brief A mesh with up to `max_lod_count` levels of detail, ordered from highest detail.
+struct GpuMesh
+{
+    std::vector< GpuMeshLod > lods = { };
+};
+
+struct GpuDrivenRendererSettings
+{
+    /// \brief The bind group index the user's render pipeline uses for the instance data.
+    uint32 render_bind_group_index = 0U;
+
+    /// \brief The workgroup size of the culling compute pass.
+    uint32 cull_workgroup_size = 64U;
+};
+
+/// \brief Renders large numbers of instances with a handful of indirect draws.
+///
+/// A compute pass performs frustum culling and LOD selection, writing
+/// `drawIndexedIndirect` arguments and a list of visible instance indices
+/// for every (mesh, LOD) pair. The CPU then issues one indirect draw per
+/// pair regardless of how many instances are visible.
+///
+/// The user's render pipeline must include `render_bind_group_layout()` at
+/// `render_bind_group_index` and look up instances like so:
+/// \code
+/// @group(N) @binding(0) var<storage, read> instances: array<Instance>;
+/// @group(N) @binding(1) var<storage, read> visible: array<u32>;
+///
+/// let instance = instances[visible[instance_index]];
+/// \endcode
+///
+/// When the device supports `IndirectFirstInstance` the visible list is
+/// bound once and each draw starts at its own `firstInstance`. Otherwise
+/// the visible list is re-bound per draw with a dynamic offset.
+class GpuDrivenRenderer
+{
+public:
+    static constexpr auto max_lod_count = 4UZ;
+
+    explicit GpuDrivenRenderer( GpuDrivenRendererSettings settings );
+    ~GpuDrivenRenderer( );
+
+    // No copy
+    GpuDrivenRenderer( GpuDrivenRenderer const& )                    = delete;
+    auto operator=( GpuDrivenRenderer const& ) -> GpuDrivenRenderer& = delete;
+
+    // Move only
+    GpuDrivenRenderer( GpuDrivenRenderer&& ) noexcept                    = default;
+    auto operator=( GpuDrivenRenderer&& ) noexcept -> GpuDrivenRenderer& = default;
+
+    /// \brief Creates the culling pipeline and bind group layouts. Buffers are
+    ///        allocated through `memory_tracker`, which must outlive this object.
+    auto initialize( WGPUDevice device, WGPUQueue queue, GpuMemoryTracker& memory_tracker )
+        -> utils::Result< void >;
+
+    /// \brief Sets the meshes instances can reference. Invalidates any instances previously set.
+    auto set_meshes( std::vector< GpuMesh > meshes ) -> utils::Result< void >;
+
+    /// \brief Uploads instance data to the GPU, reallocating buffers if needed.
+    auto set_instances( std::span< GpuInstance const > instances ) -> utils::Result< void >;
+
+    /// \brief Resets the draw arguments and records the culling compute pass.
+    ///        Must be submitted before the render pass that calls `draw`.
+    auto encode_culling(
+        WGPUCommandEncoder encoder,
+        glm::mat4 const&   view_projection,
+        glm::vec3 const&   camera_position
+    ) -> void;
+
+    /// \brief Issues the indirect draws. The render pipeline, vertex buffers,
+    ///        and index buffer must already be set on the pass.
+    auto draw( WGPURenderPassEncoder pass ) const -> void;
+
+    [[nodiscard( "Const getter" )]] auto render_bind_group_layout( ) const -> WGPUBindGroupLayout;
+
+    [[nodiscard( "Const getter" )]] auto uses_first_instance( ) const -> bool;
+
+    /// \brief The number of indirect draws issued by `draw`.
+    [[nodiscard( "Const getter" )]] auto draw_count( ) const -> uint32;
+
+private:
+    /// \brief Matches the WGSL `DrawIndexedIndirect` argument layout.
+    struct DrawArgs
+    {
+        uint32 index_count    = 0U;
+        uint32 instance_count = 0U;
+        uint32 first_index    = 0U;
+        int32  base_vertex    = 0;
+        uint32 first_instance = 0U;
+    };
+
+    GpuDrivenRendererSettings settings_;
+
+    // The device, queue and tracker are not owned and must outlive this object.
+    WGPUDevice        device_             = nullptr;
+    WGPUQueue         queue_              = nullptr;
+    GpuMemoryTracker* memory_tracker_     = nullptr;
+    bool              first_instance_     = false;
+    uint32            storage_alignment_  = 256U;
+    uint32            max_workgroups_     = 65535U;
+    uint32            instance_count_     = 0U;
+    uint64            largest_slot_bytes_ = 0U;
+
+    std::vector< GpuMesh >  meshes_       = { };
+    std::vector< DrawArgs > initial_args_ = { };
+    std::vector< uint32 >   slot_offsets_ = { };
+
+    BindGroupLayoutHandle cull_bind_group_layout_   = nullptr;
+    BindGroupLayoutHandle render_bind_group_layout_ = nullptr;
+    PipelineLayoutHandle  cull_pipeline_layout_     = nullptr;
+    ComputePipelineHandle cull_pipeline_            = nullptr;
+
+    TrackedBuffer culling_buffer_      = nullptr;
+    TrackedBuffer instances_buffer_    = nullptr;
+    TrackedBuffer meshes_buffer_       = nullptr;
+    TrackedBuffer slot_offsets_buffer_ = nullptr;
+    TrackedBuffer draw_args_buffer_    = nullptr;
+    TrackedBuffer visible_buffer_      = nullptr;
+
+    BindGroupHandle cull_bind_group_   = nullptr;
+    BindGroupHandle render_bind_group_ = nullptr;
+
+    auto rebuild_buffers( std::span< GpuInstance const > instances ) -> utils::Result< void >;
+    auto release_buffers( ) -> void;
+};
+
+} // namespace ltb::wgpu
@@ -0,0 +1,372 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/gpu_memory_tracker.hpp"
+
+// project
+#include "ltb/wgpu/string_view.hpp"
+#include "ltb/wgpu/wgpu_metrics.hpp"
+
+// external
+#include <magic_enum.hpp>
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <vector>
+
+namespace ltb::wgpu
+{
+namespace
+{
+
+struct TexelBlock
+{
+    uint64 bytes  = 4U;
+    uint32 width  = 1U;
+    uint32 height = 1U;
+};
+
+auto texel_block( WGPUTextureFormat const format ) -> TexelBlock
+{
+    switch ( format )
+    {
+        case WGPUTextureFormat_R8Unorm:
+        case WGPUTextureFormat_R8Snorm:
+        case WGPUTextureFormat_R8Uint:
+        case WGPUTextureFormat_R8Sint:
+        case WGPUTextureFormat_Stencil8:
+            return { .bytes = 1U };
+
+        case WGPUTextureFormat_R16Uint:
+        case WGPUTextureFormat_R16Sint:
+        case WGPUTextureFormat_R16Float:
+        case WGPUTextureFormat_RG8Unorm:
+        case WGPUTextureFormat_RG8Snorm:
+        case WGPUTextureFormat_RG8Uint:
+        case WGPUTextureFormat_RG8Sint:
+        case WGPUTextureFormat_Depth16Unorm:
+            return { .bytes = 2U };
+
+        case WGPUTextureFormat_RG32Float:
+        case WGPUTextureFormat_RG32Uint:
+        case WGPUTextureFormat_RG32Sint:
+        case WGPUTextureFormat_RGBA16Uint:
+        case WGPUTextureFormat_RGBA16Sint:
+        case WGPUTextureFormat_RGBA16Float:
+        case WGPUTextureFormat_Depth24PlusStencil8:
+        case WGPUTextureFormat_Depth32FloatStencil8:
+            return { .bytes = 8U };
+
+        case WGPUTextureFormat_RGBA32Float:
+        case WGPUTextureFormat_RGBA32Uint:
+        case WGPUTextureFormat_RGBA32Sint:
+            return { .bytes = 16U };
+
+        case WGPUTextureFormat_BC1RGBAUnorm:
+        case WGPUTextureFormat_BC1RGBAUnormSrgb:
+        case WGPUTextureFormat_BC4RUnorm:
+        case WGPUTextureFormat_BC4RSnorm:
+        case WGPUTextureFormat_ETC2RGB8Unorm:
+        case WGPUTextureFormat_ETC2RGB8UnormSrgb:
+        case WGPUTextureFormat_ETC2RGB8A1Unorm:
+        case WGPUTextureFormat_ETC2RGB8A1UnormSrgb:
+        case WGPUTextureFormat_EACR11Unorm:
+        case WGPUTextureFormat_EACR11Snorm:
+            return { .bytes = 8U, .width = 4U, .height = 4U };
+
+        case WGPUTextureFormat_BC2RGBAUnorm:
+        case WGPUTextureFormat_BC2RGBAUnormSrgb:
+        case WGPUTextureFormat_BC3RGBAUnorm:
+        case WGPUTextureFormat_BC3RGBAUnormSrgb:
+        case WGPUTextureFormat_BC5RGUnorm:
+        case WGPUTextureFormat_BC5RGSnorm:
+        case WGPUTextureFormat_BC6HRGBUfloat:
+        case WGPUTextureFormat_BC6HRGBFloat:
+        case WGPUTextureFormat_BC7RGBAUnorm:
+        case WGPUTextureFormat_BC7RGBAUnormSrgb:
+        case WGPUTextureFormat_ETC2RGBA8Unorm:
+        case WGPUTextureFormat_ETC2RGBA8UnormSrgb:
+        case WGPUTextureFormat_EACRG11Unorm:
+        case WGPUTextureFormat_EACRG11Snorm:
+            return { .bytes = 16U, .width = 4U, .height = 4U };
+
+        default:
+            // Every other uncompressed format we use is 4 bytes per texel.
+            return { };
+    }
+}
+
+auto blocks( uint32 const texels, uint32 const block_size ) -> uint64
+{
+    return ( static_cast< uint64 >( std::max( texels, 1U ) ) + block_size - 1U ) / block_size;
+}
+
+} // namespace
+
+GpuMemoryTracker::GpuMemoryTracker( GpuMemoryTrackerSettings settings )
+    : settings_( settings )
+{
+}
+
+auto GpuMemoryTracker::create_buffer(
+    WGPUDevice const            device,
+    WGPUBufferDescriptor const& descriptor,
+    GpuMemoryCategory const     category,
+    bool const                  streamable
+) -> utils::Result< TrackedBuffer >
+{
+    LTB_CHECK_VALID( device );
+
+    auto buffer = BufferHandle{ ::wgpuDeviceCreateBuffer( device, &descriptor ) };
+    LTB_CHECK_VALID( buffer, to_string_view( descriptor.label ) );
+
+    auto const id = track(
+        std::string( to_string_view( descriptor.label ) ),
+        category,
+        descriptor.size,
+        streamable
+    );
+    return TrackedBuffer{ std::move( buffer ), this, id };
+}
+
+auto GpuMemoryTracker::create_texture(
+    WGPUDevice const             device,
+    WGPUTextureDescriptor const& descriptor,
+    GpuMemoryCategory const      category,
+    bool const                   streamable
+) -> utils::Result< TrackedTexture >
+{
+    LTB_CHECK_VALID( device );
+
+    auto texture = TextureHandle{ ::wgpuDeviceCreateTexture( device, &descriptor ) };
+    LTB_CHECK_VALID( texture, to_string_view( descriptor.label ) );
+
+    auto const id = track(
+        std::string( to_string_view( descriptor.label ) ),
+        category,
+        texture_bytes( descriptor ),
+        streamable
+    );
+    return TrackedTexture{ std::move( texture ), this, id };
+}
+
+auto GpuMemoryTracker::track(
+    std::string             label,
+    GpuMemoryCategory const category,
+    uint64 const            bytes,
+    bool const              streamable
+) -> GpuAllocationId
+{
+    auto const id = next_id_++;
+    allocations_.emplace(
+        id,
+        GpuAllocationInfo{
+            .label           = std::move( label ),
+            .category        = category,
+            .bytes           = bytes,
+            .streamable      = streamable,
+            .last_used_frame = frame_,
+        }
+    );
+
+    current_bytes_    += bytes;
+    high_water_bytes_  = std::max( high_water_bytes_, current_bytes_ );
+
+    wgpu_metrics( ).memory_bytes.set( static_cast< float64 >( current_bytes_ ) );
+    wgpu_metrics( ).memory_high_water_bytes.set( static_cast< float64 >( high_water_bytes_ ) );
+
+    evict_to_budget( );
+    return id;
+}
+
+auto GpuMemoryTracker::untrack( GpuAllocationId const id ) -> void
+{
+    if ( auto iter = allocations_.find( id ); iter != allocations_.end( ) )
+    {
+        current_bytes_ -= iter->second.bytes;
+        allocations_.erase( iter );
+
+        if ( current_bytes_ <= settings_.budget_bytes )
+        {
+            over_budget_ = false;
+        }
+
+        wgpu_metrics( ).memory_bytes.set( static_cast< float64 >( current_bytes_ ) );
+    }
+}
+
+auto GpuMemoryTracker::touch( GpuAllocationId const id ) -> void
+{
+    if ( auto iter = allocations_.find( id ); iter != allocations_.end( ) )
+    {
+        iter->second.last_used_frame = frame_;
+    }
+}
+
+auto GpuMemoryTracker::begin_frame( ) -> void
+{
+    ++frame_;
+}
+
+auto GpuMemoryTracker::set_budget( uint64 const budget_bytes ) -> void
+{
+    settings_.budget_bytes = budget_bytes;
+    evict_to_budget( );
+}
+
+auto GpuMemoryTracker::set_eviction_callback( GpuEvictionCallback callback ) -> void
+{
+    eviction_callback_ = std::move( callback );
+}
+
+auto GpuMemoryTracker::budget_bytes( ) const -> uint64
+{
+    return settings_.budget_bytes;
+}
+
+auto GpuMemoryTracker::current_bytes( ) const -> uint64
+{
+    return current_bytes_;
+}
+
+auto GpuMemoryTracker::high_water_bytes( ) const -> uint64
+{
+    return high_water_bytes_;
+}
+
+auto GpuMemoryTracker::report( ) const -> GpuMemoryReport
+{
+    auto result = GpuMemoryReport{
+        .current_bytes    = current_bytes_,
+        .high_water_bytes = high_water_bytes_,
+        .budget_bytes     = settings_.budget_bytes,
+        .allocation_count = allocations_.size( ),
+    };
+    for ( auto const& [ id, info ] : allocations_ )
+    {
+        result.bytes_by_category[ info.category ] += info.bytes;
+        result.bytes_by_label[ info.label ] += info.bytes;
+    }
+    return result;
+}
+
+auto GpuMemoryTracker::log_report( ) const -> void
+{
+    auto const memory = report( );
+
+    spdlog::info(
+        "GPU memory: {} bytes in {} allocations (high-water {} bytes, budget {})",
+        memory.current_bytes,
+        memory.allocation_count,
+        memory.high_water_bytes,
+        ( 0U == memory.budget_bytes ) ? "none" : std::to_string( memory.budget_bytes )
+    );
+    for ( auto const& [ category, bytes ] : memory.bytes_by_category )
+    {
+        spdlog::info( " - {}: {} bytes", magic_enum::enum_name( category ), bytes );
+    }
+    for ( auto const& [ label, bytes ] : memory.bytes_by_label )
+    {
+        spdlog::info( " - '{}': {} bytes", label, bytes );
+    }
+}
+
+auto GpuMemoryTracker::evict_to_budget( ) -> void
+{
+    // Eviction callbacks may create replacement resources. Those
+    // must not start another round of evictions from inside this one.
+    if ( evicting_ )
+    {
+        return;
+    }
+    if ( ( 0U == settings_.budget_bytes ) || ( current_bytes_ <= settings_.budget_bytes ) )
+    {
+        over_budget_ = false;
+        return;
+    }
+
+    auto candidates = std::vector< std::pair< uint64, GpuAllocationId > >{ };
+    for ( auto const& [ id, info ] : allocations_ )
+    {
+        // Resources used this frame may still be referenced by commands being encoded.
+        if ( info.streamable && ( info.last_used_frame < frame_ ) )
+        {
+            candidates.emplace_back( info.last_used_frame, id );
+        }
+    }
+    std::sort( candidates.begin( ), candidates.end( ) );
+
+    evicting_ = true;
+    for ( auto const& [ last_used_frame, id ] : candidates )
+    {
+        if ( ( current_bytes_ <= settings_.budget_bytes ) || !eviction_callback_ )
+        {
+            break;
+        }
+        if ( auto iter = allocations_.find( id ); iter != allocations_.end( ) )
+        {
+            // Copy since the callback is expected to untrack the allocation.
+            auto const info = iter->second;
+            eviction_callback_( id, info );
+        }
+    }
+    evicting_ = false;
+
+    // Warn only when the budget is first crossed, not on every allocation while over it.
+    auto const over_budget = ( current_bytes_ > settings_.budget_bytes );
+    if ( over_budget && !over_budget_ )
+    {
+        spdlog::warn(
+            "GPU memory budget exceeded: {} of {} bytes in use",
+            current_bytes_,
+            settings_.budget_bytes
+        );
+    }
+    over_budget_ = over_budget;
+}
+
+auto texture_bytes( WGPUTextureDescriptor const& descriptor ) -> uint64
+{
+    auto const block  = texel_block( descriptor.format );
+    auto const is_3d  = ( WGPUTextureDimension_3D == descriptor.dimension );
+    auto const layers = is_3d ? 1U : std::max( descriptor.size.depthOrArrayLayers, 1U );
+
+    auto total = uint64{ 0U };
+    for ( auto level = 0U; level < std::max( descriptor.mipLevelCount, 1U ); ++level )
+    {
+        auto const width  = blocks( descriptor.size.width >> level, block.width );
+        auto const height = blocks( descriptor.size.height >> level, block.height );
+        auto const depth  = is_3d ? blocks( descriptor.size.depthOrArrayLayers >> level, 1U ) : 1U;
+
+        total += width * height * depth * block.bytes;
+    }
+    return total * layers * std::max( descriptor.sampleCount, 1U );
+}
+
+auto buffer_category( WGPUBufferUsage const usage ) -> GpuMemoryCategory
+{
+    if ( 0U != ( usage & ( WGPUBufferUsage_MapRead | WGPUBufferUsage_MapWrite ) ) )
+    {
+        return GpuMemoryCategory::Staging;
+    }
+    if ( 0U != ( usage & WGPUBufferUsage_Indirect ) )
+    {
+        return GpuMemoryCategory::Indirect;
+    }
+    if ( 0U != ( usage & ( WGPUBufferUsage_Vertex | WGPUBufferUsage_Index ) ) )
+    {
+        return GpuMemoryCategory::Geometry;
+    }
+    if ( 0U != ( usage & WGPUBufferUsage_Uniform ) )
+    {
+        return GpuMemoryCategory::Uniform;
+    }
+    if ( 0U != ( usage & WGPUBufferUsage_Storage ) )
+    {
+        return GpuMemoryCategory::Storage;
+    }
+    return GpuMemoryCategory::Other;
+}
+
+} // namespace ltb::wgpu
@@ -0,0 +1,269 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+#include "ltb/wgpu/handle.hpp"
+
+// external
+#include <webgpu/webgpu.h>
+
+// standard
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace ltb::wgpu
+{
+
+enum class GpuMemoryCategory
+{
+    Geometry,
+    Uniform,
+    Storage,
+    Indirect,
+    Staging,
+    Texture,
+    RenderTarget,
+    Other,
+};
+
+using GpuAllocationId = uint64;
+
+struct GpuAllocationInfo
+{
+    std::string       label    = "";
+    GpuMemoryCategory category = GpuMemoryCategory::Other;
+    uint64            bytes    = 0U;
+
+    /// \brief Streamable allocations can be evicted when the budget is exceeded.
+    bool streamable = false;
+
+    /// \brief The frame the allocation was created or last touched.
+    uint64 last_used_frame = 0U;
+};
+
+struct GpuMemoryReport
+{
+    uint64 current_bytes    = 0U;
+    uint64 high_water_bytes = 0U;
+
+    /// \brief Zero means there is no budget.
+    uint64 budget_bytes     = 0U;
+    uint64 allocation_count = 0U;
+
+    std::map< GpuMemoryCategory, uint64 > bytes_by_category = { };
+    std::map< std::string, uint64 >       bytes_by_label    = { };
+};
+
+/// \brief Called with the least recently used streamable allocations when the budget is
+///        exceeded. The callback should destroy the resource, which untracks it.
+using GpuEvictionCallback = std::function< void( GpuAllocationId, GpuAllocationInfo const& ) >;
+
+struct GpuMemoryTrackerSettings
+{
+    /// \brief Zero means there is no budget.
+    uint64 budget_bytes = 0U;
+};
+
+class GpuMemoryTracker;
+
+/// \brief A WebGPU handle whose memory is recorded by a GpuMemoryTracker until it is released.
+///
+/// The tracker must outlive every resource it creates.
+template < typename Impl >
+class TrackedResource
+{
+public:
+    TrackedResource( ) = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    TrackedResource( std::nullptr_t ) noexcept { }
+
+    TrackedResource( Handle< Impl > handle, GpuMemoryTracker* tracker, GpuAllocationId id );
+    ~TrackedResource( );
+
+    // No copy
+    TrackedResource( TrackedResource const& )                    = delete;
+    auto operator=( TrackedResource const& ) -> TrackedResource& = delete;
+
+    // Move only
+    TrackedResource( TrackedResource&& other ) noexcept;
+    auto operator=( TrackedResource&& other ) noexcept -> TrackedResource&;
+
+    [[nodiscard]] auto get( ) const noexcept -> Impl* { return handle_.get( ); }
+    [[nodiscard]] auto id( ) const noexcept -> GpuAllocationId { return id_; }
+
+    /// \brief Marks the resource as used this frame so it is evicted last.
+    auto touch( ) const -> void;
+
+    /// \brief Releases the handle and removes it from the tracker.
+    auto reset( ) -> void;
+
+    explicit operator bool( ) const noexcept { return static_cast< bool >( handle_ ); }
+
+    friend auto operator==( TrackedResource const& lhs, std::nullptr_t ) noexcept -> bool
+    {
+        return lhs.handle_ == nullptr;
+    }
+
+private:
+    Handle< Impl >    handle_  = nullptr;
+    GpuMemoryTracker* tracker_ = nullptr;
+    GpuAllocationId   id_      = 0U;
+};
+
+using TrackedBuffer  = TrackedResource< WGPUBufferImpl >;
+using TrackedTexture = TrackedResource< WGPUTextureImpl >;
+
+/// \brief Records the bytes of every buffer and texture created through it.
+///
+/// \code
+/// auto tracker = GpuMemoryTracker{ { .budget_bytes = 512ULL << 20U } };
+/// tracker.set_eviction_callback( [ & ]( GpuAllocationId id, GpuAllocationInfo const& ) {
+///     tiles.erase( id ); // Destroying the TrackedBuffer untracks it.
+/// } );
+///
+/// LTB_CHECK( auto tile, tracker.create_buffer( device, descriptor, category, true ) );
+///
+/// // Each frame:
+/// tracker.begin_frame( );
+/// tile.touch( );
+/// \endcode
+class GpuMemoryTracker
+{
+public:
+    explicit GpuMemoryTracker( GpuMemoryTrackerSettings settings = { } );
+
+    // No copy or move. Tracked resources point back to this object.
+    GpuMemoryTracker( GpuMemoryTracker const& )                        = delete;
+    GpuMemoryTracker( GpuMemoryTracker&& ) noexcept                    = delete;
+    auto operator=( GpuMemoryTracker const& ) -> GpuMemoryTracker&     = delete;
+    auto operator=( GpuMemoryTracker&& ) noexcept -> GpuMemoryTracker& = delete;
+
+    auto create_buffer(
+        WGPUDevice                  device,
+        WGPUBufferDescriptor const& descriptor,
+        GpuMemoryCategory           category,
+        bool                        streamable = false
+    ) -> utils::Result< TrackedBuffer >;
+
+    auto create_texture(
+        WGPUDevice                   device,
+        WGPUTextureDescriptor const& descriptor,
+        GpuMemoryCategory            category,
+        bool                         streamable = false
+    ) -> utils::Result< TrackedTexture >;
+
+    /// \brief Records memory allocated outside of this tracker.
+    auto track( std::string label, GpuMemoryCategory category, uint64 bytes, bool streamable )
+        -> GpuAllocationId;
+
+    auto untrack( GpuAllocationId id ) -> void;
+
+    /// \brief Marks the allocation as used in the current frame.
+    auto touch( GpuAllocationId id ) -> void;
+
+    /// \brief Advances the frame counter used to order evictions.
+    auto begin_frame( ) -> void;
+
+    /// \brief Zero removes the budget. Evicts immediately if the new budget is exceeded.
+    auto set_budget( uint64 budget_bytes ) -> void;
+
+    auto set_eviction_callback( GpuEvictionCallback callback ) -> void;
+
+    [[nodiscard( "Const getter" )]] auto budget_bytes( ) const -> uint64;
+    [[nodiscard( "Const getter" )]] auto current_bytes( ) const -> uint64;
+    [[nodiscard( "Const getter" )]] auto high_water_bytes( ) const -> uint64;
+
+    [[nodiscard( "Const getter" )]] auto report( ) const -> GpuMemoryReport;
+    auto log_report( ) const -> void;
+
+private:
+    GpuMemoryTrackerSettings settings_;
+    GpuEvictionCallback      eviction_callback_ = nullptr;
+
+    std::unordered_map< GpuAllocationId, GpuAllocationInfo > allocations_ = { };
+
+    GpuAllocationId next_id_          = 1U;
+    uint64          frame_            = 0U;
+    uint64          current_bytes_    = 0U;
+    uint64          high_water_bytes_ = 0U;
+    bool            evicting_         = false;
+
+    /// \brief Set once the budget-exceeded warning has been logged, until usage drops back.
+    bool over_budget_ = false;
+
+    auto evict_to_budget( ) -> void;
+};
+
+/// \brief The bytes needed for every mip level, layer and sample of a texture.
+auto texture_bytes( WGPUTextureDescriptor const& descriptor ) -> uint64;
+
+/// \brief The category a buffer is reported under when only its usage is known.
+auto buffer_category( WGPUBufferUsage usage ) -> GpuMemoryCategory;
+
+template < typename Impl >
+TrackedResource< Impl >::TrackedResource(
+    Handle< Impl >          handle,
+    GpuMemoryTracker* const tracker,
+    GpuAllocationId const   id
+)
+    : handle_( std::move( handle ) )
+    , tracker_( tracker )
+    , id_( id )
+{
+}
+
+template < typename Impl >
+TrackedResource< Impl >::~TrackedResource( )
+{
+    reset( );
+}
+
+template < typename Impl >
+TrackedResource< Impl >::TrackedResource( TrackedResource&& other ) noexcept
+    : handle_( std::move( other.handle_ ) )
+    , tracker_( std::exchange( other.tracker_, nullptr ) )
+    , id_( std::exchange( other.id_, 0U ) )
+{
+}
+
+template < typename Impl >
+auto TrackedResource< Impl >::operator=( TrackedResource&& other ) noexcept -> TrackedResource&
+{
+    if ( this != &other )
+    {
+        reset( );
+        handle_  = std::move( other.handle_ );
+        tracker_ = std::exchange( other.tracker_, nullptr );
+        id_      = std::exchange( other.id_, 0U );
+    }
+    return *this;
+}
+
+template < typename Impl >
+auto TrackedResource< Impl >::touch( ) const -> void
+{
+    if ( nullptr != tracker_ )
+    {
+        tracker_->touch( id_ );
+    }
+}
+
+template < typename Impl >
+auto TrackedResource< Impl >::reset( ) -> void
+{
+    handle_.reset( );
+    if ( auto* const tracker = std::exchange( tracker_, nullptr ); nullptr != tracker )
+    {
+        tracker->untrack( std::exchange( id_, 0U ) );
+    }
+}
+
+} // namespace ltb::wgpu
@@ -0,0 +1,158 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// external
+#include <webgpu/webgpu.h>
+
+#ifdef LTB_WGPU_LOG_HANDLES
+#include <spdlog/spdlog.h>
+#endif
+
+// standard
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+namespace ltb::wgpu
+{
+
+/// \brief Specialized for every WebGPU object type to provide its reference counting functions.
+template < typename Impl >
+struct HandleTraits;
+
+/// \brief A move-only owner of a single WebGPU object reference.
+///
+/// Holding a Handle costs exactly as much as holding the raw pointer: there is
+/// no control block and no atomic reference count on our side. Copies must be
+/// made explicitly with `clone()`, which calls `wgpu*AddRef`.
+///
+/// Destruction is only logged when the library is built with
+/// `LTB_WGPU_LOG_HANDLES` (the CMake option of the same name).
+template < typename Impl >
+class Handle
+{
+public:
+    using Traits = HandleTraits< Impl >;
+
+    Handle( ) = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    Handle( std::nullptr_t ) noexcept { }
+
+    /// \brief Takes ownership of an existing reference (e.g. from a `wgpu*Create*` call).
+    explicit Handle( Impl* const raw ) noexcept
+        : raw_( raw )
+    {
+    }
+
+    ~Handle( ) { reset( ); }
+
+    Handle( Handle const& )                    = delete;
+    auto operator=( Handle const& ) -> Handle& = delete;
+
+    Handle( Handle&& other ) noexcept
+        : raw_( std::exchange( other.raw_, nullptr ) )
+    {
+    }
+
+    auto operator=( Handle&& other ) noexcept -> Handle&
+    {
+        if ( this != &other )
+        {
+            reset( std::exchange( other.raw_, nullptr ) );
+        }
+        return *this;
+    }
+
+    /// \brief Adds a reference to an object owned elsewhere and wraps it.
+    static auto add_ref( Impl* const raw ) -> Handle
+    {
+        if ( nullptr != raw )
+        {
+            Traits::add_ref( raw );
+        }
+        return Handle{ raw };
+    }
+
+    /// \brief Creates a new owner of the same object.
+    [[nodiscard]] auto clone( ) const -> Handle { return add_ref( raw_ ); }
+
+    [[nodiscard]] auto get( ) const noexcept -> Impl* { return raw_; }
+
+    /// \brief Gives up ownership without releasing the reference.
+    [[nodiscard]] auto release( ) noexcept -> Impl* { return std::exchange( raw_, nullptr ); }
+
+    /// \brief Releases the current reference (if any) and takes ownership of `raw`.
+    auto reset( Impl* const raw = nullptr ) noexcept -> void
+    {
+        if ( auto* const old = std::exchange( raw_, raw ); nullptr != old )
+        {
+#ifdef LTB_WGPU_LOG_HANDLES
+            spdlog::debug( "Releasing WGPU {}: {}", Traits::name, fmt::ptr( old ) );
+#endif
+            Traits::release( old );
+        }
+    }
+
+    explicit operator bool( ) const noexcept { return nullptr != raw_; }
+
+    friend auto operator==( Handle const& lhs, std::nullptr_t ) noexcept -> bool
+    {
+        return nullptr == lhs.raw_;
+    }
+
+private:
+    Impl* raw_ = nullptr;
+};
+
+#define DETAIL_LTB_WGPU_HANDLE( Type )                                                             \
+    template <>                                                                                    \
+    struct HandleTraits< WGPU##Type##Impl >                                                        \
+    {                                                                                              \
+        static constexpr auto name = std::string_view( #Type );                                    \
+                                                                                                   \
+        static auto add_ref( WGPU##Type##Impl* const raw ) -> void                                 \
+        {                                                                                          \
+            ::wgpu##Type##AddRef( raw );                                                           \
+        }                                                                                          \
+                                                                                                   \
+        static auto release( WGPU##Type##Impl* const raw ) -> void                                 \
+        {                                                                                          \
+            ::wgpu##Type##Release( raw );                                                          \
+        }                                                                                          \
+    };                                                                                             \
+    using Type##Handle = Handle< WGPU##Type##Impl >;                                               \
+    static_assert( sizeof( Type##Handle ) == sizeof( WGPU##Type ) )
+
+DETAIL_LTB_WGPU_HANDLE( Adapter );
+DETAIL_LTB_WGPU_HANDLE( BindGroup );
+DETAIL_LTB_WGPU_HANDLE( BindGroupLayout );
+DETAIL_LTB_WGPU_HANDLE( Buffer );
+DETAIL_LTB_WGPU_HANDLE( CommandBuffer );
+DETAIL_LTB_WGPU_HANDLE( CommandEncoder );
+DETAIL_LTB_WGPU_HANDLE( ComputePassEncoder );
+DETAIL_LTB_WGPU_HANDLE( ComputePipeline );
+DETAIL_LTB_WGPU_HANDLE( Device );
+DETAIL_LTB_WGPU_HANDLE( ExternalTexture );
+DETAIL_LTB_WGPU_HANDLE( Instance );
+DETAIL_LTB_WGPU_HANDLE( PipelineLayout );
+DETAIL_LTB_WGPU_HANDLE( QuerySet );
+DETAIL_LTB_WGPU_HANDLE( Queue );
+DETAIL_LTB_WGPU_HANDLE( RenderBundle );
+DETAIL_LTB_WGPU_HANDLE( RenderBundleEncoder );
+DETAIL_LTB_WGPU_HANDLE( RenderPassEncoder );
+DETAIL_LTB_WGPU_HANDLE( RenderPipeline );
+DETAIL_LTB_WGPU_HANDLE( Sampler );
+DETAIL_LTB_WGPU_HANDLE( ShaderModule );
+DETAIL_LTB_WGPU_HANDLE( SharedBufferMemory );
+DETAIL_LTB_WGPU_HANDLE( SharedFence );
+DETAIL_LTB_WGPU_HANDLE( SharedTextureMemory );
+DETAIL_LTB_WGPU_HANDLE( Surface );
+DETAIL_LTB_WGPU_HANDLE( Texture );
+DETAIL_LTB_WGPU_HANDLE( TextureView );
+
+#undef DETAIL_LTB_WGPU_HANDLE
+
+} // namespace ltb::wgpu
@@ -0,0 +1,293 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/kernel_autotuner.hpp"
+
+// project
+#include "ltb/utils/generic_guard.hpp"
+#include "ltb/wgpu/string_view.hpp"
+
+// external
+#include <magic_enum.hpp>
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace ltb::wgpu
+{
+
+KernelAutotuner::KernelAutotuner( KernelAutotunerSettings settings )
+    : settings_( std::move( settings ) )
+    , cache_(
+          settings_.cache_file,
+          "kernel_autotuner",
+          utils::make_flags( utils::JsonSettingsFlag::NoImplicitSave )
+      )
+{
+}
+
+auto KernelAutotuner::register_kernel(
+    std::string                  kernel_name,
+    std::vector< KernelVariant > variants,
+    KernelBenchmark              benchmark
+) -> void
+{
+    kernels_.insert_or_assign(
+        std::move( kernel_name ),
+        RegisteredKernel{
+            .variants  = std::move( variants ),
+            .benchmark = std::move( benchmark ),
+        }
+    );
+}
+
+auto KernelAutotuner::tune( WGPUAdapter const adapter, WGPUDevice const device )
+    -> utils::Result< void >
+{
+    LTB_CHECK_VALID( adapter );
+    LTB_CHECK_VALID( device );
+
+    auto limits = WGPULimits{ };
+    if ( WGPUStatus_Success != ::wgpuDeviceGetLimits( device, &limits ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Could not get WebGPU device limits" );
+    }
+
+    auto info = WGPUAdapterInfo{ };
+    if ( WGPUStatus_Success != ::wgpuAdapterGetInfo( adapter, &info ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Could not get WebGPU adapter info" );
+    }
+    auto const key = adapter_key( info );
+    ::wgpuAdapterInfoFreeMembers( info );
+
+    auto& tuned_kernels  = cache_->adapters[ key ];
+    auto  cache_changed  = false;
+    auto  failed_kernels = std::vector< std::string >{ };
+
+    // Kernels tuned before a failure are still worth keeping, so save on every return. This
+    // runs while an error may be returned, so it must not throw.
+    auto const save_cache = utils::make_guard(
+        [] { },
+        [ this, &cache_changed ] {
+            if ( !cache_changed )
+            {
+                return;
+            }
+            try
+            {
+                cache_.save_settings( );
+            }
+            catch ( std::exception const& exception )
+            {
+                spdlog::warn(
+                    "Failed to save kernel autotuner cache '{}': {}",
+                    settings_.cache_file.string( ),
+                    exception.what( )
+                );
+            }
+        }
+    );
+
+    for ( auto const& [ kernel_name, kernel ] : kernels_ )
+    {
+        auto valid_variants = std::vector< KernelVariant const* >{ };
+        for ( auto const& variant : kernel.variants )
+        {
+            if ( fits_limits( variant, limits ) )
+            {
+                valid_variants.emplace_back( &variant );
+            }
+            else
+            {
+                spdlog::debug(
+                    "Kernel '{}' variant '{}' exceeds device limits",
+                    kernel_name,
+                    variant.name
+                );
+            }
+        }
+
+        // Other kernels may still fit, so skip this one and report it after the rest.
+        if ( valid_variants.empty( ) )
+        {
+            spdlog::warn( "No variant of kernel '{}' fits the device limits", kernel_name );
+            failed_kernels.emplace_back( kernel_name );
+            continue;
+        }
+
+        // Use the persisted result if it still refers to a valid variant.
+        if ( auto const cached = tuned_kernels.find( kernel_name );
+             !settings_.force_retune && ( cached != tuned_kernels.end( ) ) )
+        {
+            auto const variant_iter
+                = std::ranges::find_if( valid_variants, [ &cached ]( auto const* variant ) {
+                      return variant->name == cached->second.variant_name;
+                  } );
+
+            if ( variant_iter != valid_variants.end( ) )
+            {
+                spdlog::debug(
+                    "Kernel '{}' using cached variant '{}'",
+                    kernel_name,
+                    cached->second.variant_name
+                );
+                selected_.insert_or_assign( kernel_name, **variant_iter );
+                continue;
+            }
+        }
+
+        auto const* fastest_variant = static_cast< KernelVariant const* >( nullptr );
+        auto        best_duration   = utils::Duration::max( );
+
+        for ( auto const* variant : valid_variants )
+        {
+            auto duration = benchmark_variant( kernel, *variant );
+            if ( !duration )
+            {
+                // Other variants can't succeed on a lost device, so stop tuning.
+                if ( utils::ErrorCode::DeviceLost == duration.error( ).code( ) )
+                {
+                    return tl::make_unexpected( std::move( duration ).error( ) );
+                }
+                spdlog::warn(
+                    "Kernel '{}' variant '{}' failed: {}",
+                    kernel_name,
+                    variant->name,
+                    duration.error( ).error_message( )
+                );
+                continue;
+            }
+
+            spdlog::debug(
+                "Kernel '{}' variant '{}': {}us",
+                kernel_name,
+                variant->name,
+                utils::to_micros( duration.value( ) )
+            );
+
+            if ( duration.value( ) < best_duration )
+            {
+                fastest_variant = variant;
+                best_duration   = duration.value( );
+            }
+        }
+
+        if ( nullptr == fastest_variant )
+        {
+            spdlog::warn( "Every variant of kernel '{}' failed", kernel_name );
+            failed_kernels.emplace_back( kernel_name );
+            continue;
+        }
+
+        spdlog::info(
+            "Kernel '{}' tuned: '{}' ({}us)",
+            kernel_name,
+            fastest_variant->name,
+            utils::to_micros( best_duration )
+        );
+
+        tuned_kernels.insert_or_assign(
+            kernel_name,
+            TunedKernel{
+                .variant_name = fastest_variant->name,
+                .nanoseconds  = utils::to_nanos< int64 >( best_duration ),
+            }
+        );
+        selected_.insert_or_assign( kernel_name, *fastest_variant );
+        cache_changed = true;
+    }
+
+    if ( !failed_kernels.empty( ) )
+    {
+        auto names = std::string{ };
+        for ( auto const& kernel_name : failed_kernels )
+        {
+            names += ( names.empty( ) ? "'" : ", '" ) + kernel_name + "'";
+        }
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Could not tune {} kernel(s): {}",
+            failed_kernels.size( ),
+            names
+        );
+    }
+
+    return utils::success( );
+}
+
+auto KernelAutotuner::best_variant( std::string const& kernel_name ) const
+    -> utils::Result< KernelVariant >
+{
+    if ( auto const iter = selected_.find( kernel_name ); iter != selected_.end( ) )
+    {
+        return iter->second;
+    }
+    return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+        utils::ErrorCode::CacheMiss,
+        "Kernel '{}' has not been tuned",
+        kernel_name
+    );
+}
+
+auto KernelAutotuner::benchmark_variant(
+    RegisteredKernel const& kernel,
+    KernelVariant const&    variant
+) const -> utils::Result< utils::Duration >
+{
+    LTB_CHECK_VALID( kernel.benchmark );
+
+    for ( auto i = 0U; i < settings_.warmup_iterations; ++i )
+    {
+        LTB_CHECK( kernel.benchmark( variant ) );
+    }
+
+    auto durations = std::vector< utils::Duration >{ };
+    durations.reserve( settings_.timed_iterations );
+
+    for ( auto i = 0U; i < std::max( settings_.timed_iterations, 1U ); ++i )
+    {
+        LTB_CHECK( auto duration, kernel.benchmark( variant ) );
+        durations.emplace_back( duration );
+    }
+
+    // The median is less sensitive to scheduling hiccups than the mean.
+    auto const middle
+        = durations.begin( ) + static_cast< std::ptrdiff_t >( durations.size( ) / 2UZ );
+    std::ranges::nth_element( durations, middle );
+    return *middle;
+}
+
+auto adapter_key( WGPUAdapterInfo const& info ) -> std::string
+{
+    return fmt::format(
+        "{:04x}:{:04x}:{}:{}",
+        info.vendorID,
+        info.deviceID,
+        magic_enum::enum_name( info.backendType ),
+        to_string_view( info.description )
+    );
+}
+
+auto fits_limits( KernelVariant const& variant, WGPULimits const& limits ) -> bool
+{
+    auto const& size = variant.workgroup_size;
+
+    if ( ( 0U == size.x ) || ( 0U == size.y ) || ( 0U == size.z ) )
+    {
+        return false;
+    }
+
+    auto const invocations = uint64{ size.x } * uint64{ size.y } * uint64{ size.z };
+
+    return ( size.x <= limits.maxComputeWorkgroupSizeX )
+        && ( size.y <= limits.maxComputeWorkgroupSizeY )
+        && ( size.z <= limits.maxComputeWorkgroupSizeZ )
+        && ( invocations <= limits.maxComputeInvocationsPerWorkgroup )
+        && ( variant.workgroup_storage_bytes <= limits.maxComputeWorkgroupStorageSize );
+}
+
+} // namespace ltb::wgpu
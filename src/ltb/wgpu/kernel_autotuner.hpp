@@ -0,0 +1,123 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/duration.hpp"
+#include "ltb/utils/json_settings.hpp"
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+
+// external
+#include <glm/glm.hpp>
+#include <webgpu/webgpu.h>
+
+// standard
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ltb::wgpu
+{
+
+/// \brief A single launch configuration of a compute kernel.
+struct KernelVariant
+{
+    /// \brief Unique (per kernel) name used to persist the tuning result.
+    std::string name = "";
+
+    /// \brief The @workgroup_size used by the variant.
+    glm::uvec3 workgroup_size = { 1U, 1U, 1U };
+
+    /// \brief The number of elements each workgroup processes per dimension.
+    glm::uvec2 tile_size = { 1U, 1U };
+
+    /// \brief Bytes of var<workgroup> memory the variant requires.
+    uint32 workgroup_storage_bytes = 0U;
+};
+
+/// \brief Runs a kernel variant once (including waiting for the GPU) and returns its duration.
+using KernelBenchmark = std::function< utils::Result< utils::Duration >( KernelVariant const& ) >;
+
+/// \brief The persisted outcome of tuning a single kernel.
+struct TunedKernel
+{
+    std::string variant_name = "";
+    int64       nanoseconds  = 0;
+};
+
+/// \brief Tuning results for every adapter this machine has seen.
+struct KernelAutotuneCache
+{
+    /// \brief adapter key -> kernel name -> result
+    std::map< std::string, std::map< std::string, TunedKernel > > adapters = { };
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT( TunedKernel, variant_name, nanoseconds )
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT( KernelAutotuneCache, adapters )
+
+struct KernelAutotunerSettings
+{
+    /// \brief JSON file where the winning variants are stored between runs.
+    std::filesystem::path cache_file = "kernel_autotuner.json";
+
+    /// \brief Untimed runs used to warm up caches and lazy pipeline creation.
+    uint32 warmup_iterations = 2U;
+
+    /// \brief Timed runs per variant. The median duration is used for comparison.
+    uint32 timed_iterations = 5U;
+
+    /// \brief Ignore any persisted results and benchmark every kernel again.
+    bool force_retune = false;
+};
+
+/// \brief Benchmarks registered kernel variants against the device limits and
+///        remembers the fastest variant per adapter so later runs skip tuning.
+class KernelAutotuner
+{
+public:
+    explicit KernelAutotuner( KernelAutotunerSettings settings );
+
+    /// \brief Adds a kernel to be tuned. Variants that exceed the device limits are skipped.
+    auto register_kernel(
+        std::string                  kernel_name,
+        std::vector< KernelVariant > variants,
+        KernelBenchmark              benchmark
+    ) -> void;
+
+    /// \brief Selects a variant for every registered kernel, benchmarking
+    ///        only those without a persisted result for this adapter.
+    ///        Kernels that can't be tuned are skipped and reported together in
+    ///        the error once the rest are tuned. Only a lost device stops early.
+    auto tune( WGPUAdapter adapter, WGPUDevice device ) -> utils::Result< void >;
+
+    /// \brief The variant selected for `kernel_name` by the last call to `tune`.
+    [[nodiscard]] auto best_variant( std::string const& kernel_name ) const
+        -> utils::Result< KernelVariant >;
+
+private:
+    struct RegisteredKernel
+    {
+        std::vector< KernelVariant > variants  = { };
+        KernelBenchmark              benchmark = nullptr;
+    };
+
+    KernelAutotunerSettings                    settings_;
+    utils::JsonSettings< KernelAutotuneCache > cache_;
+    std::map< std::string, RegisteredKernel >  kernels_  = { };
+    std::map< std::string, KernelVariant >     selected_ = { };
+
+    auto benchmark_variant( RegisteredKernel const& kernel, KernelVariant const& variant ) const
+        -> utils::Result< utils::Duration >;
+};
+
+/// \brief A stable identifier for an adapter built from its vendor, device and driver details.
+auto adapter_key( WGPUAdapterInfo const& info ) -> std::string;
+
+/// \brief Returns true if the variant can be dispatched on a device with the given limits.
+auto fits_limits( KernelVariant const& variant, WGPULimits const& limits ) -> bool;
+
+} // namespace ltb::wgpu
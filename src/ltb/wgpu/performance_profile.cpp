@@ -0,0 +1,53 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/performance_profile.hpp"
+
+// project
+#include "ltb/utils/string.hpp"
+
+// external
+#include <magic_enum.hpp>
+
+namespace ltb::wgpu
+{
+
+auto device_toggles( PerformanceProfile const profile ) -> DeviceToggles
+{
+    auto toggles = DeviceToggles{ };
+
+    switch ( profile )
+    {
+        case PerformanceProfile::Default:
+            break;
+
+        case PerformanceProfile::Trusted:
+            toggles.enabled.emplace_back( "skip_validation" );
+            [[fallthrough]];
+
+        case PerformanceProfile::Release:
+            toggles.enabled.emplace_back( "disable_robustness" );
+            toggles.enabled.emplace_back( "disable_lazy_clear_for_mapped_at_creation_buffer" );
+            break;
+    }
+
+    return toggles;
+}
+
+auto to_performance_profile( std::string const& name ) -> utils::Result< PerformanceProfile >
+{
+    for ( auto const& [ value, value_name ] : magic_enum::enum_entries< PerformanceProfile >( ) )
+    {
+        if ( utils::to_lower_ascii( name ) == utils::to_lower_ascii( std::string( value_name ) ) )
+        {
+            return value;
+        }
+    }
+    return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+        utils::ErrorCode::InvalidArgument,
+        "Unrecognized performance profile: '{}'",
+        name
+    );
+}
+
+} // namespace ltb::wgpu
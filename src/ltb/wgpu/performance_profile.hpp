@@ -0,0 +1,43 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/result.hpp"
+
+// standard
+#include <string>
+#include <vector>
+
+namespace ltb::wgpu
+{
+
+/// \brief Trades safety checks for lower CPU overhead per draw and dispatch.
+enum class PerformanceProfile
+{
+    /// \brief Dawn defaults: full validation and robust buffer access.
+    Default,
+
+    /// \brief Keeps validation but disables robustness transforms in shaders
+    ///        and skips clearing buffers that are mapped at creation.
+    Release,
+
+    /// \brief Everything in Release plus skipping validation. Only
+    ///        use this for builds whose WebGPU usage is known to be valid.
+    Trusted,
+};
+
+/// \brief Dawn toggle names passed to the device through a WGPUDawnTogglesDescriptor.
+struct DeviceToggles
+{
+    std::vector< char const* > enabled  = { };
+    std::vector< char const* > disabled = { };
+};
+
+auto device_toggles( PerformanceProfile profile ) -> DeviceToggles;
+
+/// \brief Parses a profile name (case-insensitive), for example from the command line.
+auto to_performance_profile( std::string const& name ) -> utils::Result< PerformanceProfile >;
+
+} // namespace ltb::wgpu
@@ -0,0 +1,280 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/queue_utils.hpp"
+
+// project
+#include "ltb/utils/timers.hpp"
+#include "ltb/wgpu/handle.hpp"
+#include "ltb/wgpu/string_view.hpp"
+#include "ltb/wgpu/wgpu_metrics.hpp"
+
+// external
+#include <magic_enum.hpp>
+
+// standard
+#include <array>
+#include <cstring>
+
+namespace ltb::wgpu
+{
+namespace
+{
+
+/// \brief Buffer writes and mapped ranges must be sized in whole words.
+constexpr auto buffer_copy_alignment = uint64{ 4U };
+
+auto round_up_to_copy_alignment( uint64 const size ) -> uint64
+{
+    auto const words = ( size + buffer_copy_alignment - 1U ) / buffer_copy_alignment;
+    return words * buffer_copy_alignment;
+}
+
+struct WorkDoneData
+{
+    bool                    done    = false;
+    WGPUQueueWorkDoneStatus status  = WGPUQueueWorkDoneStatus_Success;
+    std::string             message = "";
+};
+
+auto on_work_done(
+    WGPUQueueWorkDoneStatus const status,
+    WGPUStringView const          message,
+    void* const                   userdata1,
+    void* const                   userdata2
+) -> void
+{
+    utils::ignore( userdata2 );
+
+    auto* data    = static_cast< WorkDoneData* >( userdata1 );
+    data->status  = status;
+    data->message = to_string_view( message );
+    data->done    = true;
+}
+
+} // namespace
+
+auto wait_for_queue( WGPUInstance const instance, WGPUQueue const queue ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( instance );
+    LTB_CHECK_VALID( queue );
+
+    auto data = WorkDoneData{ };
+    utils::ignore(
+        ::wgpuQueueOnSubmittedWorkDone(
+            queue,
+            WGPUQueueWorkDoneCallbackInfo{
+                .nextInChain = nullptr,
+                .mode        = WGPUCallbackMode_AllowProcessEvents,
+                .callback    = &on_work_done,
+                .userdata1   = &data,
+                .userdata2   = nullptr,
+            }
+        )
+    );
+
+    while ( !data.done )
+    {
+        ::wgpuInstanceProcessEvents( instance );
+    }
+
+    if ( WGPUQueueWorkDoneStatus_Success != data.status )
+    {
+        // Submitted work only fails to complete when the device is lost or destroyed.
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            utils::ErrorCode::DeviceLost,
+            "Queue work failed ({}): {}",
+            magic_enum::enum_name( data.status ),
+            data.message
+        );
+    }
+
+    return utils::success( );
+}
+
+auto submit_and_wait(
+    WGPUInstance const      instance,
+    WGPUDevice const        device,
+    WGPUQueue const         queue,
+    EncodeCallback const&   encode,
+    ApiTraceRecorder* const api_trace
+) -> utils::Result< utils::Duration >
+{
+    LTB_CHECK_VALID( device );
+
+    constexpr auto encoder_descriptor = WGPUCommandEncoderDescriptor{ };
+
+    auto const encoder = CommandEncoderHandle{
+        ( nullptr != api_trace ) ? api_trace->create_command_encoder( device )
+                                 : ::wgpuDeviceCreateCommandEncoder( device, &encoder_descriptor ),
+    };
+    LTB_CHECK_VALID( encoder );
+
+    if ( encode )
+    {
+        encode( encoder.get( ) );
+    }
+
+    constexpr auto command_buffer_descriptor = WGPUCommandBufferDescriptor{ };
+
+    auto const commands = CommandBufferHandle{
+        ( nullptr != api_trace )
+            ? api_trace->finish( encoder.get( ) )
+            : ::wgpuCommandEncoderFinish( encoder.get( ), &command_buffer_descriptor ),
+    };
+    LTB_CHECK_VALID( commands );
+
+    auto* const raw_commands = commands.get( );
+
+    auto timer = utils::Timer{ };
+    if ( nullptr != api_trace )
+    {
+        api_trace->submit( queue, std::span( &raw_commands, 1UZ ) );
+    }
+    else
+    {
+        ::wgpuQueueSubmit( queue, 1UZ, &raw_commands );
+    }
+
+    LTB_CHECK( wait_for_queue( instance, queue ) );
+    auto const duration = timer.duration_since_start( );
+
+    auto& metrics = wgpu_metrics( );
+    metrics.queue_submits.add( );
+    metrics.submit_to_idle_seconds.observe( utils::to_seconds< float64 >( duration ) );
+
+    return duration;
+}
+
+auto write_buffer(
+    WGPUQueue const                    queue,
+    WGPUBuffer const                   buffer,
+    uint64 const                       buffer_offset,
+    std::span< std::byte const > const bytes
+) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( buffer );
+    LTB_CHECK_VALID( 0U == ( buffer_offset % buffer_copy_alignment ) );
+
+    if ( 0U != ( bytes.size( ) % buffer_copy_alignment ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            utils::ErrorCode::InvalidArgument,
+            "Buffer writes must be a multiple of {} bytes, got {}",
+            buffer_copy_alignment,
+            bytes.size( )
+        );
+    }
+
+    if ( !bytes.empty( ) )
+    {
+        ::wgpuQueueWriteBuffer( queue, buffer, buffer_offset, bytes.data( ), bytes.size( ) );
+    }
+
+    return utils::success( );
+}
+
+auto create_buffer_with_data(
+    GpuMemoryTracker&                  memory_tracker,
+    WGPUDevice const                   device,
+    std::span< std::byte const > const bytes,
+    WGPUBufferUsage const              usage,
+    std::string_view const             label
+) -> utils::Result< TrackedBuffer >
+{
+    LTB_CHECK_VALID( device );
+
+    // Round up so the whole buffer can be mapped, leaving any padding zeroed.
+    auto const size = round_up_to_copy_alignment( bytes.size( ) );
+
+    auto const descriptor = WGPUBufferDescriptor{
+        .nextInChain      = nullptr,
+        .label            = to_wgpu_string_view( label ),
+        .usage            = usage,
+        .size             = size,
+        .mappedAtCreation = true,
+    };
+    LTB_CHECK(
+        auto buffer,
+        memory_tracker.create_buffer( device, descriptor, buffer_category( usage ) )
+    );
+
+    if ( size > 0U )
+    {
+        auto* const mapped = ::wgpuBufferGetMappedRange( buffer.get( ), 0U, size );
+        LTB_CHECK_VALID( mapped, "Could not map the new buffer" );
+        std::memcpy( mapped, bytes.data( ), bytes.size( ) );
+    }
+    ::wgpuBufferUnmap( buffer.get( ) );
+
+    return buffer;
+}
+
+auto stream_to_buffer(
+    WGPUInstance const            instance,
+    WGPUQueue const               queue,
+    WGPUBuffer const              buffer,
+    utils::ChunkedFileReader&     reader,
+    StreamToBufferSettings const& settings
+) -> utils::Result< uint64 >
+{
+    LTB_CHECK_VALID( buffer );
+    LTB_CHECK_VALID( reader.is_open( ) );
+    LTB_CHECK_VALID( 0U == ( reader.settings( ).chunk_size % buffer_copy_alignment ) );
+
+    // The last word is padded when the file size isn't a multiple of four, so the buffer
+    // must have room for the rounded-up size.
+    auto const padded_size = round_up_to_copy_alignment( reader.size( ) );
+    auto const buffer_size = ::wgpuBufferGetSize( buffer );
+    if ( ( settings.buffer_offset > buffer_size )
+         || ( padded_size > buffer_size - settings.buffer_offset ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR_WITH_CODE(
+            utils::ErrorCode::InvalidArgument,
+            "A {} byte buffer can't hold {} padded bytes at offset {}",
+            buffer_size,
+            padded_size,
+            settings.buffer_offset
+        );
+    }
+
+    auto uploaded  = uint64{ 0U };
+    auto in_flight = uint64{ 0U };
+
+    while ( true )
+    {
+        LTB_CHECK( auto chunk, reader.next( ) );
+        if ( !chunk )
+        {
+            break;
+        }
+
+        auto const bytes        = chunk->bytes( );
+        auto const offset       = settings.buffer_offset + chunk->offset( );
+        auto const aligned_size = bytes.size( ) - ( bytes.size( ) % buffer_copy_alignment );
+        LTB_CHECK( write_buffer( queue, buffer, offset, bytes.first( aligned_size ) ) );
+
+        // Only the last chunk can have a partial word, which lands in the padding checked above.
+        if ( auto const tail = bytes.subspan( aligned_size ); !tail.empty( ) )
+        {
+            auto padded = std::array< std::byte, buffer_copy_alignment >{ };
+            std::memcpy( padded.data( ), tail.data( ), tail.size( ) );
+            LTB_CHECK( write_buffer( queue, buffer, offset + aligned_size, padded ) );
+        }
+
+        // The write copied the chunk, so the reader can start refilling its buffer now.
+        chunk->release( );
+
+        uploaded  += bytes.size( );
+        in_flight += bytes.size( );
+        if ( in_flight >= settings.max_in_flight_bytes )
+        {
+            LTB_CHECK( wait_for_queue( instance, queue ) );
+            in_flight = 0U;
+        }
+    }
+
+    return uploaded;
+}
+
+} // namespace ltb::wgpu
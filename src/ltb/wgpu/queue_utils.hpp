@@ -0,0 +1,89 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/chunked_file_reader.hpp"
+#include "ltb/utils/duration.hpp"
+#include "ltb/utils/result.hpp"
+#include "ltb/wgpu/api_trace.hpp"
+#include "ltb/wgpu/gpu_memory_tracker.hpp"
+#include "ltb/wgpu/handle.hpp"
+
+// external
+#include <webgpu/webgpu.h>
+
+// standard
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string_view>
+
+namespace ltb::wgpu
+{
+
+using EncodeCallback = std::function< void( WGPUCommandEncoder ) >;
+
+/// \brief Blocks, processing instance events, until all work
+///        previously submitted to the queue has completed.
+auto wait_for_queue( WGPUInstance instance, WGPUQueue queue ) -> utils::Result< void >;
+
+/// \brief Records commands with `encode`, submits them, and waits for the GPU to finish.
+///        When `api_trace` is set the encoder is created, finished and submitted through it.
+/// \returns the wall-clock time from submission until the work completed.
+auto submit_and_wait(
+    WGPUInstance          instance,
+    WGPUDevice            device,
+    WGPUQueue             queue,
+    EncodeCallback const& encode,
+    ApiTraceRecorder*     api_trace = nullptr
+) -> utils::Result< utils::Duration >;
+
+/// \brief Writes `bytes` into `buffer` straight from the caller's memory, for example a
+///        `utils::MappedFile`, with no intermediate copy. `buffer_offset` and the size of
+///        `bytes` must be multiples of four, so nothing outside the range is written.
+auto write_buffer(
+    WGPUQueue                    queue,
+    WGPUBuffer                   buffer,
+    uint64                       buffer_offset,
+    std::span< std::byte const > bytes
+) -> utils::Result< void >;
+
+/// \brief Creates a buffer holding `bytes` using `mappedAtCreation`, so the data is copied
+///        once, from the caller's memory into memory the GPU reads from. The buffer is
+///        tracked under the category its usage implies.
+auto create_buffer_with_data(
+    GpuMemoryTracker&            memory_tracker,
+    WGPUDevice                   device,
+    std::span< std::byte const > bytes,
+    WGPUBufferUsage              usage,
+    std::string_view             label = ""
+) -> utils::Result< TrackedBuffer >;
+
+struct StreamToBufferSettings
+{
+    /// \brief Where in the buffer the first byte of the file goes. Must be a multiple of four.
+    uint64 buffer_offset = 0U;
+
+    /// \brief Bytes written before waiting for the GPU to catch up. Every write is staged
+    ///        until the GPU consumes it, so this bounds the staging memory the way
+    ///        `max_buffered_bytes` bounds the reader's.
+    uint64 max_in_flight_bytes = 64UZ << 20U;
+};
+
+/// \brief Uploads the rest of `reader`'s file into `buffer`, each chunk as soon as it has
+///        been read. The reader keeps reading ahead while earlier chunks upload, so disk
+///        reads and GPU transfers overlap. The chunk size must be a multiple of four, and
+///        the buffer must hold the file size rounded up to a multiple of four, since a
+///        trailing partial word is padded with zeros.
+/// \returns the number of bytes uploaded.
+auto stream_to_buffer(
+    WGPUInstance                  instance,
+    WGPUQueue                     queue,
+    WGPUBuffer                    buffer,
+    utils::ChunkedFileReader&     reader,
+    StreamToBufferSettings const& settings = { }
+) -> utils::Result< uint64 >;
+
+} // namespace ltb::wgpu
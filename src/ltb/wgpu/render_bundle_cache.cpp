@@ -0,0 +1,212 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/render_bundle_cache.hpp"
+
+// project
+#include "ltb/utils/timers.hpp"
+#include "ltb/wgpu/string_view.hpp"
+#include "ltb/wgpu/wgpu_metrics.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+
+namespace ltb::wgpu
+{
+
+RenderBundleCache::RenderBundleCache( RenderBundleCacheSettings settings )
+    : settings_( std::move( settings ) )
+{
+}
+
+RenderBundleCache::~RenderBundleCache( ) = default;
+
+auto RenderBundleCache::initialize( WGPUDevice const device ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( device );
+    LTB_CHECK_VALID( !settings_.color_formats.empty( ), "At least one color format is required" );
+
+    device_ = device;
+    return utils::success( );
+}
+
+auto RenderBundleCache::add_bundle( std::string label, RecordBundleCallback record )
+    -> RenderBundleId
+{
+    auto const id = next_id_++;
+    entries_.emplace(
+        id,
+        Entry{
+            .record = std::move( record ),
+            .stats  = { .label = std::move( label ) },
+        }
+    );
+    return id;
+}
+
+auto RenderBundleCache::remove_bundle( RenderBundleId const id ) -> void
+{
+    if ( auto iter = entries_.find( id ); iter != entries_.end( ) )
+    {
+        entries_.erase( iter );
+    }
+}
+
+auto RenderBundleCache::mark_dirty( RenderBundleId const id ) -> void
+{
+    if ( auto iter = entries_.find( id ); iter != entries_.end( ) )
+    {
+        iter->second.dirty = true;
+    }
+}
+
+auto RenderBundleCache::mark_all_dirty( ) -> void
+{
+    for ( auto& [ id, entry ] : entries_ )
+    {
+        entry.dirty = true;
+    }
+}
+
+auto RenderBundleCache::execute( WGPURenderPassEncoder const pass ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( device_, "RenderBundleCache not initialized" );
+
+    auto& metrics = wgpu_metrics( );
+
+    bundles_.clear( );
+    for ( auto& [ id, entry ] : entries_ )
+    {
+        entry.recorded_this_frame = entry.dirty;
+        if ( entry.dirty )
+        {
+            LTB_CHECK( record( entry ) );
+            metrics.render_bundle_misses.add( );
+        }
+        else
+        {
+            metrics.render_bundle_hits.add( );
+        }
+        bundles_.emplace_back( entry.bundle.get( ) );
+    }
+
+    if ( bundles_.empty( ) )
+    {
+        return utils::success( );
+    }
+
+    auto timer = utils::Timer{ };
+    ::wgpuRenderPassEncoderExecuteBundles( pass, bundles_.size( ), bundles_.data( ) );
+    auto const replay_duration = timer.duration_since_start( );
+
+    // Replaying is a single call so the cost is split evenly between bundles.
+    auto const replay_share
+        = replay_duration / static_cast< utils::Duration::rep >( bundles_.size( ) );
+
+    for ( auto& [ id, entry ] : entries_ )
+    {
+        // A bundle recorded this frame cost its encode time on top of the replay.
+        auto const net_saving = entry.recorded_this_frame
+                                  ? utils::Duration{ }
+                                  : entry.stats.encode_duration - replay_share;
+
+        // Small bundles can take longer to replay than to encode, which is a cost, not a saving.
+        entry.stats.replay_duration = replay_share;
+        entry.stats.saved_duration  = std::max( net_saving, utils::Duration{ } );
+        entry.stats.cost_duration   = std::max( -net_saving, utils::Duration{ } );
+        ++entry.stats.replay_count;
+    }
+
+    return utils::success( );
+}
+
+auto RenderBundleCache::stats( ) const -> std::vector< RenderBundleStats >
+{
+    auto result = std::vector< RenderBundleStats >{ };
+    result.reserve( entries_.size( ) );
+    for ( auto const& [ id, entry ] : entries_ )
+    {
+        result.emplace_back( entry.stats );
+    }
+    return result;
+}
+
+auto RenderBundleCache::log_stats( ) const -> void
+{
+    auto total_saved = utils::Duration{ };
+    auto total_cost  = utils::Duration{ };
+
+    spdlog::info( "Render bundles ({}):", entries_.size( ) );
+    for ( auto const& [ id, entry ] : entries_ )
+    {
+        auto const& stats = entry.stats;
+        spdlog::info(
+            " - {}: encode {}us, replay {}us, saved {}us/frame, cost {}us/frame (recorded {}x, "
+            "replayed {}x)",
+            stats.label,
+            utils::to_micros( stats.encode_duration ),
+            utils::to_micros( stats.replay_duration ),
+            utils::to_micros( stats.saved_duration ),
+            utils::to_micros( stats.cost_duration ),
+            stats.record_count,
+            stats.replay_count
+        );
+        total_saved += stats.saved_duration;
+        total_cost  += stats.cost_duration;
+    }
+    spdlog::info(
+        "Render bundles saved {}us/frame and cost {}us/frame",
+        utils::to_micros( total_saved ),
+        utils::to_micros( total_cost )
+    );
+}
+
+auto RenderBundleCache::record( Entry& entry ) -> utils::Result< void >
+{
+    auto const label = to_wgpu_string_view( entry.stats.label );
+
+    auto const encoder_descriptor = WGPURenderBundleEncoderDescriptor{
+        .nextInChain        = nullptr,
+        .label              = label,
+        .colorFormatCount   = settings_.color_formats.size( ),
+        .colorFormats       = settings_.color_formats.data( ),
+        .depthStencilFormat = settings_.depth_stencil_format,
+        .sampleCount        = settings_.sample_count,
+        .depthReadOnly      = false,
+        .stencilReadOnly    = false,
+    };
+
+    auto const encoder = RenderBundleEncoderHandle{
+        ::wgpuDeviceCreateRenderBundleEncoder( device_, &encoder_descriptor ),
+    };
+    LTB_CHECK_VALID( encoder );
+
+    // Only the draw commands are timed. They are what a pass would otherwise encode every
+    // frame, while creating and finishing the bundle encoder are costs of the bundle itself.
+    auto timer = utils::Timer{ };
+    if ( entry.record )
+    {
+        entry.record( encoder.get( ) );
+    }
+    entry.stats.encode_duration = timer.duration_since_start( );
+
+    auto const bundle_descriptor = WGPURenderBundleDescriptor{
+        .nextInChain = nullptr,
+        .label       = label,
+    };
+    auto bundle = RenderBundleHandle{
+        ::wgpuRenderBundleEncoderFinish( encoder.get( ), &bundle_descriptor ),
+    };
+    LTB_CHECK_VALID( bundle );
+
+    entry.bundle = std::move( bundle );
+    entry.dirty  = false;
+    ++entry.stats.record_count;
+
+    return utils::success( );
+}
+
+} // namespace ltb::wgpu
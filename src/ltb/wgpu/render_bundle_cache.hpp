@@ -0,0 +1,133 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/duration.hpp"
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+#include "ltb/wgpu/handle.hpp"
+
+// external
+#include <webgpu/webgpu.h>
+
+// standard
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ltb::wgpu
+{
+
+/// \brief Records the draw commands of a bundle. Called again whenever the bundle is dirty.
+using RecordBundleCallback = std::function< void( WGPURenderBundleEncoder ) >;
+
+using RenderBundleId = uint32;
+
+/// \brief The attachment formats of the render passes the bundles will be executed in.
+struct RenderBundleCacheSettings
+{
+    std::vector< WGPUTextureFormat > color_formats        = { };
+    WGPUTextureFormat                depth_stencil_format = WGPUTextureFormat_Undefined;
+    uint32                           sample_count         = 1U;
+};
+
+struct RenderBundleStats
+{
+    std::string label = "";
+
+    /// \brief How long the bundle's draw commands took to encode the last time it was dirty.
+    utils::Duration encode_duration = { };
+
+    /// \brief This bundle's share of the time spent replaying all bundles last frame.
+    utils::Duration replay_duration = { };
+
+    /// \brief The encode time saved last frame by replaying instead of re-encoding. Zero
+    ///        on frames where the bundle had to be recorded.
+    utils::Duration saved_duration = { };
+
+    /// \brief Replay time beyond the encode time it saved last frame. Only non-zero for
+    ///        bundles so small that re-encoding them would be cheaper.
+    utils::Duration cost_duration = { };
+
+    uint64 record_count = 0U;
+    uint64 replay_count = 0U;
+};
+
+/// \brief Records static draw lists into render bundles once and replays them every frame.
+///
+/// \code
+/// auto cache = RenderBundleCache{ { .color_formats = { surface_format } } };
+/// LTB_CHECK( cache.initialize( device ) );
+///
+/// auto const terrain = cache.add_bundle( "terrain", [ & ]( WGPURenderBundleEncoder encoder ) {
+///     // set pipeline, bind groups, buffers and draw...
+/// } );
+///
+/// // Each frame:
+/// cache.execute( render_pass ); // Only re-records bundles marked dirty.
+///
+/// // When the terrain changes:
+/// cache.mark_dirty( terrain );
+/// \endcode
+class RenderBundleCache
+{
+public:
+    explicit RenderBundleCache( RenderBundleCacheSettings settings );
+    ~RenderBundleCache( );
+
+    // No copy
+    RenderBundleCache( RenderBundleCache const& )                    = delete;
+    auto operator=( RenderBundleCache const& ) -> RenderBundleCache& = delete;
+
+    // Move only
+    RenderBundleCache( RenderBundleCache&& ) noexcept                    = default;
+    auto operator=( RenderBundleCache&& ) noexcept -> RenderBundleCache& = default;
+
+    auto initialize( WGPUDevice device ) -> utils::Result< void >;
+
+    /// \brief Adds a bundle that will be recorded the next time `execute` is called.
+    auto add_bundle( std::string label, RecordBundleCallback record ) -> RenderBundleId;
+
+    auto remove_bundle( RenderBundleId id ) -> void;
+
+    /// \brief The bundle will be re-recorded before it is next executed.
+    auto mark_dirty( RenderBundleId id ) -> void;
+
+    /// \brief Every bundle will be re-recorded before it is next executed.
+    auto mark_all_dirty( ) -> void;
+
+    /// \brief Re-records any dirty bundles then replays every bundle in one call.
+    auto execute( WGPURenderPassEncoder pass ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]] auto stats( ) const -> std::vector< RenderBundleStats >;
+
+    /// \brief Logs the per-bundle encode time saved by the last frame's replay.
+    auto log_stats( ) const -> void;
+
+private:
+    struct Entry
+    {
+        RecordBundleCallback record = nullptr;
+        RenderBundleHandle   bundle = nullptr;
+        bool                 dirty  = true;
+        RenderBundleStats    stats  = { };
+
+        bool recorded_this_frame = false;
+    };
+
+    RenderBundleCacheSettings settings_;
+
+    // The device is not owned and must outlive this object.
+    WGPUDevice device_ = nullptr;
+
+    RenderBundleId                    next_id_ = 0U;
+    std::map< RenderBundleId, Entry > entries_ = { };
+    std::vector< WGPURenderBundle >   bundles_ = { };
+
+    auto record( Entry& entry ) -> utils::Result< void >;
+};
+
+} // namespace ltb::wgpu
@@ -0,0 +1,27 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/string_view.hpp"
+
+namespace ltb::wgpu
+{
+
+auto to_string_view( WGPUStringView const view ) -> std::string_view
+{
+    if ( nullptr == view.data )
+    {
+        return { };
+    }
+    if ( WGPU_STRLEN == view.length )
+    {
+        return { view.data };
+    }
+    return { view.data, view.length };
+}
+
+auto to_wgpu_string_view( std::string_view const view ) -> WGPUStringView
+{
+    return { .data = view.data( ), .length = view.size( ) };
+}
+
+} // namespace ltb::wgpu
@@ -0,0 +1,22 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// external
+#include <webgpu/webgpu.h>
+
+// standard
+#include <string_view>
+
+namespace ltb::wgpu
+{
+
+/// \brief Converts a WebGPU string view, which may be null-terminated
+///        (WGPU_STRLEN) or sized, into a std::string_view.
+auto to_string_view( WGPUStringView view ) -> std::string_view;
+
+/// \brief Wraps a std::string_view so it can be passed to WebGPU descriptors.
+auto to_wgpu_string_view( std::string_view view ) -> WGPUStringView;
+
+} // namespace ltb::wgpu
@@ -0,0 +1,80 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/wgpu/wgpu_metrics.hpp"
+
+// standard
+#include <string>
+
+namespace ltb::wgpu
+{
+namespace
+{
+
+template < typename Enum >
+auto enum_counters( std::string const& name, std::string const& help, std::string const& label )
+    -> EnumCounters< Enum >
+{
+    auto counters = EnumCounters< Enum >{ };
+    for ( auto index = 0UZ; index < counters.size( ); ++index )
+    {
+        auto const value = magic_enum::enum_name( magic_enum::enum_value< Enum >( index ) );
+        counters[ index ]
+            = &utils::metrics( ).counter( name, help, { { label, std::string( value ) } } );
+    }
+    return counters;
+}
+
+} // namespace
+
+auto wgpu_metrics( ) -> WgpuMetrics&
+{
+    static auto instance = WgpuMetrics{
+        .queue_submits = utils::metrics( ).counter(
+            "ltb_wgpu_queue_submits_total",
+            "Command buffers submitted to the queue"
+        ),
+        .bytes_uploaded = utils::metrics( ).counter(
+            "ltb_wgpu_bytes_uploaded_total",
+            "Bytes written to GPU buffers with wgpuQueueWriteBuffer"
+        ),
+        .indirect_draws = utils::metrics( ).counter(
+            "ltb_wgpu_indirect_draws_total",
+            "Indirect draw calls encoded by the GPU-driven renderer"
+        ),
+        .render_bundle_hits = utils::metrics( ).counter(
+            "ltb_wgpu_render_bundle_cache_hits_total",
+            "Render bundles replayed without re-recording"
+        ),
+        .render_bundle_misses = utils::metrics( ).counter(
+            "ltb_wgpu_render_bundle_cache_misses_total",
+            "Render bundles that had to be re-recorded"
+        ),
+        .memory_bytes = utils::metrics( ).gauge(
+            "ltb_wgpu_memory_bytes",
+            "Bytes of GPU memory currently tracked"
+        ),
+        .memory_high_water_bytes = utils::metrics( ).gauge(
+            "ltb_wgpu_memory_high_water_bytes",
+            "Most bytes of GPU memory tracked at once"
+        ),
+        .submit_to_idle_seconds = utils::metrics( ).histogram(
+            "ltb_wgpu_submit_to_idle_seconds",
+            "Time from a blocking submit until the queue is idle",
+            utils::exponential_buckets( 0.0001, 2.0, 16U )
+        ),
+        .uncaptured_errors = enum_counters< WGPUErrorType >(
+            "ltb_wgpu_uncaptured_errors_total",
+            "Uncaptured WebGPU validation and device errors",
+            "type"
+        ),
+        .device_losses = enum_counters< WGPUDeviceLostReason >(
+            "ltb_wgpu_device_lost_total",
+            "WebGPU devices lost",
+            "reason"
+        ),
+    };
+    return instance;
+}
+
+} // namespace ltb::wgpu
@@ -0,0 +1,57 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Logan Barnes - All Rights Reserved
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/metrics.hpp"
+
+// external
+#include <magic_enum.hpp>
+#include <webgpu/webgpu.h>
+
+// standard
+#include <array>
+
+namespace ltb::wgpu
+{
+
+/// \brief One counter per enum value, indexed by `magic_enum::enum_index`.
+template < typename Enum >
+using EnumCounters = std::array< utils::Counter*, magic_enum::enum_count< Enum >( ) >;
+
+/// \brief The metrics the WebGPU helpers publish to `utils::metrics()`.
+struct WgpuMetrics
+{
+    utils::Counter& queue_submits;
+    utils::Counter& bytes_uploaded;
+    utils::Counter& indirect_draws;
+    utils::Counter& render_bundle_hits;
+    utils::Counter& render_bundle_misses;
+
+    /// \brief Mirrors the most recently updated GpuMemoryTracker.
+    utils::Gauge& memory_bytes;
+    utils::Gauge& memory_high_water_bytes;
+
+    utils::Histogram& submit_to_idle_seconds;
+
+    /// \brief Labelled by type and reason up front, so device callbacks don't build labels
+    ///        or look counters up by name on every event.
+    EnumCounters< WGPUErrorType >        uncaptured_errors;
+    EnumCounters< WGPUDeviceLostReason > device_losses;
+};
+
+/// \brief Registers the metrics on first use. The references can be cached by callers.
+auto wgpu_metrics( ) -> WgpuMetrics&;
+
+/// \brief Adds one to the counter for `value`. Values outside the enum are not counted.
+template < typename Enum >
+auto add_to( EnumCounters< Enum > const& counters, Enum const value ) -> void
+{
+    if ( auto const index = magic_enum::enum_index( value ) )
+    {
+        counters[ *index ]->add( );
+    }
+}
+
+} // namespace ltb::wgpu
@@ -4,10 +4,10 @@
 #include "ltb/window/glfw_os_window.hpp"
 
 // project
+#include "ltb/utils/logging.hpp"
 #include "ltb/window/glfw_utils.hpp"
 
 // external
-#include <spdlog/spdlog.h>
 #include <webgpu/webgpu_glfw.h>
 
 namespace ltb::window
@@ -64,7 +64,7 @@ auto GlfwOsWindow::should_close( ) const -> bool
 {
     if ( !is_initialized( ) )
     {
-        spdlog::warn( "Window not initialized, suggesting it should close." );
+        LTB_LOG_WARN( "Window not initialized, suggesting it should close." );
         return true;
     }
     return ::glfwWindowShouldClose( window_.get( ) );
@@ -74,7 +74,7 @@ auto GlfwOsWindow::resized( ) const -> std::optional< glm::ivec2 >
 {
     if ( !is_initialized( ) )
     {
-        spdlog::warn( "Window not initialized. No resized framebuffer available." );
+        LTB_LOG_WARN( "Window not initialized. No resized framebuffer available." );
         return std::nullopt;
     }
     return callback_data_->resized_framebuffer;